@@ -0,0 +1,158 @@
+#!/usr/bin/env python3
+
+"""
+Convert a compressed ULog file (.ulgz, written with SDLOG_COMPRESS enabled) into a regular ULog file.
+
+File layout (little endian):
+  file header:  magic 'ULogLZ4' (7), version (1), frame_size_max (4), timestamp (8)
+  frames:       sync 0xab 'ULZ' (4), method (1), reserved (3), raw_size (4), data_size (4),
+                raw_offset (8), raw_crc (4), followed by data_size bytes of payload
+Each frame is an independent LZ4 block (method 1) or stored data (method 0). Corrupted or
+truncated frames are skipped, and decoding continues at the next frame sync marker.
+"""
+
+import argparse
+import struct
+import sys
+import zlib
+
+try:
+    import lz4.block
+except ImportError:
+    lz4 = None
+
+FILE_HEADER = struct.Struct('<7sBIQ')
+FRAME_HEADER = struct.Struct('<4sB3xIIQI')
+FILE_MAGIC = b'ULogLZ4'
+FRAME_SYNC = b'\xabULZ'
+METHOD_STORED = 0
+METHOD_LZ4 = 1
+
+
+def lz4_decompress(data, raw_size):
+    """ decompress a single LZ4 block, returns None if malformed """
+    if lz4 is not None:
+        try:
+            return lz4.block.decompress(data, uncompressed_size=raw_size)
+        except lz4.block.LZ4BlockError:
+            return None
+
+    out = bytearray()
+    ip = 0
+    n = len(data)
+    try:
+        while ip < n:
+            token = data[ip]
+            ip += 1
+            literal_length = token >> 4
+            if literal_length == 15:
+                while True:
+                    b = data[ip]
+                    ip += 1
+                    literal_length += b
+                    if b != 255:
+                        break
+            if ip + literal_length > n:
+                return None
+            out += data[ip:ip + literal_length]
+            ip += literal_length
+            if ip == n:
+                break
+            offset = data[ip] | (data[ip + 1] << 8)
+            ip += 2
+            match_length = token & 0xf
+            if match_length == 15:
+                while True:
+                    b = data[ip]
+                    ip += 1
+                    match_length += b
+                    if b != 255:
+                        break
+            match_length += 4
+            if offset == 0 or offset > len(out):
+                return None
+            start = len(out) - offset
+            if offset >= match_length:
+                out += out[start:start + match_length]
+            else:
+                for i in range(match_length):
+                    out.append(out[start + i])
+    except IndexError:
+        return None
+
+    return bytes(out)
+
+
+def decompress(data, out):
+    """ decompress the file content in data, write the ULog stream to out. Returns the number of skipped frames """
+    magic, version, frame_size_max, _ = FILE_HEADER.unpack_from(data, 0)
+    if magic != FILE_MAGIC or version != 1:
+        raise ValueError('not a compressed ULog file')
+
+    skipped = 0
+    in_sync = True
+    raw_offset = 0
+    position = FILE_HEADER.size
+
+    while position + FRAME_HEADER.size <= len(data):
+        sync, method, raw_size, data_size, frame_offset, raw_crc = FRAME_HEADER.unpack_from(data, position)
+        payload_start = position + FRAME_HEADER.size
+        raw = None
+
+        if sync == FRAME_SYNC and raw_size <= frame_size_max and frame_offset >= raw_offset and \
+                payload_start + data_size <= len(data):
+            payload = data[payload_start:payload_start + data_size]
+            if method == METHOD_LZ4:
+                raw = lz4_decompress(payload, raw_size)
+            elif method == METHOD_STORED and data_size == raw_size:
+                raw = payload
+            if raw is not None and (len(raw) != raw_size or zlib.crc32(raw) != raw_crc):
+                raw = None
+
+        if raw is not None:
+            out.write(raw)
+            raw_offset = frame_offset + raw_size
+            in_sync = True
+            position = payload_start + data_size
+        else:
+            if in_sync:
+                skipped += 1
+                in_sync = False
+            position = data.find(FRAME_SYNC, position + 1)
+            if position < 0:
+                break
+
+    if position >= 0 and position < len(data) and in_sync:
+        # incomplete frame header at the end
+        skipped += 1
+
+    return skipped
+
+
+if __name__ == "__main__":
+
+    parser = argparse.ArgumentParser(description="""CLI tool to decompress a compressed ulog file\n""")
+    parser.add_argument("ulog_file", help=".ulgz file")
+    parser.add_argument("-o", "--output", help="output .ulg file (default: input file name without the trailing 'z')",
+                        default=None)
+
+    args = parser.parse_args()
+
+    output_file = args.output
+    if output_file is None:
+        output_file = args.ulog_file[:-1] if args.ulog_file.endswith('z') else args.ulog_file + '.ulg'
+
+    with open(args.ulog_file, 'rb') as f:
+        data = f.read()
+
+    try:
+        with open(output_file, 'wb') as out:
+            skipped = decompress(data, out)
+    except ValueError as e:
+        print(e)
+        sys.exit(1)
+
+    if skipped > 0:
+        print('Skipped {:} corrupted or incomplete frame(s)'.format(skipped))
+
+    print('Wrote {:}'.format(output_file))
@@ -0,0 +1,88 @@
+/****************************************************************************
+ *
+ *  Copyright (C) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file ThreadStatTest.cpp
+ * Tests for the /proc/<pid>/task/<tid>/stat parser.
+ */
+
+#include <gtest/gtest.h>
+#include <px4_platform_common/thread_stat.h>
+
+#include <string.h>
+
+#if defined(__PX4_LINUX)
+
+// fields 1 - 52, see proc(5): processor (39) is 5, rt_priority (40) is 98
+static const char stat_line[] =
+	"1234 (wq:rate ctrl (1)) R 1 1000 1000 0 -1 4194624 100 0 0 0 250 50 0 0 -99 0 30 0 12345 "
+	"1000000 500 18446744073709551615 1 1 0 0 0 0 0 0 0 0 0 0 17 5 98 1 0 0 0 0 0 0 0 0 0 0 0\n";
+
+TEST(ThreadStatTest, ParseStatLine)
+{
+	px4_thread_stat_s stat{};
+	ASSERT_TRUE(px4_parse_thread_stat(stat_line, &stat));
+
+	EXPECT_STREQ(stat.name, "wq:rate ctrl (1)");
+	EXPECT_EQ(stat.state, 'R');
+	EXPECT_EQ(stat.ticks, 300u);
+	EXPECT_EQ(stat.priority, -99);
+	EXPECT_EQ(stat.cpu, 5);
+}
+
+TEST(ThreadStatTest, LongName)
+{
+	px4_thread_stat_s stat{};
+	ASSERT_TRUE(px4_parse_thread_stat("1 (a very long thread name that does not fit) S 0 0 0 0 0 0 0 0 0 0 7 8 0 0 20 "
+					  "0 1 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 17 3 0", &stat));
+
+	EXPECT_EQ(strlen(stat.name), sizeof(stat.name) - 1);
+	EXPECT_EQ(strncmp(stat.name, "a very long thread name", 23), 0);
+	EXPECT_EQ(stat.ticks, 15u);
+	EXPECT_EQ(stat.priority, 20);
+	EXPECT_EQ(stat.cpu, 3);
+}
+
+TEST(ThreadStatTest, Truncated)
+{
+	px4_thread_stat_s stat{};
+	EXPECT_FALSE(px4_parse_thread_stat("", &stat));
+	EXPECT_FALSE(px4_parse_thread_stat("1234 (no closing bracket R 1", &stat));
+	EXPECT_FALSE(px4_parse_thread_stat("1234 (short) R 1 2 3", &stat));
+
+	// everything up to priority, but no processor field
+	ASSERT_TRUE(px4_parse_thread_stat("1 (x) S 0 0 0 0 0 0 0 0 0 0 1 2 0 0 20", &stat));
+	EXPECT_EQ(stat.cpu, -1);
+}
+
+#endif // __PX4_LINUX
@@ -49,6 +49,10 @@
 #define CONFIG_FS_PROCFS_MAX_TASKS 64
 #endif
 
+#if defined(__PX4_LINUX)
+#define PRINT_LOAD_MAX_CPUS 16
+#endif
+
 struct print_load_s {
 	uint64_t total_user_time{0};
 
@@ -59,6 +63,12 @@ struct print_load_s {
 	uint64_t interval_start_time{0};
 	uint64_t last_times[CONFIG_FS_PROCFS_MAX_TASKS] {};
 	float interval_time_us{0.f};
+
+#if defined(__PX4_LINUX)
+	int last_tids[CONFIG_FS_PROCFS_MAX_TASKS] {}; ///< thread ids of last_times
+	uint64_t last_cpu_busy[PRINT_LOAD_MAX_CPUS] {}; ///< per core busy time (clock ticks)
+	uint64_t last_cpu_total[PRINT_LOAD_MAX_CPUS] {}; ///< per core total time (clock ticks)
+#endif
 };
 
 __BEGIN_DECLS
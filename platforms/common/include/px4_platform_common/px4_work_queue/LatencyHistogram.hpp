@@ -0,0 +1,107 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <drivers/drv_hrt.h>
+
+#include <stdint.h>
+
+namespace px4
+{
+
+/**
+ * Histogram of the scheduling latency of a WorkItem, i.e. the time from being queued
+ * (ScheduleNow(), uORB callback or hrt timer) until Run() is called.
+ *
+ * Bucket 0 counts latencies below 16 us, bucket i latencies in [2^(i+3), 2^(i+4)) us,
+ * the last bucket everything above.
+ */
+struct LatencyHistogram {
+	static constexpr int NUM_BUCKETS = 12;
+
+	static constexpr int bucket_index(uint32_t latency_us)
+	{
+		if (latency_us < 16) {
+			return 0;
+		}
+
+		const int bucket = 32 - __builtin_clz(latency_us >> 4);
+		return (bucket < NUM_BUCKETS - 1) ? bucket : NUM_BUCKETS - 1;
+	}
+
+	/** lower bound of a bucket in microseconds */
+	static constexpr uint32_t bucket_lower_us(int bucket) { return (bucket == 0) ? 0 : (1u << (bucket + 3)); }
+
+	void update(hrt_abstime scheduled, hrt_abstime now)
+	{
+		if (scheduled != 0) {
+			const uint32_t latency_us = (now > scheduled) ? (now - scheduled) : 0;
+			buckets[bucket_index(latency_us)]++;
+			count++;
+			latency_sum_us += latency_us;
+
+			if (latency_us > latency_max_us) {
+				latency_max_us = latency_us;
+			}
+		}
+	}
+
+	float latency_mean_us() const { return (count > 0) ? (float)latency_sum_us / count : 0.f; }
+
+	/** upper bound (in us) of the bucket containing the given percentile (0-100) */
+	uint32_t percentile_upper_us(float percentile) const
+	{
+		const uint64_t threshold = (uint64_t)(count * percentile / 100.f);
+		uint64_t sum = 0;
+
+		for (int i = 0; i < NUM_BUCKETS - 1; i++) {
+			sum += buckets[i];
+
+			if (sum >= threshold) {
+				return bucket_lower_us(i + 1);
+			}
+		}
+
+		return latency_max_us;
+	}
+
+	uint32_t buckets[NUM_BUCKETS] {};
+	uint32_t count{0};
+	uint32_t latency_max_us{0};
+	uint64_t latency_sum_us{0};
+
+	hrt_abstime time_scheduled{0}; ///< time of the first (not yet executed) schedule, 0 if not queued
+};
+
+} // namespace px4
@@ -33,6 +33,7 @@
 
 #pragma once
 
+#include "LatencyHistogram.hpp"
 #include "WorkQueueManager.hpp"
 #include "WorkQueue.hpp"
 
@@ -72,6 +73,28 @@ public:
 
 	virtual void print_run_status();
 
+	/**
+	 * Start recording the scheduling latency (time from being queued until Run() is called).
+	 * The statistics are shown in work_queue status and published by load_mon.
+	 *
+	 * @return true if enabled
+	 */
+	bool EnableLatencyHistogram();
+
+	/**
+	 * Enable the latency histogram if requested by SYS_WQ_LATENCY.
+	 *
+	 * @return true if enabled
+	 */
+	bool EnableLatencyHistogramIfConfigured();
+
+	/**
+	 * Copy the current scheduling latency statistics.
+	 *
+	 * @return false if latency recording is not enabled
+	 */
+	bool latency_histogram(LatencyHistogram &histogram) const;
+
 	/**
 	 * Switch to a different WorkQueue.
 	 * NOTE: Caller is responsible for synchronization.
@@ -108,7 +131,7 @@ protected:
 		}
 	}
 
-	friend void WorkQueue::Run();
+	friend class WorkQueue;
 	virtual void Run() = 0;
 
 	/**
@@ -134,6 +157,8 @@ private:
 
 	WorkQueue	*_wq{nullptr};
 
+	LatencyHistogram *_latency_histogram{nullptr};
+
 };
 
 } // namespace px4
@@ -33,6 +33,7 @@
 
 #pragma once
 
+#include "LatencyHistogram.hpp"
 #include "WorkQueueManager.hpp"
 
 #include <containers/BlockingList.hpp>
@@ -73,6 +74,34 @@ public:
 
 	void print_status(bool last = false);
 
+	/**
+	 * Restrict the work queue thread to a set of CPU cores (Linux only).
+	 * @param cpu_affinity bitmask of CPU cores, 0 for any
+	 * @return PX4_OK on success
+	 */
+	int set_cpu_affinity(uint32_t cpu_affinity);
+	uint32_t get_cpu_affinity() const { return _cpu_affinity; }
+
+	/**
+	 * Install the latency histogram of a WorkItem attached to this queue (under the queue lock).
+	 * @return false if the item already has one, in which case histogram is not used
+	 */
+	bool set_latency_histogram(WorkItem &item, LatencyHistogram *histogram);
+
+	/**
+	 * Copy the latency histogram of a WorkItem attached to this queue (under the queue lock).
+	 * @return false if latency recording is not enabled for the item
+	 */
+	bool latency_histogram(const WorkItem &item, LatencyHistogram &histogram);
+
+	/**
+	 * Get the latency histogram of a WorkItem with latency recording enabled.
+	 * @param index index of the WorkItem (only counting the ones with latency recording),
+	 *              decremented by the number of such WorkItems in this queue if not found
+	 * @return true if found
+	 */
+	bool latency_histogram(unsigned &index, char *name, size_t name_len, LatencyHistogram &histogram);
+
 	// WorkQueues sorted numerically by relative priority (-1 to -255)
 	bool operator<=(const WorkQueue &rhs) const { return _config.relative_priority >= rhs.get_config().relative_priority; }
 
@@ -101,6 +130,13 @@ private:
 	BlockingList<WorkItem *>	_work_items;
 	px4::atomic_bool		_should_exit{false};
 
+	uint32_t			_cpu_affinity{0};
+
+#if defined(__PX4_LINUX)
+	pthread_t			_thread {};
+	int				_tid{-1};
+#endif // __PX4_LINUX
+
 #if defined(ENABLE_LOCKSTEP_SCHEDULER)
 	int _lockstep_component {-1};
 #endif // ENABLE_LOCKSTEP_SCHEDULER
@@ -33,17 +33,20 @@
 
 #pragma once
 
+#include <stddef.h>
 #include <stdint.h>
 
 namespace px4
 {
 
 class WorkQueue; // forward declaration
+struct LatencyHistogram; // forward declaration
 
 struct wq_config_t {
 	const char *name;
 	uint16_t stacksize;
 	int8_t relative_priority; // relative to max
+	uint32_t cpu_affinity{0}; // bitmask of CPU cores the thread may run on (Linux only), 0: any
 };
 
 namespace wq_configurations
@@ -109,6 +112,27 @@ int WorkQueueManagerStop();
  */
 int WorkQueueManagerStatus();
 
+/**
+ * Set the CPU affinity of a work queue (Linux only).
+ * Applies immediately if the work queue is running, and otherwise when it gets created.
+ *
+ * @param name		The work queue name (eg wq:rate_ctrl).
+ * @param cpu_affinity	Bitmask of CPU cores the work queue thread may run on, 0 to remove the restriction.
+ * @return		PX4_OK on success, PX4_ERROR for an unknown work queue name or on failure.
+ */
+int WorkQueueSetCpuAffinity(const char *name, uint32_t cpu_affinity);
+
+/**
+ * Get the scheduling latency histogram of a WorkItem (see WorkItem::EnableLatencyHistogram()).
+ *
+ * @param index		Index over all WorkItems with latency recording enabled.
+ * @param name		Buffer for the WorkItem name.
+ * @param name_len	Size of the name buffer.
+ * @param histogram	The latency histogram.
+ * @return		true if found, false if index is out of range.
+ */
+bool WorkItemLatencyHistogram(unsigned index, char *name, size_t name_len, LatencyHistogram &histogram);
+
 /**
  * Create (or find) a work queue with a particular configuration.
  *
@@ -0,0 +1,79 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file thread_stat.h
+ *
+ * Per thread scheduling state of this process on Linux (/proc/self/task/<tid>).
+ */
+
+#pragma once
+
+#include <px4_platform_common/px4_config.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__PX4_LINUX)
+
+struct px4_thread_stat_s {
+	char name[32];
+	char state;
+	uint64_t ticks; ///< user + system time in clock ticks
+	int priority;
+	int cpu; ///< core the thread last ran on
+};
+
+__BEGIN_DECLS
+
+/**
+ * Parse the content of a /proc/<pid>/task/<tid>/stat file, see proc(5).
+ * @return true on success
+ */
+__EXPORT bool px4_parse_thread_stat(const char *buf, struct px4_thread_stat_s *stat);
+
+/**
+ * Read the state of a thread of this process from /proc/self/task/<tid>/stat, see proc(5).
+ * @return true on success
+ */
+__EXPORT bool px4_read_thread_stat(int tid, struct px4_thread_stat_s *stat);
+
+/**
+ * Number of CPU migrations of a thread, only available if the kernel has CONFIG_SCHED_DEBUG.
+ * @return number of migrations or -1 if unknown
+ */
+__EXPORT long long px4_read_thread_migrations(int tid);
+
+__END_DECLS
+
+#endif // __PX4_LINUX
@@ -38,6 +38,7 @@
 
 #include <px4_platform_common/log.h>
 #include <drivers/drv_hrt.h>
+#include <parameters/param.h>
 
 namespace px4
 {
@@ -63,6 +64,9 @@ WorkItem::WorkItem(const char *name, const WorkItem &work_item) :
 WorkItem::~WorkItem()
 {
 	Deinit();
+
+	delete _latency_histogram;
+	_latency_histogram = nullptr;
 }
 
 bool WorkItem::Init(const wq_config_t &config)
@@ -132,6 +136,48 @@ float WorkItem::average_interval() const
 	return 0.f;
 }
 
+bool WorkItem::EnableLatencyHistogram()
+{
+	if (_wq == nullptr) {
+		return false;
+	}
+
+	// allocate outside of the queue lock, it is a critical section on NuttX
+	LatencyHistogram *histogram = new LatencyHistogram();
+
+	if (histogram == nullptr) {
+		return false;
+	}
+
+	if (!_wq->set_latency_histogram(*this, histogram)) {
+		// already enabled
+		delete histogram;
+	}
+
+	return true;
+}
+
+bool WorkItem::EnableLatencyHistogramIfConfigured()
+{
+	int32_t enabled = 0;
+	const param_t param = param_find("SYS_WQ_LATENCY");
+
+	if ((param != PARAM_INVALID) && (param_get(param, &enabled) == PX4_OK) && (enabled != 0)) {
+		return EnableLatencyHistogram();
+	}
+
+	return false;
+}
+
+bool WorkItem::latency_histogram(LatencyHistogram &histogram) const
+{
+	if (_wq != nullptr) {
+		return _wq->latency_histogram(*this, histogram);
+	}
+
+	return false;
+}
+
 void WorkItem::print_run_status()
 {
 	PX4_INFO_RAW("%-29s %8.1f Hz %12.0f us\n", _item_name, (double)average_rate(), (double)average_interval());
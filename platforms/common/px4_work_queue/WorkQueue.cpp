@@ -36,6 +36,14 @@
 
 #include <string.h>
 
+#if defined(__PX4_LINUX)
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <px4_platform_common/thread_stat.h>
+#endif // __PX4_LINUX
+
 #include <px4_platform_common/tasks.h>
 #include <px4_platform_common/time.h>
 #include <drivers/drv_hrt.h>
@@ -53,6 +61,15 @@ WorkQueue::WorkQueue(const wq_config_t &config) :
 	pthread_setname_np(pthread_self(), _config.name);
 #endif
 
+#if defined(__PX4_LINUX)
+	_thread = pthread_self();
+	_tid = syscall(SYS_gettid);
+#endif // __PX4_LINUX
+
+	if (_config.cpu_affinity != 0) {
+		set_cpu_affinity(_config.cpu_affinity);
+	}
+
 #ifndef __PX4_NUTTX
 	px4_sem_init(&_qlock, 0, 1);
 #endif /* __PX4_NUTTX */
@@ -137,6 +154,11 @@ void WorkQueue::Add(WorkItem *item)
 
 #endif // ENABLE_LOCKSTEP_SCHEDULER
 
+	// latency is measured from the first schedule until the item runs
+	if ((item->_latency_histogram != nullptr) && (item->_latency_histogram->time_scheduled == 0)) {
+		item->_latency_histogram->time_scheduled = hrt_absolute_time();
+	}
+
 	_q.push(item);
 	work_unlock();
 
@@ -182,6 +204,11 @@ void WorkQueue::Run()
 		while (!_q.empty()) {
 			WorkItem *work = _q.pop();
 
+			if (work->_latency_histogram != nullptr) {
+				work->_latency_histogram->update(work->_latency_histogram->time_scheduled, hrt_absolute_time());
+				work->_latency_histogram->time_scheduled = 0;
+			}
+
 			work_unlock(); // unlock work queue to run (item may requeue itself)
 			work->RunPreamble();
 			work->Run();
@@ -204,10 +231,49 @@ void WorkQueue::Run()
 	PX4_DEBUG("%s: exiting", _config.name);
 }
 
+int WorkQueue::set_cpu_affinity(uint32_t cpu_affinity)
+{
+#if defined(__PX4_LINUX)
+	cpu_set_t cpuset;
+	CPU_ZERO(&cpuset);
+
+	for (unsigned cpu = 0; cpu < 32; cpu++) {
+		if ((cpu_affinity == 0) || (cpu_affinity & (1u << cpu))) {
+			CPU_SET(cpu, &cpuset);
+		}
+	}
+
+	int ret = pthread_setaffinity_np(_thread, sizeof(cpuset), &cpuset);
+
+	if (ret != 0) {
+		PX4_ERR("%s: setting CPU affinity 0x%" PRIx32 " failed (%i)", get_name(), cpu_affinity, ret);
+		return PX4_ERROR;
+	}
+
+	_cpu_affinity = cpu_affinity;
+	return PX4_OK;
+#else
+	PX4_ERR("CPU affinity not supported");
+	return PX4_ERROR;
+#endif // __PX4_LINUX
+}
+
 void WorkQueue::print_status(bool last)
 {
 	const size_t num_items = _work_items.size();
+
+#if defined(__PX4_LINUX)
+	px4_thread_stat_s stat{};
+
+	if (!px4_read_thread_stat(_tid, &stat)) {
+		stat.cpu = -1;
+	}
+
+	PX4_INFO_RAW("%-24s CPU: %2d  affinity: 0x%02" PRIx32 "  migrations: %lld\n", get_name(), stat.cpu, _cpu_affinity,
+		     px4_read_thread_migrations(_tid));
+#else
 	PX4_INFO_RAW("%-16s\n", get_name());
+#endif // __PX4_LINUX
 	unsigned i = 0;
 
 	for (WorkItem *item : _work_items) {
@@ -228,7 +294,74 @@ void WorkQueue::print_status(bool last)
 		}
 
 		item->print_run_status();
+
+		LatencyHistogram histogram;
+
+		if (latency_histogram(*item, histogram)) {
+			PX4_INFO_RAW("%s%s       latency: %" PRIu32 " runs, mean %.1f us, p99 < %" PRIu32 " us, max %" PRIu32 " us\n",
+				     last ? "    " : "|   ", (i < num_items) ? "|" : " ",
+				     histogram.count, (double)histogram.latency_mean_us(), histogram.percentile_upper_us(99.f),
+				     histogram.latency_max_us);
+		}
 	}
 }
 
+bool WorkQueue::set_latency_histogram(WorkItem &item, LatencyHistogram *histogram)
+{
+	bool ret = false;
+
+	work_lock();
+
+	if (item._latency_histogram == nullptr) {
+		item._latency_histogram = histogram;
+		ret = true;
+	}
+
+	work_unlock();
+
+	return ret;
+}
+
+bool WorkQueue::latency_histogram(const WorkItem &item, LatencyHistogram &histogram)
+{
+	bool ret = false;
+
+	work_lock();
+
+	if (item._latency_histogram != nullptr) {
+		histogram = *item._latency_histogram;
+		ret = true;
+	}
+
+	work_unlock();
+
+	return ret;
+}
+
+bool WorkQueue::latency_histogram(unsigned &index, char *name, size_t name_len, LatencyHistogram &histogram)
+{
+	bool ret = false;
+
+	// the queue lock also protects _work_items (see Attach() and Detach()), don't take the list mutex in addition
+	work_lock();
+
+	for (WorkItem *item : _work_items) {
+		if (item->_latency_histogram != nullptr) {
+			if (index == 0) {
+				histogram = *item->_latency_histogram;
+				strncpy(name, item->ItemName(), name_len - 1);
+				name[name_len - 1] = '\0';
+				ret = true;
+				break;
+			}
+
+			index--;
+		}
+	}
+
+	work_unlock();
+
+	return ret;
+}
+
 } // namespace px4
@@ -61,6 +61,48 @@ static BlockingQueue<const wq_config_t *, 1> *_wq_manager_create_queue{nullptr};
 
 static px4::atomic_bool _wq_manager_should_exit{true};
 
+// CPU affinity set at runtime, applied to work queues created later
+struct wq_cpu_affinity_t {
+	char name[32];
+	uint32_t cpu_affinity;
+};
+
+static constexpr int WQ_CPU_AFFINITY_MAX = 16;
+static wq_cpu_affinity_t _wq_cpu_affinity[WQ_CPU_AFFINITY_MAX] {};
+static pthread_mutex_t _wq_cpu_affinity_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+#if defined(__PX4_LINUX)
+// all work queues that can be created (see wq_configurations)
+static constexpr const wq_config_t *_wq_configs[] {
+	&wq_configurations::rate_ctrl,
+	&wq_configurations::SPI0, &wq_configurations::SPI1, &wq_configurations::SPI2, &wq_configurations::SPI3,
+	&wq_configurations::SPI4, &wq_configurations::SPI5, &wq_configurations::SPI6,
+	&wq_configurations::I2C0, &wq_configurations::I2C1, &wq_configurations::I2C2, &wq_configurations::I2C3,
+	&wq_configurations::I2C4,
+	&wq_configurations::nav_and_controllers,
+	&wq_configurations::INS0, &wq_configurations::INS1, &wq_configurations::INS2, &wq_configurations::INS3,
+	&wq_configurations::hp_default,
+	&wq_configurations::uavcan,
+	&wq_configurations::UART0, &wq_configurations::UART1, &wq_configurations::UART2, &wq_configurations::UART3,
+	&wq_configurations::UART4, &wq_configurations::UART5, &wq_configurations::UART6, &wq_configurations::UART7,
+	&wq_configurations::UART8, &wq_configurations::UART_UNKNOWN,
+	&wq_configurations::lp_default,
+	&wq_configurations::test1, &wq_configurations::test2,
+};
+
+static bool
+WorkQueueConfigExists(const char *name)
+{
+	for (const wq_config_t *config : _wq_configs) {
+		if (strcmp(config->name, name) == 0) {
+			return true;
+		}
+	}
+
+	return false;
+}
+#endif // __PX4_LINUX
+
 
 static WorkQueue *
 FindWorkQueueByName(const char *name)
@@ -118,6 +160,74 @@ WorkQueueFindOrCreate(const wq_config_t &new_wq)
 	return wq;
 }
 
+int
+WorkQueueSetCpuAffinity(const char *name, uint32_t cpu_affinity)
+{
+#if defined(__PX4_LINUX)
+
+	if (name == nullptr || !WorkQueueConfigExists(name)) {
+		PX4_ERR("unknown work queue %s", name ? name : "");
+		return PX4_ERROR;
+	}
+
+	// remember for (re)creation
+	pthread_mutex_lock(&_wq_cpu_affinity_mutex);
+	int ret = PX4_ERROR;
+
+	for (auto &entry : _wq_cpu_affinity) {
+		if ((entry.name[0] == '\0') || (strcmp(entry.name, name) == 0)) {
+			strncpy(entry.name, name, sizeof(entry.name) - 1);
+			entry.cpu_affinity = cpu_affinity;
+			ret = PX4_OK;
+			break;
+		}
+	}
+
+	pthread_mutex_unlock(&_wq_cpu_affinity_mutex);
+
+	if (ret != PX4_OK) {
+		PX4_ERR("too many CPU affinity settings");
+		return ret;
+	}
+
+	// apply if running
+	if (_wq_manager_wqs_list != nullptr) {
+		LockGuard lg{_wq_manager_wqs_list->mutex()};
+
+		for (WorkQueue *wq : *_wq_manager_wqs_list) {
+			if (strcmp(wq->get_name(), name) == 0) {
+				return wq->set_cpu_affinity(cpu_affinity);
+			}
+		}
+	}
+
+	return PX4_OK;
+#else
+	PX4_ERR("CPU affinity not supported");
+	return PX4_ERROR;
+#endif // __PX4_LINUX
+}
+
+static bool
+WorkQueueGetCpuAffinity(const char *name, uint32_t &cpu_affinity)
+{
+	bool found = false;
+
+	pthread_mutex_lock(&_wq_cpu_affinity_mutex);
+
+	for (auto &entry : _wq_cpu_affinity) {
+		if (strcmp(entry.name, name) == 0) {
+			cpu_affinity = entry.cpu_affinity;
+			found = true;
+			break;
+		}
+	}
+
+	pthread_mutex_unlock(&_wq_cpu_affinity_mutex);
+
+	return found;
+}
+
 const wq_config_t &
 device_bus_to_wq(uint32_t device_id_int)
 {
@@ -224,6 +334,13 @@ WorkQueueRunner(void *context)
 	wq_config_t *config = static_cast<wq_config_t *>(context);
 	WorkQueue wq(*config);
 
+	// runtime CPU affinity overrides the configuration
+	uint32_t cpu_affinity = 0;
+
+	if (WorkQueueGetCpuAffinity(config->name, cpu_affinity)) {
+		wq.set_cpu_affinity(cpu_affinity);
+	}
+
 	// add to work queue list
 	_wq_manager_wqs_list->add(&wq);
 
@@ -475,4 +592,20 @@ WorkQueueManagerStatus()
 	return PX4_OK;
 }
 
+bool
+WorkItemLatencyHistogram(unsigned index, char *name, size_t name_len, LatencyHistogram &histogram)
+{
+	if (!_wq_manager_should_exit.load() && (_wq_manager_wqs_list != nullptr)) {
+		LockGuard lg{_wq_manager_wqs_list->mutex()};
+
+		for (WorkQueue *wq : *_wq_manager_wqs_list) {
+			if (wq->latency_histogram(index, name, name_len, histogram)) {
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
 } // namespace px4
@@ -65,6 +65,8 @@ int WQueueTest::main()
 
 	_iter = 0;
 
+	EnableLatencyHistogram();
+
 	// Put work in the work queue
 	ScheduleNow();
 
@@ -75,6 +77,16 @@ int WQueueTest::main()
 
 	PX4_INFO("WQueueTest finished");
 
+	LatencyHistogram histogram;
+
+	if (latency_histogram(histogram)) {
+		PX4_INFO("latency: %" PRIu32 " runs, mean %.1f us, max %" PRIu32 " us", histogram.count,
+			 (double)histogram.latency_mean_us(), histogram.latency_max_us);
+
+	} else {
+		PX4_ERR("latency histogram not available");
+	}
+
 	//print_status();
 
 	px4_sleep(2);
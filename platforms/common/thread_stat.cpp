@@ -0,0 +1,138 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file thread_stat.cpp
+ * Implementation of the API declared in thread_stat.h.
+ */
+
+#include <px4_platform_common/thread_stat.h>
+
+#if defined(__PX4_LINUX)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+bool px4_parse_thread_stat(const char *buf, struct px4_thread_stat_s *stat)
+{
+	// the command is in brackets and may contain spaces
+	const char *name_start = strchr(buf, '(');
+	const char *name_end = strrchr(buf, ')');
+
+	if (name_start == nullptr || name_end == nullptr || name_end < name_start || name_end[1] != ' ') {
+		return false;
+	}
+
+	size_t name_len = name_end - (name_start + 1);
+
+	if (name_len > sizeof(stat->name) - 1) {
+		name_len = sizeof(stat->name) - 1;
+	}
+
+	memcpy(stat->name, name_start + 1, name_len);
+	stat->name[name_len] = '\0';
+
+	// fields from 3 (state) onwards
+	unsigned long utime = 0;
+	unsigned long stime = 0;
+	long prio = 0;
+
+	if (sscanf(name_end + 2, "%c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %lu %lu %*d %*d %ld", &stat->state, &utime,
+		   &stime, &prio) != 4) {
+		return false;
+	}
+
+	stat->ticks = utime + stime;
+	stat->priority = prio;
+
+	// field 39 (processor), p starts at the space in front of field 3
+	const char *p = name_end + 1;
+
+	for (int field = 3; p != nullptr && field < 39; field++) {
+		p = strchr(p + 1, ' ');
+	}
+
+	stat->cpu = (p != nullptr) ? atoi(p + 1) : -1;
+
+	return true;
+}
+
+bool px4_read_thread_stat(int tid, struct px4_thread_stat_s *stat)
+{
+	char path[64];
+	snprintf(path, sizeof(path), "/proc/self/task/%d/stat", tid);
+	FILE *f = fopen(path, "r");
+
+	if (f == nullptr) {
+		return false;
+	}
+
+	char buf[512];
+	size_t len = fread(buf, 1, sizeof(buf) - 1, f);
+	buf[len] = '\0';
+	fclose(f);
+
+	return px4_parse_thread_stat(buf, stat);
+}
+
+long long px4_read_thread_migrations(int tid)
+{
+	char path[64];
+	snprintf(path, sizeof(path), "/proc/self/task/%d/sched", tid);
+	FILE *f = fopen(path, "r");
+
+	if (f == nullptr) {
+		return -1;
+	}
+
+	long long migrations = -1;
+	char line[128];
+
+	while (fgets(line, sizeof(line), f)) {
+		if (strncmp(line, "se.nr_migrations", 16) == 0) {
+			const char *colon = strchr(line, ':');
+
+			if (colon) {
+				migrations = atoll(colon + 1);
+			}
+
+			break;
+		}
+	}
+
+	fclose(f);
+	return migrations;
+}
+
+#endif // __PX4_LINUX
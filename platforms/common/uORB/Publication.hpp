@@ -78,6 +78,8 @@ public:
 
 protected:
 
+	template<typename T> friend class PublicationLoan;
+
 	PublicationBase(ORB_ID id) : _orb_id(id) {}
 
 	~PublicationBase()
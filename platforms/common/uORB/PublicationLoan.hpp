@@ -0,0 +1,134 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2021 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file PublicationLoan.hpp
+ *
+ */
+
+#pragma once
+
+#include <px4_platform_common/defines.h>
+
+#include <uORB/uORB.h>
+#include "uORBManager.hpp"
+#include "Publication.hpp"
+
+namespace uORB
+{
+
+/**
+ * Scoped loan of the next queue slot of a publication, so that large messages can be
+ * written in place instead of being built on the stack and copied on publish.
+ *
+ * The topic is locked for the lifetime of the loan, so fill it and publish right away.
+ * The slot still contains an older message and all fields need to be written.
+ * Loans are only available with UORB_PUBLICATION_LOAN (POSIX), otherwise get() returns
+ * nullptr and the message has to be published as a copy. A loan that goes out of scope is published.
+ *
+ * Usage:
+ *   uORB::PublicationLoan<sensor_gyro_fifo_s> loan{_sensor_fifo_pub};
+ *
+ *   if (sensor_gyro_fifo_s *fifo = loan.get()) {
+ *     fifo->timestamp = ...;
+ *     loan.publish();
+ *
+ *   } else {
+ *     ... _sensor_fifo_pub.publish(copy) ...
+ *   }
+ */
+template<typename T>
+class PublicationLoan
+{
+public:
+
+	/**
+	 * Constructor
+	 *
+	 * @param publication The Publication or PublicationMulti of the topic.
+	 */
+	template<typename P>
+	explicit PublicationLoan(P &publication) :
+		_publication(publication)
+	{
+		if (publication.advertise()) {
+			_loan = static_cast<T *>(Manager::orb_loan(_publication._handle));
+		}
+	}
+
+	~PublicationLoan()
+	{
+		publish();
+	}
+
+	// no copy, assignment, move, move assignment
+	PublicationLoan(const PublicationLoan &) = delete;
+	PublicationLoan &operator=(const PublicationLoan &) = delete;
+	PublicationLoan(PublicationLoan &&) = delete;
+	PublicationLoan &operator=(PublicationLoan &&) = delete;
+
+	/**
+	 * @return true if the message is written in place
+	 */
+	bool loaned() const { return _loan != nullptr; }
+
+	/**
+	 * @return the loaned message, nullptr if not loaned
+	 */
+	T *get() { return _published ? nullptr : _loan; }
+
+	/**
+	 * Publish the loaned message and release the topic.
+	 * @return true on success, false on failure, if not loaned or if already published
+	 */
+	bool publish()
+	{
+		if ((_loan == nullptr) || _published) {
+			return false;
+		}
+
+		_published = true;
+
+		return (Manager::orb_publish_loan(_publication.get_topic(), _publication._handle) == PX4_OK);
+	}
+
+private:
+
+	PublicationBase &_publication;
+
+	T *_loan{nullptr};
+
+	bool _published{false};
+};
+
+} // namespace uORB
@@ -138,6 +138,12 @@ public:
 	 */
 	bool updated() { return advertised() && Manager::updates_available(_node, _last_generation); }
 
+	/**
+	 * Check if there is a new update, without trying to subscribe first.
+	 * Only reads the generation of the node, so it is never true if not subscribed yet.
+	 */
+	bool updated_subscribed() const { return valid() && Manager::updates_available(_node, _last_generation); }
+
 	/**
 	 * Update the struct
 	 * @param dst The uORB message struct we are updating.
@@ -164,6 +170,7 @@ protected:
 
 	friend class SubscriptionCallback;
 	friend class SubscriptionCallbackWorkItem;
+	template<typename T> friend class SubscriptionView;
 
 	void *get_node() { return _node; }
 
@@ -47,6 +47,7 @@
 
 #include "Subscription.hpp"
 
+#include <containers/Bitset.hpp>
 #include <mathlib/mathlib.h>
 
 namespace uORB
@@ -102,6 +103,16 @@ public:
 		return false;
 	}
 
+	/**
+	 * Check if there is a new update at the given time. Only compares the generation of the
+	 * topic node, and is only true if already subscribed (see updated_set()).
+	 * @param now The current time.
+	 */
+	bool updated(hrt_abstime now) const
+	{
+		return ((now - _last_update) >= _interval_us) && _subscription.updated_subscribed();
+	}
+
 	/**
 	 * Copy the struct if updated.
 	 * @param dst The destination pointer where the struct will be copied.
@@ -159,10 +170,38 @@ public:
 	void		set_last_update(hrt_abstime t) { _last_update = t; }
 protected:
 
+	template<typename T> friend class SubscriptionView;
+
 	Subscription	_subscription;
 	uint64_t	_last_update{0};	// last update in microseconds
 	uint32_t	_interval_us{0};	// maximum update interval in microseconds
 
 };
 
+/**
+ * Get the set of updated subscriptions of an array in a single pass.
+ * This only reads the generation of each topic node and the time once, so it is
+ * cheaper than calling updated() on each subscription if most of them did not update.
+ * Subscriptions that are not subscribed yet are never reported as updated.
+ *
+ * @param subscriptions Array of subscriptions (SubscriptionInterval or derived).
+ * @param count Number of subscriptions.
+ * @param updated Bit i is set if subscriptions[i] has a new update and its interval elapsed.
+ * @return The number of updated subscriptions.
+ */
+template<typename T, size_t N>
+unsigned updated_set(const T *subscriptions, unsigned count, px4::Bitset<N> &updated)
+{
+	const hrt_abstime now = hrt_absolute_time();
+	unsigned num_updated = 0;
+
+	for (unsigned i = 0; (i < count) && (i < N); i++) {
+		const bool sub_updated = subscriptions[i].updated(now);
+		updated.set(i, sub_updated);
+		num_updated += sub_updated;
+	}
+
+	return num_updated;
+}
+
 } // namespace uORB
@@ -0,0 +1,142 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2021 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file SubscriptionView.hpp
+ *
+ */
+
+#pragma once
+
+#include <px4_platform_common/defines.h>
+
+#include <uORB/uORB.h>
+#include "uORBManager.hpp"
+#include "Subscription.hpp"
+#include "SubscriptionInterval.hpp"
+
+namespace uORB
+{
+
+/**
+ * Read the next message of a subscription in place (in the topic queue) instead of copying it.
+ *
+ * The publisher is not blocked while reading, so the message can be overwritten if the
+ * subscriber falls behind by the full queue length. end() detects this, in which case the
+ * message has to be discarded. Only consume the message (update filters, publish, etc.)
+ * after end() returned true. If the message cannot be read in place (a queue size of 1
+ * on NuttX, or a publisher is active) begin() returns nullptr and the remaining updates
+ * have to be copied from the subscription as usual.
+ *
+ * Usage:
+ *   uORB::SubscriptionView<sensor_gyro_fifo_s> view{_sensor_fifo_sub};
+ *   while (const sensor_gyro_fifo_s *fifo = view.begin()) {
+ *     ... read *fifo ...
+ *     if (view.end()) { ... consume ... }
+ *   }
+ *
+ *   while (_sensor_fifo_sub.update(&copy)) { ... }
+ */
+template<typename T>
+class SubscriptionView
+{
+public:
+
+	/**
+	 * Constructor
+	 *
+	 * @param subscription The subscription to read from (and advance).
+	 */
+	explicit SubscriptionView(Subscription &subscription) : _subscription(subscription) {}
+
+	/**
+	 * Constructor
+	 *
+	 * @param subscription The subscription to read from (and advance). The interval is not applied.
+	 */
+	explicit SubscriptionView(SubscriptionInterval &subscription) : _subscription(subscription._subscription) {}
+
+	~SubscriptionView() = default;
+
+	// no copy, assignment, move, move assignment
+	SubscriptionView(const SubscriptionView &) = delete;
+	SubscriptionView &operator=(const SubscriptionView &) = delete;
+	SubscriptionView(SubscriptionView &&) = delete;
+	SubscriptionView &operator=(SubscriptionView &&) = delete;
+
+	/**
+	 * Begin reading the next unread message.
+	 * @return pointer to the message, nullptr if there is no update or it cannot be read in place
+	 */
+	const T *begin()
+	{
+		_view = nullptr;
+
+		if (!_subscription.updated()) {
+			return nullptr;
+		}
+
+		_generation = _subscription._last_generation;
+		_view = static_cast<const T *>(Manager::orb_data_view_begin(_subscription._node, _generation, _seq));
+
+		return _view;
+	}
+
+	/**
+	 * Finish reading the message returned by begin() and advance the subscription.
+	 * @return true if the message is intact, false if it was overwritten while reading and must be discarded
+	 */
+	bool end()
+	{
+		if (_view == nullptr) {
+			return false;
+		}
+
+		_view = nullptr;
+
+		// advance in any case, a message overwritten in place was lost anyway
+		_subscription._last_generation = _generation;
+
+		return Manager::orb_data_view_end(_subscription._node, _generation, _seq);
+	}
+
+private:
+
+	Subscription &_subscription;
+
+	const T *_view{nullptr};
+	unsigned _generation{0};
+	unsigned _seq{0};
+};
+
+} // namespace uORB
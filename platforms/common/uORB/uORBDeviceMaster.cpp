@@ -154,6 +154,9 @@ int uORB::DeviceMaster::advertise(const struct orb_metadata *meta, bool is_adver
 
 			// add to the node map.
 			_node_list.add(node);
+#if defined(UORB_DEVICE_MASTER_NODE_TABLE)
+			_node_table[node->get_instance()][(uint8_t)node->id()] = node;
+#endif // UORB_DEVICE_MASTER_NODE_TABLE
 			_node_exists[node->get_instance()].set((uint8_t)node->id(), true);
 		}
 
@@ -437,27 +440,79 @@ void uORB::DeviceMaster::showTop(char **topic_filter, int num_filters)
 
 uORB::DeviceNode *uORB::DeviceMaster::getDeviceNode(const char *nodepath)
 {
-	lock();
+	// node paths are of the form /obj/<topic name><instance>
+	static constexpr char prefix[] = "/obj/";
+	static constexpr size_t prefix_len = sizeof(prefix) - 1;
 
-	for (uORB::DeviceNode *node : _node_list) {
-		if (strcmp(node->get_devname(), nodepath) == 0) {
-			unlock();
-			return node;
-		}
+	if (nodepath == nullptr || strncmp(nodepath, prefix, prefix_len) != 0) {
+		return nullptr;
 	}
 
-	unlock();
+	const char *name = nodepath + prefix_len;
+	const size_t name_len = strlen(name);
 
-	return nullptr;
+	if (name_len < 2 || name[name_len - 1] < '0' || name[name_len - 1] > '9') {
+		return nullptr;
+	}
+
+	const ORB_ID id = getOrbId(name, name_len - 1);
+
+	if (id == ORB_ID::INVALID) {
+		return nullptr;
+	}
+
+	return getDeviceNode(get_orb_meta(id), name[name_len - 1] - '0');
 }
 
 uORB::DeviceNode *uORB::DeviceMaster::getDeviceNodeLocked(const struct orb_metadata *meta, const uint8_t instance)
 {
+	if (instance >= ORB_MULTI_MAX_INSTANCES) {
+		return nullptr;
+	}
+
+#if defined(UORB_DEVICE_MASTER_NODE_TABLE)
+	return _node_table[instance][meta->o_id];
+#else
+
 	for (uORB::DeviceNode *node : _node_list) {
-		if ((strcmp(node->get_name(), meta->o_name) == 0) && (node->get_instance() == instance)) {
+		if (((uint8_t)node->id() == meta->o_id) && (node->get_instance() == instance)) {
 			return node;
 		}
 	}
 
 	return nullptr;
+#endif // UORB_DEVICE_MASTER_NODE_TABLE
+}
+
+ORB_ID uORB::DeviceMaster::getOrbId(const char *name, size_t name_len)
+{
+	const orb_metadata *const *topics = orb_get_topics();
+
+	// the generated topic list is sorted by name
+	size_t left = 0;
+	size_t right = orb_topics_count();
+
+	while (left < right) {
+		const size_t mid = left + (right - left) / 2;
+		const char *topic_name = topics[mid]->o_name;
+
+		int cmp = strncmp(topic_name, name, name_len);
+
+		if (cmp == 0 && topic_name[name_len] != '\0') {
+			// name is a prefix of topic_name
+			cmp = 1;
+		}
+
+		if (cmp == 0) {
+			return static_cast<ORB_ID>(topics[mid]->o_id);
+
+		} else if (cmp < 0) {
+			left = mid + 1;
+
+		} else {
+			right = mid;
+		}
+	}
+
+	return ORB_ID::INVALID;
 }
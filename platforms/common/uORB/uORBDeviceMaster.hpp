@@ -55,6 +55,12 @@ class Manager;
 
 using px4::AtomicBitset;
 
+#if defined(__PX4_POSIX)
+// Direct node lookup by (instance, topic id). This costs a pointer per topic and instance,
+// which is too much RAM on NuttX, there the node list is searched under the lock instead.
+#  define UORB_DEVICE_MASTER_NODE_TABLE
+#endif // __PX4_POSIX
+
 /**
  * Master control device for ObjDev.
  *
@@ -68,20 +74,33 @@ public:
 	int advertise(const struct orb_metadata *meta, bool is_advertiser, int *instance);
 
 	/**
-	 * Public interface for getDeviceNodeLocked(). Takes care of synchronization.
+	 * Find a node given its path (eg /obj/sensor_gyro0).
 	 * @return node if exists, nullptr otherwise
 	 */
 	uORB::DeviceNode *getDeviceNode(const char *node_name);
+
+	/**
+	 * Find a node given its topic and instance. This is a lock-free lookup in the node table.
+	 * @return node if exists, nullptr otherwise
+	 */
 	uORB::DeviceNode *getDeviceNode(const struct orb_metadata *meta, const uint8_t instance)
 	{
 		if (meta == nullptr) {
 			return nullptr;
 		}
 
-		if (!deviceNodeExists(static_cast<ORB_ID>(meta->o_id), instance)) {
+		const ORB_ID id = static_cast<ORB_ID>(meta->o_id);
+
+		if (!deviceNodeExists(id, instance)) {
 			return nullptr;
 		}
 
+#if defined(UORB_DEVICE_MASTER_NODE_TABLE)
+		//We can safely return the node that can be used by any thread, because
+		//a DeviceNode never gets deleted. The table entry is written before the
+		//exists bit is set and never changes afterwards.
+		return _node_table[instance][(uint8_t)id];
+#else
 		lock();
 		uORB::DeviceNode *node = getDeviceNodeLocked(meta, instance);
 		unlock();
@@ -89,7 +108,7 @@ public:
 		//We can safely return the node that can be used by any thread, because
 		//a DeviceNode never gets deleted.
 		return node;
-
+#endif // UORB_DEVICE_MASTER_NODE_TABLE
 	}
 
 	bool deviceNodeExists(ORB_ID id, const uint8_t instance)
@@ -139,8 +158,19 @@ private:
 	 */
 	uORB::DeviceNode *getDeviceNodeLocked(const struct orb_metadata *meta, const uint8_t instance);
 
+	/**
+	 * Find the topic id from its name using a binary search over the (sorted) topic metadata.
+	 * @param name topic name, not necessarily null-terminated
+	 * @param name_len length of the name
+	 * @return topic id, or ORB_ID::INVALID if not found
+	 */
+	static ORB_ID getOrbId(const char *name, size_t name_len);
+
 	IntrusiveSortedList<uORB::DeviceNode *> _node_list;
 	AtomicBitset<ORB_TOPICS_COUNT> _node_exists[ORB_MULTI_MAX_INSTANCES];
+#if defined(UORB_DEVICE_MASTER_NODE_TABLE)
+	uORB::DeviceNode *_node_table[ORB_MULTI_MAX_INSTANCES][ORB_TOPICS_COUNT] {}; /**< direct node index by instance and topic id */
+#endif // UORB_DEVICE_MASTER_NODE_TABLE
 
 	px4_sem_t	_lock; /**< lock to protect access to all class members (also for derived classes) */
 
@@ -163,8 +163,8 @@ uORB::DeviceNode::read(cdev::file_t *filp, char *buffer, size_t buflen)
 	return filp_to_subscription(filp)->copy(buffer) ? _meta->o_size : 0;
 }
 
-ssize_t
-uORB::DeviceNode::write(cdev::file_t *filp, const char *buffer, size_t buflen)
+bool
+uORB::DeviceNode::allocate_data()
 {
 	/*
 	 * Writes are legal from interrupt context as long as the
@@ -172,8 +172,6 @@ uORB::DeviceNode::write(cdev::file_t *filp, const char *buffer, size_t buflen)
 	 *
 	 * Writes outside interrupt context will allocate the object
 	 * if it has not yet been allocated.
-	 *
-	 * Note that filp will usually be NULL.
 	 */
 	if (nullptr == _data) {
 
@@ -195,11 +193,18 @@ uORB::DeviceNode::write(cdev::file_t *filp, const char *buffer, size_t buflen)
 		}
 
 #endif /* __PX4_NUTTX */
+	}
 
-		/* failed or could not allocate */
-		if (nullptr == _data) {
-			return -ENOMEM;
-		}
+	/* failed or could not allocate */
+	return (nullptr != _data);
+}
+
+ssize_t
+uORB::DeviceNode::write(cdev::file_t *filp, const char *buffer, size_t buflen)
+{
+	/* Note that filp will usually be NULL. */
+	if (!allocate_data()) {
+		return -ENOMEM;
 	}
 
 	/* If write size does not match, that is an error */
@@ -209,11 +214,25 @@ uORB::DeviceNode::write(cdev::file_t *filp, const char *buffer, size_t buflen)
 
 	/* Perform an atomic copy. */
 	ATOMIC_ENTER;
+
+#if defined(UORB_DEVICE_NODE_SEQLOCK)
+	// odd sequence: lock-free readers will retry until the write is complete
+	_seq.fetch_add(1);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+#endif // UORB_DEVICE_NODE_SEQLOCK
+
 	/* wrap-around happens after ~49 days, assuming a publisher rate of 1 kHz */
-	unsigned generation = _generation.fetch_add(1);
+	const unsigned generation = _generation.load();
 
 	memcpy(_data + (_meta->o_size * (generation % _queue_size)), buffer, _meta->o_size);
 
+	/* only advance the generation once the data is complete, see view_end() */
+	_generation.fetch_add(1);
+
+#if defined(UORB_DEVICE_NODE_SEQLOCK)
+	_seq.fetch_add(1);
+#endif // UORB_DEVICE_NODE_SEQLOCK
+
 	// callbacks
 	for (auto item : _callbacks) {
 		item->call();
@@ -230,6 +249,44 @@ uORB::DeviceNode::write(cdev::file_t *filp, const char *buffer, size_t buflen)
 	return _meta->o_size;
 }
 
+#if defined(UORB_DEVICE_NODE_SEQLOCK)
+void *
+uORB::DeviceNode::loan()
+{
+	if (!allocate_data()) {
+		return nullptr;
+	}
+
+	lock();
+
+	// odd sequence: lock-free readers will retry until the loan is committed
+	_seq.fetch_add(1);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+
+	return _data + (_meta->o_size * (_generation.load() % _queue_size));
+}
+
+void
+uORB::DeviceNode::commit_loan()
+{
+	_generation.fetch_add(1);
+	_seq.fetch_add(1);
+
+	// callbacks
+	for (auto item : _callbacks) {
+		item->call();
+	}
+
+	/* Mark at least one data has been published */
+	_data_valid = true;
+
+	unlock();
+
+	/* notify any poll waiters */
+	poll_notify(POLLIN);
+}
+#endif // UORB_DEVICE_NODE_SEQLOCK
+
 int
 uORB::DeviceNode::ioctl(cdev::file_t *filp, int cmd, unsigned long arg)
 {
@@ -320,6 +377,56 @@ uORB::DeviceNode::publish(const orb_metadata *meta, orb_advert_t handle, const v
 	return PX4_OK;
 }
 
+#if defined(UORB_DEVICE_NODE_SEQLOCK)
+void *
+uORB::DeviceNode::loan(orb_advert_t handle)
+{
+	uORB::DeviceNode *devnode = (uORB::DeviceNode *)handle;
+
+	if (devnode == nullptr) {
+		errno = EFAULT;
+		return nullptr;
+	}
+
+	return devnode->loan();
+}
+
+int
+uORB::DeviceNode::publish_loan(const orb_metadata *meta, orb_advert_t handle)
+{
+	uORB::DeviceNode *devnode = (uORB::DeviceNode *)handle;
+
+	if ((devnode == nullptr) || (meta == nullptr)) {
+		errno = EFAULT;
+		return PX4_ERROR;
+	}
+
+	int ret = PX4_OK;
+
+#ifdef ORB_COMMUNICATOR
+	/*
+	 * send the data over the Multi-ORB link, while the loaned slot is still locked
+	 */
+	uORBCommunicator::IChannel *ch = uORB::Manager::get_instance()->get_uorb_communicator();
+
+	if (ch != nullptr) {
+		const unsigned generation = devnode->_generation.load();
+		const uint8_t *data = devnode->_data + (meta->o_size * (generation % devnode->_queue_size));
+
+		if (ch->send_message(meta->o_name, meta->o_size, (uint8_t *)data) != 0) {
+			PX4_ERR("Error Sending [%s] topic data over comm_channel", meta->o_name);
+			ret = PX4_ERROR;
+		}
+	}
+
+#endif /* ORB_COMMUNICATOR */
+
+	devnode->commit_loan();
+
+	return ret;
+}
+#endif // UORB_DEVICE_NODE_SEQLOCK
+
 int uORB::DeviceNode::unadvertise(orb_advert_t handle)
 {
 	if (handle == nullptr) {
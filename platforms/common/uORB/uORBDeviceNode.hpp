@@ -42,6 +42,14 @@
 #include <containers/List.hpp>
 #include <px4_platform_common/atomic.h>
 
+#if defined(__PX4_POSIX)
+// On POSIX ATOMIC_ENTER is the per-node mutex. Subscribers read the data lock-free
+// through a sequence lock instead, so that copy() does not contend with publishers.
+#  define UORB_DEVICE_NODE_SEQLOCK
+// Publishers can write into the queue in place (uORB::PublicationLoan), which needs the sequence lock.
+#  define UORB_PUBLICATION_LOAN
+#endif // __PX4_POSIX
+
 namespace uORB
 {
 class DeviceNode;
@@ -228,43 +236,127 @@ public:
 	bool copy(void *dst, unsigned &generation)
 	{
 		if ((dst != nullptr) && (_data != nullptr)) {
-			if (_queue_size == 1) {
-				ATOMIC_ENTER;
-				memcpy(dst, _data, _meta->o_size);
-				generation = _generation.load();
-				ATOMIC_LEAVE;
-				return true;
-
-			} else {
-				ATOMIC_ENTER;
-				const unsigned current_generation = _generation.load();
-
-				if (current_generation == generation) {
-					/* The subscriber already read the latest message, but nothing new was published yet.
-					* Return the previous message
-					*/
-					--generation;
-				}
+#if defined(UORB_DEVICE_NODE_SEQLOCK)
 
-				// Compatible with normal and overflow conditions
-				if (!is_in_range(current_generation - _queue_size, generation, current_generation - 1)) {
-					// Reader is too far behind: some messages are lost
-					generation = current_generation - _queue_size;
-				}
+			// optimistic read: retry if a publisher was active at any point during the copy
+			for (int i = 0; i < SEQLOCK_MAX_RETRIES; i++) {
+				const unsigned seq_begin = _seq.load();
 
-				memcpy(dst, _data + (_meta->o_size * (generation % _queue_size)), _meta->o_size);
-				ATOMIC_LEAVE;
+				if ((seq_begin & 1) == 0) {
+					unsigned copied_generation = generation;
+					copy_unlocked(dst, copied_generation);
 
-				++generation;
+					// order the data reads above before re-reading the sequence
+					__atomic_thread_fence(__ATOMIC_ACQUIRE);
 
-				return true;
+					if (_seq.load() == seq_begin) {
+						generation = copied_generation;
+						return true;
+					}
+				}
 			}
+
+			// starved by a fast publisher, fall back to the node lock
+#endif // UORB_DEVICE_NODE_SEQLOCK
+
+			ATOMIC_ENTER;
+			copy_unlocked(dst, generation);
+			ATOMIC_LEAVE;
+
+			return true;
 		}
 
 		return false;
 
 	}
 
+	/**
+	 * Begin reading the next message in place, without copying it.
+	 * For a queue size of 1 this requires the sequence lock (POSIX), otherwise the
+	 * message is validated by its generation in view_end().
+	 *
+	 * @param generation
+	 *   in: the last generation seen by the subscriber, out: the generation after the viewed message.
+	 * @param seq
+	 *   Sequence to pass on to view_end().
+	 * @return
+	 *   Pointer to the message in the queue, nullptr if it cannot be viewed in place (use copy() instead).
+	 */
+	const void *view_begin(unsigned &generation, unsigned &seq) const
+	{
+		if (_data == nullptr) {
+			return nullptr;
+		}
+
+#if defined(UORB_DEVICE_NODE_SEQLOCK)
+		seq = _seq.load();
+
+		if ((_queue_size == 1) && (seq & 1)) {
+			// publisher active
+			return nullptr;
+		}
+
+#else
+		seq = 0;
+
+		if (_queue_size == 1) {
+			return nullptr;
+		}
+
+#endif // UORB_DEVICE_NODE_SEQLOCK
+
+		return next_slot(generation);
+	}
+
+	/**
+	 * Check whether the message returned by view_begin() is still intact.
+	 * @param generation The generation returned by view_begin().
+	 * @param seq The sequence returned by view_begin().
+	 * @return true if the message was not overwritten in the meantime
+	 */
+	bool view_end(unsigned generation, unsigned seq) const
+	{
+		// order the data reads before the checks below
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+		if (_queue_size == 1) {
+#if defined(UORB_DEVICE_NODE_SEQLOCK)
+			return _seq.load() == seq;
+#else
+			return false;
+#endif // UORB_DEVICE_NODE_SEQLOCK
+		}
+
+		// A publisher reuses the slot of generation g when writing generation g + queue size. The generation
+		// is only incremented after the write, so the slot is intact as long as it is less than g + queue size.
+		return (_generation.load() - (generation - 1)) < _queue_size;
+	}
+
+#if defined(UORB_DEVICE_NODE_SEQLOCK)
+	/**
+	 * Loan the queue slot of the next generation for in-place publication.
+	 * The node is locked until commit_loan() is called, which must always follow.
+	 * The slot still contains an older message, so all fields have to be written.
+	 * @return pointer to the slot, nullptr on allocation failure
+	 */
+	void *loan();
+
+	/**
+	 * Publish the message written into the loaned slot and release the node.
+	 */
+	void commit_loan();
+
+	/**
+	 * Method to loan the next slot of this node for publication, see loan().
+	 */
+	static void *loan(orb_advert_t handle);
+
+	/**
+	 * Method to publish a loaned slot of this node, see commit_loan().
+	 */
+	static int publish_loan(const orb_metadata *meta, orb_advert_t handle);
+#endif // UORB_DEVICE_NODE_SEQLOCK
+
 	// add item to list of work items to schedule on node update
 	bool register_callback(SubscriptionCallback *callback_sub);
 
@@ -275,6 +367,12 @@ protected:
 
 	px4_pollevent_t poll_state(cdev::file_t *filp) override;
 
+	/**
+	 * Allocate the queue on first publication.
+	 * @return true if the queue is allocated
+	 */
+	bool allocate_data();
+
 	void poll_notify_one(px4_pollfd_struct_t *fds, px4_pollevent_t events) override;
 
 private:
@@ -283,6 +381,10 @@ private:
 	const orb_metadata *_meta; /**< object metadata information */
 
 	uint8_t *_data{nullptr};   /**< allocated object buffer */
+#if defined(UORB_DEVICE_NODE_SEQLOCK)
+	static constexpr int SEQLOCK_MAX_RETRIES = 8;
+	px4::atomic<unsigned>  _seq{0};  /**< sequence lock, odd while a publisher is writing _data */
+#endif // UORB_DEVICE_NODE_SEQLOCK
 	bool _data_valid{false}; /**< At least one valid data */
 	px4::atomic<unsigned>  _generation{0};  /**< object generation count */
 	List<uORB::SubscriptionCallback *>	_callbacks;
@@ -293,6 +395,49 @@ private:
 	int8_t _subscriber_count{0};
 
 
+	/**
+	 * Select the queue slot of the next message for the given generation and advance
+	 * the generation past it. The caller has to either hold the node lock or validate
+	 * the access afterwards.
+	 */
+	const uint8_t *next_slot(unsigned &generation) const
+	{
+		if (_queue_size == 1) {
+			generation = _generation.load();
+			return _data;
+		}
+
+		const unsigned current_generation = _generation.load();
+
+		if (current_generation == generation) {
+			/* The subscriber already read the latest message, but nothing new was published yet.
+			* Return the previous message
+			*/
+			--generation;
+		}
+
+		// Compatible with normal and overflow conditions
+		if (!is_in_range(current_generation - _queue_size, generation, current_generation - 1)) {
+			// Reader is too far behind: some messages are lost
+			generation = current_generation - _queue_size;
+		}
+
+		const uint8_t *slot = _data + (_meta->o_size * (generation % _queue_size));
+
+		++generation;
+
+		return slot;
+	}
+
+	/**
+	 * Copy the next message for the given generation from the queue. The caller
+	 * has to either hold the node lock or validate the copy with the sequence lock.
+	 */
+	void copy_unlocked(void *dst, unsigned &generation) const
+	{
+		memcpy(dst, next_slot(generation), _meta->o_size);
+	}
+
 // Determine the data range
 	static inline bool is_in_range(unsigned left, unsigned value, unsigned right)
 	{
@@ -359,6 +359,42 @@ bool uORB::Manager::orb_data_copy(void *node_handle, void *dst, unsigned &genera
 	return static_cast<DeviceNode *>(node_handle)->copy(dst, generation);
 }
 
+const void *uORB::Manager::orb_data_view_begin(void *node_handle, unsigned &generation, unsigned &seq)
+{
+	return static_cast<DeviceNode *>(node_handle)->view_begin(generation, seq);
+}
+
+bool uORB::Manager::orb_data_view_end(void *node_handle, unsigned generation, unsigned seq)
+{
+	return static_cast<DeviceNode *>(node_handle)->view_end(generation, seq);
+}
+
+void *uORB::Manager::orb_loan(orb_advert_t handle)
+{
+#ifdef ORB_USE_PUBLISHER_RULES
+
+	if (handle == _Instance) {
+		return nullptr;
+	}
+
+#endif /* ORB_USE_PUBLISHER_RULES */
+
+#if defined(UORB_DEVICE_NODE_SEQLOCK)
+	return uORB::DeviceNode::loan(handle);
+#else
+	return nullptr;
+#endif // UORB_DEVICE_NODE_SEQLOCK
+}
+
+int uORB::Manager::orb_publish_loan(const struct orb_metadata *meta, orb_advert_t handle)
+{
+#if defined(UORB_DEVICE_NODE_SEQLOCK)
+	return uORB::DeviceNode::publish_loan(meta, handle);
+#else
+	return PX4_ERROR;
+#endif // UORB_DEVICE_NODE_SEQLOCK
+}
+
 // add item to list of work items to schedule on node update
 bool uORB::Manager::register_callback(void *node_handle, SubscriptionCallback *callback_sub)
 {
@@ -347,6 +347,19 @@ public:
 
 	static bool orb_data_copy(void *node_handle, void *dst, unsigned &generation);
 
+	static const void *orb_data_view_begin(void *node_handle, unsigned &generation, unsigned &seq);
+
+	static bool orb_data_view_end(void *node_handle, unsigned generation, unsigned seq);
+
+	/**
+	 * Loan the next queue slot of a publication to write the message in place.
+	 * Must be followed by orb_publish_loan().
+	 * @return pointer to the slot, nullptr if not supported on this platform (publish a copy instead)
+	 */
+	static void *orb_loan(orb_advert_t handle);
+
+	static int orb_publish_loan(const struct orb_metadata *meta, orb_advert_t handle);
+
 	static bool register_callback(void *node_handle, SubscriptionCallback *callback_sub);
 
 	static void unregister_callback(void *node_handle, SubscriptionCallback *callback_sub);
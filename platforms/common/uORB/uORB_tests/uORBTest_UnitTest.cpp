@@ -39,8 +39,10 @@
 #include <errno.h>
 #include <math.h>
 #include <lib/cdev/CDev.hpp>
+#include <uORB/PublicationLoan.hpp>
 #include <uORB/PublicationMulti.hpp>
 #include <uORB/SubscriptionMultiArray.hpp>
+#include <uORB/SubscriptionView.hpp>
 
 uORBTest::UnitTest &uORBTest::UnitTest::instance()
 {
@@ -206,7 +208,19 @@ int uORBTest::UnitTest::test()
 		return ret;
 	}
 
-	return test_queue_poll_notify();
+	ret = test_queue_poll_notify();
+
+	if (ret != OK) {
+		return ret;
+	}
+
+	ret = test_loan();
+
+	if (ret != OK) {
+		return ret;
+	}
+
+	return test_updated_set();
 }
 
 int uORBTest::UnitTest::test_unadvertise()
@@ -375,6 +389,17 @@ int uORBTest::UnitTest::test_multi()
 		return test_fail("sub #1 val. mismatch: %d", u.val);
 	}
 
+	/* lookups by topic and by node path must resolve to the same node */
+	uORB::DeviceMaster *device_master = uORB::Manager::get_instance()->get_device_master();
+
+	if (device_master->getDeviceNode("/obj/orb_multitest1") != device_master->getDeviceNode(ORB_ID(orb_multitest), 1)) {
+		return test_fail("node lookup by path mismatch");
+	}
+
+	if (device_master->getDeviceNode("/obj/orb_multites1") != nullptr) {
+		return test_fail("node lookup by path found non-existing topic");
+	}
+
 	if (PX4_OK != latency_test(false)) {
 		return test_fail("latency test failed");
 	}
@@ -1117,3 +1142,140 @@ int uORBTest::UnitTest::pubsubtest_threadEntry(int argc, char *argv[])
 	uORBTest::UnitTest &t = uORBTest::UnitTest::instance();
 	return t.pubsublatency_main();
 }
+
+int uORBTest::UnitTest::test_loan()
+{
+	test_note("Testing loaned publication and subscription view");
+
+#if defined(UORB_PUBLICATION_LOAN)
+	uORB::Publication<orb_test_large_s> pub{ORB_ID(orb_test_large)};
+	uORB::Subscription sub{ORB_ID(orb_test_large)};
+	uORB::SubscriptionView<orb_test_large_s> view{sub};
+
+	for (int i = 0; i < 10; i++) {
+		{
+			uORB::PublicationLoan<orb_test_large_s> loan{pub};
+			orb_test_large_s *loaned = loan.get();
+
+			if (loaned == nullptr) {
+				return test_fail("loan %d failed", i);
+			}
+
+			loaned->timestamp = hrt_absolute_time();
+			loaned->val = i;
+			memset(loaned->junk, i, sizeof(loaned->junk));
+
+			if (!loan.publish()) {
+				return test_fail("loan publish %d failed", i);
+			}
+		}
+
+		const orb_test_large_s *msg = view.begin();
+
+		if (msg == nullptr) {
+			return test_fail("view %d: no update", i);
+		}
+
+		const int val = msg->val;
+		const uint8_t junk = msg->junk[sizeof(msg->junk) - 1];
+
+		if (!view.end()) {
+			return test_fail("view %d: message overwritten", i);
+		}
+
+		if ((val != i) || (junk != i)) {
+			return test_fail("view %d: mismatch %d, %d", i, val, junk);
+		}
+
+		if (view.begin() != nullptr) {
+			return test_fail("view %d: spurious update", i);
+		}
+	}
+
+#endif // UORB_PUBLICATION_LOAN
+
+	// queued topic: a viewed message is overwritten once the publisher wraps around to its slot
+	static constexpr uint8_t QUEUE_SIZE = 4;
+	uORB::Publication<orb_test_medium_s, QUEUE_SIZE> queue_pub{ORB_ID(orb_test_medium_view)};
+	uORB::Subscription queue_sub{ORB_ID(orb_test_medium_view)};
+	uORB::SubscriptionView<orb_test_medium_s> queue_view{queue_sub};
+
+	orb_test_medium_s t{};
+	int val = 0;
+
+	t.val = val++;
+	queue_pub.publish(t);
+
+	const orb_test_medium_s *msg = queue_view.begin();
+
+	if ((msg == nullptr) || (msg->val != 0)) {
+		return test_fail("queue view: no update");
+	}
+
+	// the slot is still intact while less than the queue size messages were published
+	for (int i = 0; i < QUEUE_SIZE - 2; i++) {
+		t.val = val++;
+		queue_pub.publish(t);
+	}
+
+	if ((msg->val != 0) || !queue_view.end()) {
+		return test_fail("queue view: intact message reported as overwritten");
+	}
+
+	msg = queue_view.begin();
+
+	if ((msg == nullptr) || (msg->val != 1)) {
+		return test_fail("queue view: next message missing");
+	}
+
+	for (int i = 0; i < QUEUE_SIZE; i++) {
+		t.val = val++;
+		queue_pub.publish(t);
+	}
+
+	if (queue_view.end()) {
+		return test_fail("queue view: overwritten message not detected");
+	}
+
+	return test_note("PASS loaned publication and subscription view");
+}
+
+int uORBTest::UnitTest::test_updated_set()
+{
+	test_note("Testing updated set");
+
+	uORB::Publication<orb_test_medium_s> pub{ORB_ID(orb_test_medium)};
+	orb_test_medium_s msg{};
+	pub.publish(msg);
+
+	uORB::SubscriptionInterval subs[2] {{ORB_ID(orb_test_medium)}, {ORB_ID(orb_test_large)}};
+	px4::Bitset<2> updated;
+
+	// consume existing data
+	for (auto &sub : subs) {
+		orb_test_large_s data;
+		sub.subscribe();
+		sub.copy(&data);
+	}
+
+	if ((uORB::updated_set(subs, 2, updated) != 0) || updated[0] || updated[1]) {
+		return test_fail("spurious update");
+	}
+
+	msg.val = 1;
+	pub.publish(msg);
+
+	if ((uORB::updated_set(subs, 2, updated) != 1) || !updated[0] || updated[1]) {
+		return test_fail("missing update");
+	}
+
+	if (!subs[0].update(&msg) || (msg.val != 1)) {
+		return test_fail("update failed");
+	}
+
+	if ((uORB::updated_set(subs, 2, updated) != 0) || updated[0]) {
+		return test_fail("update not cleared");
+	}
+
+	return test_note("PASS updated set");
+}
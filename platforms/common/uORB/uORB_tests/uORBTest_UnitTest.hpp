@@ -115,6 +115,9 @@ private:
 	int test_queue_poll_notify();
 	volatile int _num_messages_sent = 0;
 
+	int test_loan();
+	int test_updated_set();
+
 	int test_fail(const char *fmt, ...);
 	int test_note(const char *fmt, ...);
 };
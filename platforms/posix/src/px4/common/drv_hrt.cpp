@@ -46,6 +46,7 @@
 
 #include <semaphore.h>
 #include <time.h>
+#include <stdlib.h>
 #include <string.h>
 #include <errno.h>
 #include "hrt_work.h"
@@ -59,9 +60,19 @@ static constexpr unsigned HRT_INTERVAL_MIN = 50;
 static constexpr unsigned HRT_INTERVAL_MAX = 50000000;
 
 /*
- * Queue of callout entries.
+ * Queue of callout entries, a binary min-heap ordered by deadline.
+ * Entries with the same deadline are called in the order they were entered.
  */
-static struct sq_queue_s	callout_queue;
+struct callout_node {
+	hrt_abstime		deadline;
+	uint64_t		sequence;
+	struct hrt_call		*call;
+};
+
+static callout_node		*callout_heap = nullptr;
+static unsigned			callout_heap_size = 0;
+static unsigned			callout_heap_capacity = 0;
+static uint64_t			callout_sequence = 0;
 
 /* latency baseline (last compare value applied) */
 static uint64_t			latency_baseline;
@@ -88,6 +99,8 @@ static void hrt_latency_update();
 static void hrt_call_reschedule();
 static void hrt_call_invoke();
 
+static void callout_heap_remove(struct hrt_call *entry);
+
 hrt_abstime hrt_absolute_time_offset()
 {
 	return px4_timestart_monotonic;
@@ -184,7 +197,7 @@ bool	hrt_called(struct hrt_call *entry)
 void	hrt_cancel(struct hrt_call *entry)
 {
 	hrt_lock();
-	sq_rem(&entry->link, &callout_queue);
+	callout_heap_remove(entry);
 	entry->deadline = 0;
 
 	/* if this is a periodic call being removed by the callout, prevent it from
@@ -237,8 +250,6 @@ void	hrt_call_delay(struct hrt_call *entry, hrt_abstime delay)
  */
 void	hrt_init()
 {
-	sq_init(&callout_queue);
-
 	int sem_ret = px4_sem_init(&_hrt_lock, 0, 1);
 
 	if (sem_ret) {
@@ -248,29 +259,129 @@ void	hrt_init()
 	memset(&_hrt_work, 0, sizeof(_hrt_work));
 }
 
+static inline bool
+callout_before(const callout_node &a, const callout_node &b)
+{
+	return (a.deadline < b.deadline) || ((a.deadline == b.deadline) && (a.sequence < b.sequence));
+}
+
+static inline void
+callout_heap_set(unsigned index, const callout_node &node)
+{
+	callout_heap[index] = node;
+	node.call->heap_index = index + 1;
+}
+
+static void
+callout_heap_sift_up(unsigned index)
+{
+	const callout_node node = callout_heap[index];
+
+	while (index > 0) {
+		const unsigned parent = (index - 1) / 2;
+
+		if (!callout_before(node, callout_heap[parent])) {
+			break;
+		}
+
+		callout_heap_set(index, callout_heap[parent]);
+		index = parent;
+	}
+
+	callout_heap_set(index, node);
+}
+
+static void
+callout_heap_sift_down(unsigned index)
+{
+	const callout_node node = callout_heap[index];
+
+	while (true) {
+		unsigned child = 2 * index + 1;
+
+		if (child >= callout_heap_size) {
+			break;
+		}
+
+		if ((child + 1 < callout_heap_size) && callout_before(callout_heap[child + 1], callout_heap[child])) {
+			child++;
+		}
+
+		if (!callout_before(callout_heap[child], node)) {
+			break;
+		}
+
+		callout_heap_set(index, callout_heap[child]);
+		index = child;
+	}
+
+	callout_heap_set(index, node);
+}
+
+/*
+ * The heap index of an entry is only trusted if it points back to the entry,
+ * as entries are not required to be initialised before the first use.
+ */
+static bool
+callout_heap_contains(const struct hrt_call *entry)
+{
+	return (entry->heap_index > 0) && (entry->heap_index <= callout_heap_size)
+	       && (callout_heap[entry->heap_index - 1].call == entry);
+}
+
+static void
+callout_heap_remove(struct hrt_call *entry)
+{
+	if (!callout_heap_contains(entry)) {
+		return;
+	}
+
+	const unsigned index = entry->heap_index - 1;
+	entry->heap_index = 0;
+	callout_heap_size--;
+
+	if (index != callout_heap_size) {
+		// move the last node into the gap and restore the heap order
+		callout_heap_set(index, callout_heap[callout_heap_size]);
+
+		if ((index > 0) && callout_before(callout_heap[index], callout_heap[(index - 1) / 2])) {
+			callout_heap_sift_up(index);
+
+		} else {
+			callout_heap_sift_down(index);
+		}
+	}
+}
+
+static struct hrt_call *
+callout_heap_peek()
+{
+	return (callout_heap_size > 0) ? callout_heap[0].call : nullptr;
+}
+
 static void
 hrt_call_enter(struct hrt_call *entry)
 {
-	struct hrt_call	*call, *next;
+	if (callout_heap_size >= callout_heap_capacity) {
+		const unsigned capacity = (callout_heap_capacity > 0) ? 2 * callout_heap_capacity : 64;
+		callout_node *heap = (callout_node *)realloc(callout_heap, capacity * sizeof(callout_node));
 
-	call = (struct hrt_call *)sq_peek(&callout_queue);
+		if (heap == nullptr) {
+			PX4_ERR("callout queue alloc failed");
+			return;
+		}
 
-	if ((call == nullptr) || (entry->deadline < call->deadline)) {
-		sq_addfirst(&entry->link, &callout_queue);
-		//if (call != nullptr) PX4_INFO("call enter at head, reschedule (%lu %lu)", entry->deadline, call->deadline);
-		/* we changed the next deadline, reschedule the timer event */
-		hrt_call_reschedule();
+		callout_heap = heap;
+		callout_heap_capacity = capacity;
+	}
 
-	} else {
-		do {
-			next = (struct hrt_call *)sq_next(&call->link);
+	const unsigned index = callout_heap_size++;
+	callout_heap_set(index, callout_node{entry->deadline, callout_sequence++, entry});
+	callout_heap_sift_up(index);
 
-			if ((next == nullptr) || (entry->deadline < next->deadline)) {
-				//lldbg("call enter after head\n");
-				sq_addafter(&call->link, &entry->link, &callout_queue);
-				break;
-			}
-		} while ((call = next) != nullptr);
+	if (callout_heap[0].call == entry) {
+		/* we changed the next deadline, reschedule the timer event */
+		hrt_call_reschedule();
 	}
 }
 
@@ -309,7 +420,7 @@ hrt_call_reschedule()
 {
 	hrt_abstime	now = hrt_absolute_time();
 	hrt_abstime	delay = HRT_INTERVAL_MAX;
-	struct hrt_call	*next = (struct hrt_call *)sq_peek(&callout_queue);
+	struct hrt_call	*next = callout_heap_peek();
 	hrt_abstime	deadline = now + HRT_INTERVAL_MAX;
 
 	/*
@@ -357,16 +468,7 @@ hrt_call_internal(struct hrt_call *entry, hrt_abstime deadline, hrt_abstime inte
 
 	//PX4_INFO("hrt_call_internal after lock");
 	/* if the entry is currently queued, remove it */
-	/* note that we are using a potentially uninitialised
-	   entry->link here, but it is safe as sq_rem() doesn't
-	   dereference the passed node unless it is found in the
-	   list. So we potentially waste a bit of time searching the
-	   queue for the uninitialised entry->link but we don't do
-	   anything actually unsafe.
-	*/
-	if (entry->deadline != 0) {
-		sq_rem(&entry->link, &callout_queue);
-	}
+	callout_heap_remove(entry);
 
 #if 1
 
@@ -437,7 +539,7 @@ hrt_call_invoke()
 		/* get the current time */
 		hrt_abstime now = hrt_absolute_time();
 
-		call = (struct hrt_call *)sq_peek(&callout_queue);
+		call = callout_heap_peek();
 
 		if (call == nullptr) {
 			break;
@@ -447,12 +549,12 @@ hrt_call_invoke()
 			break;
 		}
 
-		sq_rem(&call->link, &callout_queue);
-		//PX4_INFO("call pop");
-
 		/* save the intended deadline for periodic calls */
 		deadline = call->deadline;
 
+		callout_heap_remove(call);
+		//PX4_INFO("call pop");
+
 		/* zero the deadline, as the call has occurred */
 		call->deadline = 0;
 
@@ -53,6 +53,12 @@
 #include <mach/mach.h>
 #endif
 
+#ifdef __PX4_LINUX
+#include <dirent.h>
+#include <stdlib.h>
+#include <px4_platform_common/thread_stat.h>
+#endif
+
 #ifdef __PX4_QURT
 // dprintf is not available on QURT. Use the usual output to mini-dm.
 #define dprintf(_fd, _text, ...) ((_fd) == 1 ? PX4_INFO((_text), ##__VA_ARGS__) : (void)(_fd))
@@ -77,7 +83,117 @@ void init_print_load(struct print_load_s *s)
 	}
 
 	s->interval_time_us = 0.f;
+
+#ifdef __PX4_LINUX
+	memset(s->last_tids, 0, sizeof(s->last_tids));
+	memset(s->last_cpu_busy, 0, sizeof(s->last_cpu_busy));
+	memset(s->last_cpu_total, 0, sizeof(s->last_cpu_total));
+#endif
+}
+
+#ifdef __PX4_LINUX
+static void print_load_linux(int fd, struct print_load_s *print_state, const char *clear_line)
+{
+	const hrt_abstime now = hrt_absolute_time();
+	const float interval_s = (now - print_state->new_time) * 1e-6f;
+	print_state->new_time = now;
+
+	const long ticks_per_s = sysconf(_SC_CLK_TCK);
+
+	// per core utilisation since the last call
+	FILE *proc_stat = fopen("/proc/stat", "r");
+
+	if (proc_stat) {
+		char line[256];
+		dprintf(fd, "%sCPU cores:\n", clear_line);
+
+		while (fgets(line, sizeof(line), proc_stat)) {
+			unsigned cpu;
+			unsigned long long user, nice, system, idle, iowait, irq, softirq, steal;
+
+			// skip the aggregated "cpu " line, per core lines only
+			if (sscanf(line, "cpu%u %llu %llu %llu %llu %llu %llu %llu %llu", &cpu, &user, &nice, &system, &idle, &iowait,
+				   &irq, &softirq, &steal) != 9) {
+				continue;
+			}
+
+			if (cpu >= PRINT_LOAD_MAX_CPUS) {
+				continue;
+			}
+
+			const uint64_t busy = user + nice + system + irq + softirq + steal;
+			const uint64_t total = busy + idle + iowait;
+
+			const uint64_t d_busy = busy - print_state->last_cpu_busy[cpu];
+			const uint64_t d_total = total - print_state->last_cpu_total[cpu];
+			print_state->last_cpu_busy[cpu] = busy;
+			print_state->last_cpu_total[cpu] = total;
+
+			dprintf(fd, "%s cpu%-2u %5.1f%%\n", clear_line, cpu, (d_total > 0) ? (double)(100.f * d_busy / d_total) : 0.);
+		}
+
+		fclose(proc_stat);
+	}
+
+	// threads of this process
+	DIR *dir = opendir("/proc/self/task");
+
+	if (dir == nullptr) {
+		return;
+	}
+
+	int tids[CONFIG_FS_PROCFS_MAX_TASKS] {};
+	uint64_t times[CONFIG_FS_PROCFS_MAX_TASKS] {};
+	int num_threads = 0;
+
+	dprintf(fd, "%s\n%s  TID COMMAND                   CPU(%%) CORE MIGRATIONS PRI STATE\n", clear_line, clear_line);
+
+	struct dirent *entry;
+
+	while ((entry = readdir(dir)) != nullptr) {
+		const int tid = atoi(entry->d_name);
+
+		if (tid <= 0) {
+			continue;
+		}
+
+		px4_thread_stat_s stat{};
+
+		if (!px4_read_thread_stat(tid, &stat)) {
+			continue;
+		}
+
+		const uint64_t ticks = stat.ticks;
+
+		// CPU usage since the last call
+		float load = 0.f;
+
+		for (int i = 0; i < CONFIG_FS_PROCFS_MAX_TASKS; i++) {
+			if (print_state->last_tids[i] == tid) {
+				if (interval_s > 0.f && ticks_per_s > 0) {
+					load = 100.f * (ticks - print_state->last_times[i]) / ticks_per_s / interval_s;
+				}
+
+				break;
+			}
+		}
+
+		if (num_threads < CONFIG_FS_PROCFS_MAX_TASKS) {
+			tids[num_threads] = tid;
+			times[num_threads] = ticks;
+			num_threads++;
+		}
+
+		dprintf(fd, "%s%5d %-24s %6.1f %4d %10lld %3d %c\n", clear_line, tid, stat.name, (double)load, stat.cpu,
+			px4_read_thread_migrations(tid), stat.priority, stat.state);
+	}
+
+	closedir(dir);
+
+	memcpy(print_state->last_tids, tids, sizeof(tids));
+	memcpy(print_state->last_times, times, sizeof(times));
 }
+#endif // __PX4_LINUX
 
 void print_load(int fd, struct print_load_s *print_state)
 {
@@ -91,8 +207,11 @@ void print_load(int fd, struct print_load_s *print_state)
 		memset(clear_line, 0, sizeof(clear_line));
 	}
 
-#if defined(__PX4_LINUX) || defined(__PX4_CYGWIN) || defined(__PX4_QURT)
-	dprintf(fd, "%sTOP NOT IMPLEMENTED ON LINUX, QURT, WINDOWS (ONLY ON NUTTX, APPLE)\n", clear_line);
+#if defined(__PX4_LINUX)
+	print_load_linux(fd, print_state, clear_line);
+
+#elif defined(__PX4_CYGWIN) || defined(__PX4_QURT)
+	dprintf(fd, "%sTOP NOT IMPLEMENTED ON QURT, WINDOWS (ONLY ON NUTTX, APPLE, LINUX)\n", clear_line);
 
 #elif defined(__PX4_DARWIN)
 	pid_t pid = getpid();   //-- this is the process id you need info for
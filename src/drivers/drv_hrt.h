@@ -76,6 +76,9 @@ typedef struct hrt_call {
 	hrt_abstime		period;
 	hrt_callout		callout;
 	void			*arg;
+#if defined(__PX4_POSIX)
+	unsigned		heap_index;	// position in the callout heap (1-based, 0 if not queued)
+#endif
 } *hrt_call_t;
 
 
@@ -39,17 +39,6 @@
 
 using namespace time_literals;
 
-static constexpr int32_t sum(const int16_t samples[], uint8_t len)
-{
-	int32_t sum = 0;
-
-	for (int n = 0; n < len; n++) {
-		sum += samples[n];
-	}
-
-	return sum;
-}
-
 PX4Gyroscope::PX4Gyroscope(uint32_t device_id, enum Rotation rotation) :
 	_device_id{device_id},
 	_rotation{rotation}
@@ -115,17 +104,71 @@ void PX4Gyroscope::update(const hrt_abstime &timestamp_sample, float x, float y,
 
 void PX4Gyroscope::updateFIFO(sensor_gyro_fifo_s &sample)
 {
-	// rotate all raw samples and publish fifo
 	const uint8_t N = sample.samples;
 
+	// write the fifo publication in place if it can be loaned, otherwise rotate and publish the sample
+	uORB::PublicationLoan<sensor_gyro_fifo_s> fifo_loan{_sensor_fifo_pub};
+	const bool loaned = (fifo_loan.get() != nullptr);
+	sensor_gyro_fifo_s &fifo = loaned ? *fifo_loan.get() : sample;
+
+	if (loaned) {
+		static constexpr int FIFO_SIZE_MAX = sizeof(sample.x) / sizeof(sample.x[0]);
+
+		fifo.timestamp_sample = sample.timestamp_sample;
+		fifo.dt = sample.dt;
+		fifo.samples = N;
+
+		// the loaned message still contains older samples
+		if (N < FIFO_SIZE_MAX) {
+			memset(&fifo.x[N], 0, (FIFO_SIZE_MAX - N) * sizeof(fifo.x[0]));
+			memset(&fifo.y[N], 0, (FIFO_SIZE_MAX - N) * sizeof(fifo.y[0]));
+			memset(&fifo.z[N], 0, (FIFO_SIZE_MAX - N) * sizeof(fifo.z[0]));
+		}
+	}
+
+	// rotate all raw samples and publish fifo, summing them up for the integration below
+	int32_t sum_x = 0;
+	int32_t sum_y = 0;
+	int32_t sum_z = 0;
+
 	for (int n = 0; n < N; n++) {
-		rotate_3i(_rotation, sample.x[n], sample.y[n], sample.z[n]);
+		fifo.x[n] = sample.x[n];
+		fifo.y[n] = sample.y[n];
+		fifo.z[n] = sample.z[n];
+		rotate_3i(_rotation, fifo.x[n], fifo.y[n], fifo.z[n]);
+
+		if (n < N - 1) {
+			sum_x += fifo.x[n];
+			sum_y += fifo.y[n];
+			sum_z += fifo.z[n];
+		}
 	}
 
-	sample.device_id = _device_id;
-	sample.scale = _scale;
-	sample.timestamp = hrt_absolute_time();
-	_sensor_fifo_pub.publish(sample);
+	const int16_t last_x = fifo.x[N - 1];
+	const int16_t last_y = fifo.y[N - 1];
+	const int16_t last_z = fifo.z[N - 1];
+
+	fifo.device_id = _device_id;
+	fifo.scale = _scale;
+	fifo.timestamp = hrt_absolute_time();
+
+	// publish right away, a loan keeps the topic locked
+	if (loaned) {
+		fifo_loan.publish();
+
+	} else {
+		_sensor_fifo_pub.publish(sample);
+	}
+
+	// trapezoidal integration (equally spaced)
+	const float scale = _scale / (float)N;
+	const float integral_x = (0.5f * (_last_sample[0] + last_x) + sum_x) * scale;
+	const float integral_y = (0.5f * (_last_sample[1] + last_y) + sum_y) * scale;
+	const float integral_z = (0.5f * (_last_sample[2] + last_z) + sum_z) * scale;
+
+	_last_sample[0] = last_x;
+	_last_sample[1] = last_y;
+	_last_sample[2] = last_z;
 
 
 	// publish
@@ -134,17 +177,9 @@ void PX4Gyroscope::updateFIFO(sensor_gyro_fifo_s &sample)
 	report.device_id = _device_id;
 	report.temperature = _temperature;
 	report.error_count = _error_count;
-
-	// trapezoidal integration (equally spaced)
-	const float scale = _scale / (float)N;
-	report.x = (0.5f * (_last_sample[0] + sample.x[N - 1]) + sum(sample.x, N - 1)) * scale;
-	report.y = (0.5f * (_last_sample[1] + sample.y[N - 1]) + sum(sample.y, N - 1)) * scale;
-	report.z = (0.5f * (_last_sample[2] + sample.z[N - 1]) + sum(sample.z, N - 1)) * scale;
-
-	_last_sample[0] = sample.x[N - 1];
-	_last_sample[1] = sample.y[N - 1];
-	_last_sample[2] = sample.z[N - 1];
-
+	report.x = integral_x;
+	report.y = integral_y;
+	report.z = integral_z;
 	report.samples = N;
 	report.timestamp = hrt_absolute_time();
 
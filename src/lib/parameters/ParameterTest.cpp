@@ -38,6 +38,12 @@
 
 #include <gtest/gtest.h>
 
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <string>
+
 class ParameterTest : public ::testing::Test
 {
 public:
@@ -79,6 +85,51 @@ TEST_F(ParameterTest, testParamReadWrite)
 }
 
 
+TEST_F(ParameterTest, testParamFind)
+{
+	// GIVEN: all parameter names
+	for (unsigned i = 0; i < param_count(); i++) {
+		const param_t param = param_for_index(i);
+		const char *name = param_name(param);
+
+		// WHEN: we look up the name
+		// THEN: the same handle should be found
+		EXPECT_EQ(param, param_find_no_notification(name)) << name;
+
+		// WHEN: we look up a name that does not exist
+		char unknown_name[32];
+		snprintf(unknown_name, sizeof(unknown_name), "%s_", name);
+
+		// THEN: it should not be found
+		EXPECT_EQ(PARAM_INVALID, param_find_no_notification(unknown_name)) << unknown_name;
+	}
+
+	EXPECT_EQ(PARAM_INVALID, param_find_no_notification(""));
+}
+
+TEST_F(ParameterTest, testParamResetChanged)
+{
+	// GIVEN: two changed parameters
+	const param_t cp_dist = param_handle(px4::params::CP_DIST);
+	const param_t cp_delay = param_handle(px4::params::CP_DELAY);
+	float value = 42.f;
+	EXPECT_EQ(0, param_set_no_notification(cp_dist, &value));
+	value = 0.5f;
+	EXPECT_EQ(0, param_set_no_notification(cp_delay, &value));
+
+	// WHEN: one of them is reset
+	EXPECT_EQ(0, param_reset_no_notification(cp_dist));
+
+	// THEN: it should have the default value again and the other one is unaffected
+	EXPECT_EQ(0, param_get(cp_dist, &value));
+	EXPECT_FLOAT_EQ(-1.f, value);
+	EXPECT_TRUE(param_value_is_default(cp_dist));
+
+	EXPECT_EQ(0, param_get(cp_delay, &value));
+	EXPECT_FLOAT_EQ(0.5f, value);
+	EXPECT_FALSE(param_value_is_default(cp_delay));
+}
+
 TEST_F(ParameterTest, testUorbSendReceive)
 {
 	// GIVEN: a uOrb message
@@ -106,3 +157,294 @@ TEST_F(ParameterTest, testUorbSendReceive)
 	// AND: all the bytes should be equal
 	EXPECT_EQ(0, memcmp(&message, &obstacle_distance, sizeof(message)));
 }
+
+namespace
+{
+constexpr const char *DEFAULT_FILE = "param_journal_test.bson";
+constexpr const char *JOURNAL_FILE = "param_journal_test.journal";
+constexpr const char *BACKUP_FILE = "param_journal_test_backup.bson";
+constexpr const char *IMPORT_FILE = "param_journal_test_import.bson";
+
+constexpr off_t JOURNAL_HEADER_SIZE = 12;
+constexpr off_t CP_DIST_RECORD_SIZE = 2 + 7 + 4 + 4; // type, name length, "CP_DIST", value, CRC
+}
+
+class ParameterJournalTest : public ParameterTest
+{
+public:
+	void SetUp() override
+	{
+		ParameterTest::SetUp();
+
+		const char *default_file = param_get_default_file();
+
+		if (default_file) {
+			_original_default_file = default_file;
+		}
+
+		unlink(DEFAULT_FILE);
+		unlink(JOURNAL_FILE);
+		unlink(BACKUP_FILE);
+		unlink(IMPORT_FILE);
+
+		ASSERT_EQ(0, param_set_default_file(DEFAULT_FILE));
+		ASSERT_EQ(0, param_set_backup_file(BACKUP_FILE));
+		ASSERT_EQ(0, param_set_journal_file(JOURNAL_FILE));
+
+		// the first save after selecting the journal rewrites the default file and starts an empty journal
+		ASSERT_EQ(0, param_save_default());
+		ASSERT_EQ(JOURNAL_HEADER_SIZE, fileSize(JOURNAL_FILE));
+	}
+
+	void TearDown() override
+	{
+		param_set_journal_file(nullptr);
+		param_set_default_file(_original_default_file.empty() ? nullptr : _original_default_file.c_str());
+		param_set_backup_file(nullptr);
+
+		unlink(DEFAULT_FILE);
+		unlink(JOURNAL_FILE);
+		unlink(BACKUP_FILE);
+		unlink(IMPORT_FILE);
+
+		param_reset_all();
+	}
+
+	static off_t fileSize(const char *path)
+	{
+		struct stat st {};
+		return (stat(path, &st) == 0) ? st.st_size : -1;
+	}
+
+	static std::string fileContent(const char *path)
+	{
+		std::string content;
+		int fd = open(path, O_RDONLY);
+		char buffer[256];
+		ssize_t nread;
+
+		while (fd >= 0 && (nread = read(fd, buffer, sizeof(buffer))) > 0) {
+			content.append(buffer, nread);
+		}
+
+		if (fd >= 0) {
+			close(fd);
+		}
+
+		return content;
+	}
+
+	static void setFloat(param_t param, float value)
+	{
+		EXPECT_EQ(0, param_set_no_notification(param, &value));
+	}
+
+	static float getFloat(param_t param)
+	{
+		float value = NAN;
+		EXPECT_EQ(0, param_get(param, &value));
+		return value;
+	}
+
+	const param_t _cp_dist{param_handle(px4::params::CP_DIST)};
+	const param_t _cp_delay{param_handle(px4::params::CP_DELAY)};
+
+private:
+	std::string _original_default_file;
+};
+
+TEST_F(ParameterJournalTest, testJournalAppend)
+{
+	const std::string default_content = fileContent(DEFAULT_FILE);
+	const std::string backup_content = fileContent(BACKUP_FILE);
+
+	// WHEN: a parameter is changed and saved
+	setFloat(_cp_dist, 42.f);
+	EXPECT_EQ(0, param_save_default());
+
+	// THEN: only a record is appended to the journal and the default and backup files are untouched
+	EXPECT_EQ(JOURNAL_HEADER_SIZE + CP_DIST_RECORD_SIZE, fileSize(JOURNAL_FILE));
+	EXPECT_EQ(default_content, fileContent(DEFAULT_FILE));
+	EXPECT_EQ(backup_content, fileContent(BACKUP_FILE));
+}
+
+TEST_F(ParameterJournalTest, testJournalReplayOnBackup)
+{
+	// GIVEN: a journaled change
+	setFloat(_cp_dist, 42.f);
+	EXPECT_EQ(0, param_save_default());
+
+	// AND: a corrupt default file
+	int fd = open(DEFAULT_FILE, O_WRONLY | O_TRUNC);
+	ASSERT_GE(fd, 0);
+	EXPECT_EQ(4, write(fd, "junk", 4));
+	close(fd);
+
+	// WHEN: the parameters are imported from the backup and the journal is selected again (rcS fallback)
+	param_reset_all();
+	fd = open(BACKUP_FILE, O_RDONLY);
+	ASSERT_GE(fd, 0);
+	EXPECT_EQ(0, param_import(fd));
+	close(fd);
+	ASSERT_EQ(0, param_set_journal_file(JOURNAL_FILE));
+	EXPECT_EQ(0, param_load_journal());
+
+	// THEN: the journaled change is applied on top of the backup
+	EXPECT_FLOAT_EQ(42.f, getFloat(_cp_dist));
+
+	// AND: the next save rewrites the default file
+	setFloat(_cp_delay, 0.5f);
+	EXPECT_EQ(0, param_save_default());
+	EXPECT_EQ(JOURNAL_HEADER_SIZE, fileSize(JOURNAL_FILE));
+
+	param_reset_all();
+	EXPECT_EQ(0, param_load_default());
+	EXPECT_FLOAT_EQ(42.f, getFloat(_cp_dist));
+	EXPECT_FLOAT_EQ(0.5f, getFloat(_cp_delay));
+}
+
+TEST_F(ParameterJournalTest, testJournalSelectKeepsJournal)
+{
+	// GIVEN: a journaled change
+	setFloat(_cp_dist, 42.f);
+	EXPECT_EQ(0, param_save_default());
+	const off_t journal_size = fileSize(JOURNAL_FILE);
+
+	// WHEN: the parameters are loaded and the intact journal is selected again (reboot)
+	param_reset_all();
+	EXPECT_EQ(0, param_load_default());
+	ASSERT_EQ(0, param_set_journal_file(JOURNAL_FILE));
+	EXPECT_EQ(0, param_load_journal());
+
+	// THEN: the next save still appends to it
+	setFloat(_cp_delay, 0.5f);
+	EXPECT_EQ(0, param_save_default());
+	EXPECT_GT(fileSize(JOURNAL_FILE), journal_size);
+	EXPECT_FLOAT_EQ(42.f, getFloat(_cp_dist));
+}
+
+TEST_F(ParameterJournalTest, testJournalReplayOnLoad)
+{
+	// GIVEN: a change and a reset to default saved in the journal
+	setFloat(_cp_dist, 42.f);
+	setFloat(_cp_delay, 0.5f);
+	EXPECT_EQ(0, param_save_default());
+	EXPECT_EQ(0, param_reset_no_notification(_cp_delay));
+	EXPECT_EQ(0, param_save_default());
+
+	// WHEN: the parameters are loaded again
+	param_reset_all();
+	EXPECT_EQ(0, param_load_default());
+
+	// THEN: the journal is applied on top of the default file
+	EXPECT_FLOAT_EQ(42.f, getFloat(_cp_dist));
+	EXPECT_TRUE(param_value_is_default(_cp_delay));
+}
+
+TEST_F(ParameterJournalTest, testJournalTruncatedRecord)
+{
+	// GIVEN: two saved changes, the second one torn by a power loss
+	setFloat(_cp_dist, 42.f);
+	EXPECT_EQ(0, param_save_default());
+	setFloat(_cp_dist, 43.f);
+	EXPECT_EQ(0, param_save_default());
+	ASSERT_EQ(0, truncate(JOURNAL_FILE, fileSize(JOURNAL_FILE) - 3));
+
+	// WHEN: the parameters are loaded again
+	param_reset_all();
+	EXPECT_EQ(0, param_load_default());
+
+	// THEN: only the complete record is applied
+	EXPECT_FLOAT_EQ(42.f, getFloat(_cp_dist));
+
+	// AND: the next save compacts instead of appending after the torn record
+	setFloat(_cp_delay, 0.5f);
+	EXPECT_EQ(0, param_save_default());
+	EXPECT_EQ(JOURNAL_HEADER_SIZE, fileSize(JOURNAL_FILE));
+
+	param_reset_all();
+	EXPECT_EQ(0, param_load_default());
+	EXPECT_FLOAT_EQ(42.f, getFloat(_cp_dist));
+	EXPECT_FLOAT_EQ(0.5f, getFloat(_cp_delay));
+}
+
+TEST_F(ParameterJournalTest, testJournalBaseFileMismatch)
+{
+	// GIVEN: a journal record
+	setFloat(_cp_dist, 42.f);
+	EXPECT_EQ(0, param_save_default());
+
+	// AND: a default file that was rewritten without the journal
+	param_reset_all();
+	setFloat(_cp_delay, 0.5f);
+	unlink(DEFAULT_FILE);
+	EXPECT_EQ(0, param_export(DEFAULT_FILE, nullptr));
+
+	// WHEN: the parameters are loaded again
+	param_reset_all();
+	EXPECT_EQ(0, param_load_default());
+
+	// THEN: the outdated journal is ignored
+	EXPECT_FLOAT_EQ(0.5f, getFloat(_cp_delay));
+	EXPECT_TRUE(param_value_is_default(_cp_dist));
+}
+
+TEST_F(ParameterJournalTest, testJournalImportCompacts)
+{
+	// GIVEN: a journal record and a parameter file from elsewhere
+	setFloat(_cp_dist, 42.f);
+	EXPECT_EQ(0, param_save_default());
+
+	param_reset_all();
+	setFloat(_cp_delay, 0.5f);
+	EXPECT_EQ(0, param_export(IMPORT_FILE, nullptr));
+	param_reset_all();
+	EXPECT_EQ(0, param_load_default());
+
+	// WHEN: the file is imported and the journal replayed again afterwards
+	int fd = open(IMPORT_FILE, O_RDONLY);
+	ASSERT_GE(fd, 0);
+	EXPECT_EQ(0, param_import(fd));
+	close(fd);
+	EXPECT_EQ(0, param_load_journal());
+	EXPECT_EQ(0, param_save_default());
+
+	// THEN: the imported values are saved by rewriting the default file
+	EXPECT_EQ(JOURNAL_HEADER_SIZE, fileSize(JOURNAL_FILE));
+
+	param_reset_all();
+	EXPECT_EQ(0, param_load_default());
+	EXPECT_FLOAT_EQ(42.f, getFloat(_cp_dist));
+	EXPECT_FLOAT_EQ(0.5f, getFloat(_cp_delay));
+}
+
+TEST_F(ParameterJournalTest, testJournalCompaction)
+{
+	// GIVEN: a journal that keeps growing
+	float value = 0.f;
+	off_t journal_size = fileSize(JOURNAL_FILE);
+
+	for (;;) {
+		value += 1.f;
+		setFloat(_cp_dist, value);
+		ASSERT_EQ(0, param_save_default());
+
+		const off_t new_size = fileSize(JOURNAL_FILE);
+
+		// WHEN: it exceeds its size limit
+		if (new_size < journal_size) {
+			// THEN: the default file is rewritten and the journal starts over
+			EXPECT_EQ(JOURNAL_HEADER_SIZE, new_size);
+			break;
+		}
+
+		EXPECT_EQ(journal_size + CP_DIST_RECORD_SIZE, new_size);
+		journal_size = new_size;
+		ASSERT_LT(value, 10000.f);
+	}
+
+	// AND: nothing is lost
+	param_reset_all();
+	EXPECT_EQ(0, param_load_default());
+	EXPECT_FLOAT_EQ(value, getFloat(_cp_dist));
+}
@@ -409,6 +409,36 @@ __EXPORT int 		param_set_backup_file(const char *filename);
  */
 __EXPORT const char	*param_get_backup_file(void);
 
+/**
+ * Set the parameter journal file name.
+ *
+ * If set, param_save_default() appends the changes since the last save to the
+ * journal instead of rewriting the default file, and only rewrites (compacts)
+ * the default file and the backup file once the journal has grown too large.
+ * An existing journal that applies to the imported parameters is kept.
+ *
+ * @param filename	Path to the journal file, nullptr to disable the journal.
+ *			The file is not required to exist.
+ * @return		Zero on success.
+ */
+__EXPORT int 		param_set_journal_file(const char *filename);
+
+/**
+ * Get the parameter journal file name.
+ *
+ * @return		The path to the journal file, or nullptr if disabled
+ */
+__EXPORT const char	*param_get_journal_file(void);
+
+/**
+ * Apply the changes recorded in the journal file on top of the parameters imported from
+ * the default file, or from the backup file written with it. A journal that belongs to neither
+ * is ignored, and an incomplete last record (e.g. after a power loss during a save) is discarded.
+ *
+ * @return		Zero on success (also if there is no journal).
+ */
+__EXPORT int 		param_load_journal(void);
+
 /**
  * Save parameters to the default file.
  * Note: this method requires a large amount of stack size!
@@ -50,11 +50,13 @@
 #include <crc32.h>
 #include <float.h>
 #include <math.h>
+#include <sys/stat.h>
 
 #include <containers/Bitset.hpp>
 #include <drivers/drv_hrt.h>
 #include <lib/perf/perf_counter.h>
 #include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/atomic.h>
 #include <px4_platform_common/atomic_bitset.h>
 #include <px4_platform_common/defines.h>
 #include <px4_platform_common/posix.h>
@@ -79,6 +81,29 @@ inline static int flash_param_import() { return -1; }
 
 static char *param_default_file = nullptr;
 static char *param_backup_file = nullptr;
+static char *param_journal_file = nullptr;
+
+/*
+ * Parameter journal: saves append the unsaved changes to the journal file instead of rewriting
+ * the default file. The journal header holds the CRC of the default file it applies to, so a
+ * journal left over from before the last compaction is ignored on load. The backup file is only
+ * rewritten on compaction, its CRC is kept as well so the journal can be replayed on top of it.
+ * Record layout: type (1), name length (1), name, value (4), CRC32 of the preceding bytes (4).
+ */
+struct param_journal_header_s {
+	uint32_t magic;
+	uint32_t base_crc;
+	uint32_t backup_crc; ///< 0 if there is no backup file
+};
+
+static constexpr uint32_t PARAM_JOURNAL_MAGIC = 0x4e524a50; // 'PJRN'
+static constexpr uint8_t PARAM_JOURNAL_RESET = 0xff; // record type of a parameter reset to default
+static constexpr size_t PARAM_JOURNAL_NAME_MAX = 16;
+static constexpr size_t PARAM_JOURNAL_MAX_SIZE = 8192; // compact once the journal exceeds this size
+
+static bool param_journal_compact_required = true; ///< the next save has to rewrite the default file
+static size_t param_journal_size = 0;
+static uint32_t param_import_crc = 0; ///< CRC of the file the parameters were imported from last, 0 if unknown
 
 #include <px4_platform_common/workqueue.h>
 /* autosaving variables */
@@ -93,14 +118,16 @@ static px4::AtomicBitset<param_info_count> params_changed; // params non-default
 static px4::Bitset<param_info_count> params_custom_default; // params with runtime default value
 static px4::AtomicBitset<param_info_count> params_unsaved;
 
-// Storage for modified parameters.
+// Storage for modified parameters, indexed by param_t. An entry is valid if the params_changed bit is set.
+static union param_value_u param_values[param_info_count] {};
+
+// Storage for custom default values.
 struct param_wbuf_s {
 	union param_value_u val;
 	param_t             param;
 };
 
-/** flexible array holding modified parameter values */
-UT_array *param_values{nullptr};
+/** flexible array holding custom default values */
 UT_array *param_custom_default_values{nullptr};
 
 const UT_icd param_icd = {sizeof(param_wbuf_s), nullptr, nullptr, nullptr};
@@ -116,9 +143,15 @@ static px4_sem_t param_sem; ///< this protects against concurrent access to para
 static int reader_lock_holders = 0;
 static px4_sem_t reader_lock_holders_lock; ///< this protects against concurrent access to reader_lock_holders
 
+// Sequence counter (seqlock) for lock-free readers of param_values and the params_changed and
+// params_custom_default bitsets. Writers hold param_sem and make it odd while they modify them,
+// a reader retries if it changed during the read or takes the reader lock if a write is in progress.
+static px4::atomic<uint32_t> param_values_seq{0};
+
 static perf_counter_t param_export_perf;
 static perf_counter_t param_find_perf;
 static perf_counter_t param_get_perf;
+static perf_counter_t param_get_locked_perf;
 static perf_counter_t param_set_perf;
 
 static px4_sem_t param_sem_save; ///< this protects against concurrent param saves (file or flash access).
@@ -172,6 +205,21 @@ param_unlock_writer()
 	px4_sem_post(&param_sem);
 }
 
+/** start modifying the parameter values, the caller must hold the writer lock */
+static void
+param_values_write_begin()
+{
+	param_values_seq.fetch_add(1);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+/** finish modifying the parameter values */
+static void
+param_values_write_end()
+{
+	param_values_seq.fetch_add(1);
+}
+
 /** assert that the parameter store is locked */
 static void
 param_assert_locked()
@@ -189,6 +237,7 @@ param_init()
 	param_export_perf = perf_alloc(PC_ELAPSED, "param: export");
 	param_find_perf = perf_alloc(PC_COUNT, "param: find");
 	param_get_perf = perf_alloc(PC_COUNT, "param: get");
+	param_get_locked_perf = perf_alloc(PC_COUNT, "param: get locked");
 	param_set_perf = perf_alloc(PC_ELAPSED, "param: set");
 }
 
@@ -223,21 +272,19 @@ param_compare_values(const void *a, const void *b)
 }
 
 /**
- * Locate the modified parameter structure for a parameter, if it exists.
+ * Locate the modified value of a parameter, if it exists.
  *
  * @param param			The parameter being searched.
- * @return			The structure holding the modified value, or
- *				nullptr if the parameter has not been modified.
+ * @return			The modified value, or nullptr if the
+ *				parameter has not been modified.
  */
-static param_wbuf_s *
+static param_value_u *
 param_find_changed(param_t param)
 {
 	param_assert_locked();
 
-	if (params_changed[param] && (param_values != nullptr)) {
-		param_wbuf_s key{};
-		key.param = param;
-		return (param_wbuf_s *)utarray_find(param_values, &key, param_compare_values);
+	if (params_changed[param]) {
+		return &param_values[param];
 	}
 
 	return nullptr;
@@ -269,33 +316,23 @@ static param_t param_find_internal(const char *name, bool notification)
 {
 	perf_count(param_find_perf);
 
-	param_t middle;
-	param_t front = 0;
-	param_t last = param_info_count;
+	static constexpr unsigned hash_buckets = sizeof(px4::parameters_hash_displacement) / sizeof(
+				px4::parameters_hash_displacement[0]);
+	static_assert(sizeof(px4::parameters_hash_index) / sizeof(px4::parameters_hash_index[0]) == param_info_count,
+		      "parameter hash index size mismatch");
 
-	/* perform a binary search of the known parameters */
+	/* look up the only candidate in the generated perfect hash, then verify the name */
+	const int16_t displacement = px4::parameters_hash_displacement[px4::param_name_hash(name, 0) % hash_buckets];
+	const unsigned slot = (displacement < 0) ? (unsigned)(-displacement - 1)
+			      : px4::param_name_hash(name, displacement) % param_info_count;
+	const param_t param = (param_t)px4::parameters_hash_index[slot];
 
-	while (front <= last) {
-		middle = front + (last - front) / 2;
-		int ret = strcmp(name, param_name(middle));
-
-		if (ret == 0) {
-			if (notification) {
-				param_set_used(middle);
-			}
-
-			return middle;
-
-		} else if (middle == front) {
-			/* An end point has been hit, but there has been no match */
-			break;
-
-		} else if (ret < 0) {
-			last = middle;
-
-		} else {
-			front = middle;
+	if (strcmp(name, param_name(param)) == 0) {
+		if (notification) {
+			param_set_used(param);
 		}
+
+		return param;
 	}
 
 	/* not found */
@@ -445,10 +482,10 @@ param_get_value_ptr(param_t param)
 
 	if (handle_in_range(param)) {
 		/* work out whether we're fetching the default or a written value */
-		struct param_wbuf_s *s = param_find_changed(param);
+		const param_value_u *v = param_find_changed(param);
 
-		if (s != nullptr) {
-			return &s->val;
+		if (v != nullptr) {
+			return v;
 
 		} else {
 			if (params_custom_default[param] && param_custom_default_values) {
@@ -476,6 +513,45 @@ param_get_value_ptr(param_t param)
 	return nullptr;
 }
 
+/**
+ * Read the current value of a parameter without taking any lock.
+ *
+ * @param param			The parameter to read.
+ * @param value			The value if successful.
+ * @return			False if the caller has to take the reader lock,
+ *				because of a concurrent write or a custom default value.
+ */
+static bool
+param_get_value_lockfree(param_t param, param_value_u &value)
+{
+	for (int attempt = 0; attempt < 2; attempt++) {
+		const uint32_t seq = param_values_seq.load();
+
+		if (seq & 1) {
+			// a write is in progress, don't spin as we might have preempted the writer
+			return false;
+		}
+
+		if (params_changed[param]) {
+			value.i = __atomic_load_n(&param_values[param].i, __ATOMIC_RELAXED);
+
+		} else if (params_custom_default[param]) {
+			return false;
+
+		} else {
+			value = px4::parameters[param].val;
+		}
+
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+		if (param_values_seq.load() == seq) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
 int
 param_get(param_t param, void *val)
 {
@@ -506,6 +582,14 @@ param_get(param_t param, void *val)
 			}
 		}
 
+		param_value_u value;
+
+		if (param_get_value_lockfree(param, value)) {
+			memcpy(val, &value, param_size(param));
+			return PX4_OK;
+		}
+
+		perf_count(param_get_locked_perf);
 		param_lock_reader();
 		const void *v = param_get_value_ptr(param);
 
@@ -597,8 +681,8 @@ bool param_value_is_default(param_t param)
 		return true;
 
 	} else {
-		// the param_values dynamic array might carry things that have been set
-		// back to default, so we don't rely on the params_changed bitset here
+		// param_values might carry things that have been set back to default,
+		// so we don't rely on the params_changed bitset here
 		switch (param_type(param)) {
 		case PARAM_TYPE_INT32: {
 				param_lock_reader();
@@ -768,78 +852,54 @@ param_set_internal(param_t param, const void *val, bool mark_saved, bool notify_
 	param_lock_writer();
 	perf_begin(param_set_perf);
 
-	// create the parameter store if it doesn't exist
-	if (param_values == nullptr) {
-		utarray_new(param_values, &param_icd);
-
-		// mark all parameters unchanged (default)
-		params_changed.reset();
-		params_unsaved.reset();
-	}
-
-	if (param_values == nullptr) {
-		PX4_ERR("failed to allocate modified values array");
-		goto out;
+	param_values_write_begin();
 
-	} else {
-		param_wbuf_s *s = param_find_changed(param);
+	param_value_u *s = param_find_changed(param);
 
-		if (s == nullptr) {
-			/* construct a new parameter */
-			param_wbuf_s buf{};
-			buf.param = param;
+	if (s == nullptr) {
+		/* construct a new parameter */
+		s = &param_values[param];
+		__atomic_store_n(&s->i, 0, __ATOMIC_RELAXED);
+		param_changed = true;
+	}
 
+	/* update the changed value */
+	switch (param_type(param)) {
+	case PARAM_TYPE_INT32:
+		if (s->i != *(int32_t *)val) {
+			__atomic_store_n(&s->i, *(int32_t *)val, __ATOMIC_RELAXED);
 			param_changed = true;
-
-			/* add it to the array and sort */
-			utarray_push_back(param_values, &buf);
-			utarray_sort(param_values, param_compare_values);
-			params_changed.set(param, true);
-
-			/* find it after sorting */
-			s = param_find_changed(param);
 		}
 
-		if (s == nullptr) {
-			PX4_ERR("error param_values storage slot invalid");
-
-		} else {
-			/* update the changed value */
-			switch (param_type(param)) {
-			case PARAM_TYPE_INT32:
-				if (s->val.i != *(int32_t *)val) {
-					s->val.i = *(int32_t *)val;
-					param_changed = true;
-				}
+		params_changed.set(param, true);
+		params_unsaved.set(param, !mark_saved);
+		result = PX4_OK;
+		break;
 
-				params_changed.set(param, true);
-				params_unsaved.set(param, !mark_saved);
-				result = PX4_OK;
-				break;
+	case PARAM_TYPE_FLOAT:
+		if (fabsf(s->f - * (float *)val) > FLT_EPSILON) {
+			param_value_u v{};
+			v.f = *(float *)val;
+			__atomic_store_n(&s->i, v.i, __ATOMIC_RELAXED);
+			param_changed = true;
+		}
 
-			case PARAM_TYPE_FLOAT:
-				if (fabsf(s->val.f - * (float *)val) > FLT_EPSILON) {
-					s->val.f = *(float *)val;
-					param_changed = true;
-				}
+		params_changed.set(param, true);
+		params_unsaved.set(param, !mark_saved);
+		result = PX4_OK;
+		break;
 
-				params_changed.set(param, true);
-				params_unsaved.set(param, !mark_saved);
-				result = PX4_OK;
-				break;
+	default:
+		PX4_ERR("param_set invalid param type for %s", param_name(param));
+		break;
+	}
 
-			default:
-				PX4_ERR("param_set invalid param type for %s", param_name(param));
-				break;
-			}
-		}
+	param_values_write_end();
 
-		if ((result == PX4_OK) && param_changed && !mark_saved) { // this is false when importing parameters
-			param_autosave();
-		}
+	if ((result == PX4_OK) && param_changed && !mark_saved) { // this is false when importing parameters
+		param_autosave();
 	}
 
-out:
 	perf_end(param_set_perf);
 	param_unlock_writer();
 
@@ -864,6 +924,11 @@ const void *param_get_value_ptr_external(param_t param)
 {
 	return param_get_value_ptr(param);
 }
+
+const void *param_get_changed_value_ptr_external(param_t param)
+{
+	return handle_in_range(param) ? param_find_changed(param) : nullptr;
+}
 #endif
 
 int param_set(param_t param, const void *val)
@@ -911,9 +976,6 @@ int param_set_default_value(param_t param, const void *val)
 	if (param_custom_default_values == nullptr) {
 		utarray_new(param_custom_default_values, &param_icd);
 
-		// mark all parameters unchanged (default)
-		params_custom_default.reset();
-
 		if (param_custom_default_values == nullptr) {
 			PX4_ERR("failed to allocate custom default values array");
 			param_unlock_writer();
@@ -921,6 +983,8 @@ int param_set_default_value(param_t param, const void *val)
 		}
 	}
 
+	param_values_write_begin();
+
 	// check if param being set to default value
 	bool setting_to_static_default = false;
 
@@ -989,6 +1053,7 @@ int param_set_default_value(param_t param, const void *val)
 		}
 	}
 
+	param_values_write_end();
 	param_unlock_writer();
 
 	if ((result == PX4_OK) && param_used(param)) {
@@ -1001,7 +1066,7 @@ int param_set_default_value(param_t param, const void *val)
 
 static int param_reset_internal(param_t param, bool notify = true)
 {
-	param_wbuf_s *s = nullptr;
+	param_value_u *s = nullptr;
 	bool param_found = false;
 
 	param_lock_writer();
@@ -1010,13 +1075,9 @@ static int param_reset_internal(param_t param, bool notify = true)
 		/* look for a saved value */
 		s = param_find_changed(param);
 
-		/* if we found one, erase it */
-		if (s != nullptr) {
-			int pos = utarray_eltidx(param_values, s);
-			utarray_erase(param_values, pos, 1);
-		}
-
+		param_values_write_begin();
 		params_changed.set(param, false);
+		param_values_write_end();
 		params_unsaved.set(param, true);
 
 		param_found = true;
@@ -1041,14 +1102,12 @@ param_reset_all_internal(bool auto_save)
 {
 	param_lock_writer();
 
-	if (param_values != nullptr) {
-		utarray_free(param_values);
-
-		params_changed.reset();
-	}
-
 	/* mark as reset / deleted */
-	param_values = nullptr;
+	param_values_write_begin();
+	params_changed.reset();
+	param_values_write_end();
+
+	param_journal_compact_required = true;
 
 	if (auto_save) {
 		param_autosave();
@@ -1118,7 +1177,7 @@ param_reset_specific(const char *resets[], int num_resets)
 int
 param_set_default_file(const char *filename)
 {
-	if ((param_backup_file && strcmp(filename, param_backup_file) == 0)) {
+	if (filename && param_backup_file && strcmp(filename, param_backup_file) == 0) {
 		PX4_ERR("default file can't be the same as the backup file %s", filename);
 		return PX4_ERROR;
 	}
@@ -1138,6 +1197,8 @@ param_set_default_file(const char *filename)
 		param_default_file = strdup(filename);
 	}
 
+	param_journal_compact_required = true;
+
 #endif /* FLASH_BASED_PARAMS */
 
 	return 0;
@@ -1150,7 +1211,7 @@ const char *param_get_default_file()
 
 int param_set_backup_file(const char *filename)
 {
-	if (param_default_file && strcmp(filename, param_default_file) == 0) {
+	if (filename && param_default_file && strcmp(filename, param_default_file) == 0) {
 		PX4_ERR("backup file can't be the same as the default file %s", filename);
 		return PX4_ERROR;
 	}
@@ -1176,9 +1237,352 @@ const char *param_get_backup_file()
 	return param_backup_file;
 }
 
+/** CRC32 over the whole content of a file */
+static int param_fd_crc(int fd, uint32_t &crc)
+{
+	if (lseek(fd, 0, SEEK_SET) != 0) {
+		return PX4_ERROR;
+	}
+
+	uint8_t buffer[64];
+	ssize_t nread;
+	crc = 0;
+
+	while ((nread = ::read(fd, buffer, sizeof(buffer))) > 0) {
+		crc = crc32part(buffer, nread, crc);
+	}
+
+	return (nread < 0) ? PX4_ERROR : PX4_OK;
+}
+
+static int param_file_crc(const char *filename, uint32_t &crc)
+{
+	int fd = ::open(filename, O_RDONLY);
+
+	if (fd < 0) {
+		return PX4_ERROR;
+	}
+
+	int result = param_fd_crc(fd, crc);
+	::close(fd);
+
+	return result;
+}
+
+/**
+ * open the journal if it applies to the imported parameters, i.e. they were imported from the default
+ * file or from the backup written with it on the last compaction
+ * @param default_intact set to false if the default file does not match the journal anymore
+ * @return file descriptor positioned at the first record, -1 if there is no journal or it does not apply
+ */
+static int param_journal_open(bool &default_intact)
+{
+	int fd = ::open(param_journal_file, O_RDONLY);
+
+	if (fd < 0) {
+		return -1;
+	}
+
+	param_journal_header_s header{};
+
+	if ((::read(fd, &header, sizeof(header)) != (ssize_t)sizeof(header)) || (header.magic != PARAM_JOURNAL_MAGIC)
+	    || (param_import_crc == 0)
+	    || ((header.base_crc != param_import_crc) && (header.backup_crc != param_import_crc))) {
+
+		::close(fd);
+		return -1;
+	}
+
+	uint32_t crc = 0;
+	default_intact = param_default_file && (param_file_crc(param_default_file, crc) == PX4_OK) && (header.base_crc == crc);
+
+	return fd;
+}
+
+int param_set_journal_file(const char *filename)
+{
+	if (filename && ((param_default_file && strcmp(filename, param_default_file) == 0)
+			 || (param_backup_file && strcmp(filename, param_backup_file) == 0))) {
+		PX4_ERR("journal file can't be the same as the default or backup file %s", filename);
+		return PX4_ERROR;
+	}
+
+	if (param_journal_file != nullptr) {
+		// we assume this is not in use by some other thread
+		free(param_journal_file);
+		param_journal_file = nullptr;
+	}
+
+	param_journal_compact_required = true;
+
+	if (filename) {
+		param_journal_file = strdup(filename);
+
+		// keep appending to an existing journal, param_load_journal() checks its records
+		bool default_intact = false;
+		int fd = param_journal_open(default_intact);
+
+		if (fd >= 0) {
+			struct stat st {};
+
+			if (::fstat(fd, &st) == 0) {
+				param_journal_size = st.st_size;
+				param_journal_compact_required = !default_intact || (param_journal_size >= PARAM_JOURNAL_MAX_SIZE);
+			}
+
+			::close(fd);
+		}
+	}
+
+	return 0;
+}
+
+const char *param_get_journal_file()
+{
+	return param_journal_file;
+}
+
+/** start an empty journal for the current content of the default file, caller is responsible for locking */
+static int param_journal_reset()
+{
+	param_journal_header_s header{};
+	header.magic = PARAM_JOURNAL_MAGIC;
+
+	if (param_file_crc(param_default_file, header.base_crc) != PX4_OK) {
+		return PX4_ERROR;
+	}
+
+	if (param_backup_file && (param_file_crc(param_backup_file, header.backup_crc) != PX4_OK)) {
+		header.backup_crc = 0;
+	}
+
+	int fd = ::open(param_journal_file, O_WRONLY | O_CREAT | O_TRUNC, PX4_O_MODE_666);
+
+	if (fd < 0) {
+		PX4_ERR("open '%s' for writing failed (%d)", param_journal_file, errno);
+		return PX4_ERROR;
+	}
+
+	int result = PX4_ERROR;
+
+	if ((::write(fd, &header, sizeof(header)) == (ssize_t)sizeof(header)) && (::fsync(fd) == 0)) {
+		param_journal_size = sizeof(header);
+		param_journal_compact_required = false;
+		param_import_crc = header.base_crc; // the default file holds exactly the current parameters
+		result = PX4_OK;
+	}
+
+	::close(fd);
+
+	return result;
+}
+
+/** append all unsaved parameters to the journal, caller is responsible for locking */
+static int param_journal_append()
+{
+	int fd = ::open(param_journal_file, O_WRONLY | O_APPEND);
+
+	if (fd < 0) {
+		return PX4_ERROR;
+	}
+
+	uint8_t buffer[128];
+	size_t length = 0;
+	size_t written = 0;
+	int result = PX4_OK;
+
+	for (param_t param = 0; handle_in_range(param) && (result == PX4_OK); param++) {
+		if (!params_unsaved[param]) {
+			continue;
+		}
+
+		const char *name = param_name(param);
+		const size_t name_length = strnlen(name, PARAM_JOURNAL_NAME_MAX);
+		const size_t record_length = 2 + name_length + sizeof(int32_t) + sizeof(uint32_t);
+
+		if (length + record_length > sizeof(buffer)) {
+			if (::write(fd, buffer, length) != (ssize_t)length) {
+				result = PX4_ERROR;
+				break;
+			}
+
+			written += length;
+			length = 0;
+		}
+
+		const param_value_u *value = param_find_changed(param);
+		const int32_t raw_value = (value != nullptr) ? value->i : 0;
+
+		uint8_t *record = &buffer[length];
+		record[0] = (value != nullptr) ? param_type(param) : PARAM_JOURNAL_RESET;
+		record[1] = name_length;
+		memcpy(&record[2], name, name_length);
+		memcpy(&record[2 + name_length], &raw_value, sizeof(raw_value));
+		const uint32_t crc = crc32part(record, record_length - sizeof(uint32_t), 0);
+		memcpy(&record[record_length - sizeof(uint32_t)], &crc, sizeof(crc));
+		length += record_length;
+	}
+
+	if ((result == PX4_OK) && (length > 0)) {
+		if (::write(fd, buffer, length) != (ssize_t)length) {
+			result = PX4_ERROR;
+
+		} else {
+			written += length;
+		}
+	}
+
+	if ((result == PX4_OK) && (::fsync(fd) != 0)) {
+		result = PX4_ERROR;
+	}
+
+	::close(fd);
+
+	param_journal_size += written;
+
+	if (result != PX4_OK) {
+		// a partially written record would hide everything appended after it
+		param_journal_compact_required = true;
+	}
+
+	return result;
+}
+
+int param_load_journal()
+{
+	if (!param_journal_file || !param_default_file) {
+		return 0;
+	}
+
+	/* no journal is OK */
+	if (::access(param_journal_file, F_OK) != 0) {
+		param_journal_compact_required = true;
+		return 0;
+	}
+
+	bool default_intact = false;
+	int fd = param_journal_open(default_intact);
+
+	if (fd < 0) {
+		PX4_WARN("ignoring outdated parameter journal %s", param_journal_file);
+		param_journal_compact_required = true;
+		return 0;
+	}
+
+	if (!default_intact) {
+		// the parameters were imported from the backup, rewrite the default file on the next save
+		PX4_WARN("default file %s changed, applying parameter journal to the imported parameters", param_default_file);
+		param_journal_compact_required = true;
+	}
+
+	size_t journal_size = sizeof(param_journal_header_s);
+	int records = 0;
+	bool complete = false;
+
+	for (;;) {
+		uint8_t record[2 + PARAM_JOURNAL_NAME_MAX + sizeof(int32_t) + sizeof(uint32_t)];
+		const ssize_t nread = ::read(fd, record, 2);
+
+		if (nread == 0) {
+			complete = true;
+			break;
+		}
+
+		if ((nread != 2) || (record[1] == 0) || (record[1] > PARAM_JOURNAL_NAME_MAX)) {
+			break;
+		}
+
+		const size_t name_length = record[1];
+		const size_t record_length = 2 + name_length + sizeof(int32_t) + sizeof(uint32_t);
+
+		if (::read(fd, &record[2], record_length - 2) != (ssize_t)(record_length - 2)) {
+			break;
+		}
+
+		uint32_t crc;
+		memcpy(&crc, &record[record_length - sizeof(uint32_t)], sizeof(crc));
+
+		if (crc != crc32part(record, record_length - sizeof(uint32_t), 0)) {
+			break;
+		}
+
+		journal_size += record_length;
+
+		char name[PARAM_JOURNAL_NAME_MAX + 1] {};
+		memcpy(name, &record[2], name_length);
+		param_value_u value{};
+		memcpy(&value.i, &record[2 + name_length], sizeof(value.i));
+
+		const param_t param = param_find_no_notification(name);
+
+		if (param == PARAM_INVALID) {
+			PX4_WARN("ignoring unrecognised parameter '%s'", name);
+
+		} else if (record[0] == PARAM_JOURNAL_RESET) {
+			param_lock_writer();
+			param_values_write_begin();
+			params_changed.set(param, false);
+			param_values_write_end();
+			params_unsaved.set(param, false);
+			param_unlock_writer();
+			records++;
+
+		} else if (record[0] == param_type(param)) {
+			param_set_internal(param, &value, true, false);
+			records++;
+
+		} else {
+			PX4_WARN("unexpected type for %s", name);
+		}
+	}
+
+	::close(fd);
+
+	param_journal_size = journal_size;
+
+	if (!complete) {
+		// anything appended after a torn record would be lost, so rewrite everything on the next save
+		param_journal_compact_required = true;
+		PX4_WARN("parameter journal %s truncated after %d records", param_journal_file, records);
+	}
+
+	PX4_INFO("journal: applied %d parameter changes", records);
+
+	if (records > 0) {
+		param_notify_changes();
+	}
+
+	return 0;
+}
+
 static int param_export_internal(int fd, param_filter_func filter);
 static int param_verify(int fd);
 
+/** rewrite the backup file with all parameters, caller is responsible for locking */
+static void param_export_backup()
+{
+	if (!param_backup_file) {
+		return;
+	}
+
+	int fd_backup_file = ::open(param_backup_file, O_WRONLY | O_CREAT, PX4_O_MODE_666);
+
+	if (fd_backup_file > -1) {
+		int backup_export_ret = param_export_internal(fd_backup_file, nullptr);
+		::close(fd_backup_file);
+
+		if (backup_export_ret != 0) {
+			PX4_ERR("backup parameter export to %s failed (%d)", param_backup_file, backup_export_ret);
+
+		} else {
+			// verify export
+			int fd_verify = ::open(param_backup_file, O_RDONLY, PX4_O_MODE_666);
+			param_verify(fd_verify);
+			::close(fd_verify);
+		}
+	}
+}
+
 int param_save_default()
 {
 	PX4_DEBUG("param_save_default");
@@ -1194,9 +1598,28 @@ int param_save_default()
 	param_lock_reader();
 
 	int res = PX4_ERROR;
+	bool journal_saved = false;
 	const char *filename = param_get_default_file();
 
-	if (filename) {
+	if (filename && param_journal_file && !param_journal_compact_required
+	    && (param_journal_size < PARAM_JOURNAL_MAX_SIZE)) {
+
+		// only append the changes since the last save
+		perf_begin(param_export_perf);
+		res = param_journal_append();
+		perf_end(param_export_perf);
+
+		journal_saved = (res == PX4_OK);
+
+		if (!journal_saved) {
+			PX4_ERR("parameter journal append to %s failed, rewriting %s", param_journal_file, filename);
+		}
+	}
+
+	if (journal_saved) {
+		// nothing else to do
+
+	} else if (filename) {
 		static constexpr int MAX_ATTEMPTS = 3;
 
 		for (int attempt = 1; attempt <= MAX_ATTEMPTS; attempt++) {
@@ -1235,27 +1658,19 @@ int param_save_default()
 	if (res != PX4_OK) {
 		PX4_ERR("param export failed (%d)", res);
 
-	} else {
+	} else if (journal_saved) {
 		params_unsaved.reset();
 
-		// backup file
-		if (param_backup_file) {
-			int fd_backup_file = ::open(param_backup_file, O_WRONLY | O_CREAT, PX4_O_MODE_666);
-
-			if (fd_backup_file > -1) {
-				int backup_export_ret = param_export_internal(fd_backup_file, nullptr);
-				::close(fd_backup_file);
+	} else {
+		params_unsaved.reset();
 
-				if (backup_export_ret != 0) {
-					PX4_ERR("backup parameter export to %s failed (%d)", param_backup_file, backup_export_ret);
+		// the backup only changes with the default file, journaled changes are replayed on top of either
+		param_export_backup();
 
-				} else {
-					// verify export
-					int fd_verify = ::open(param_backup_file, O_RDONLY, PX4_O_MODE_666);
-					param_verify(fd_verify);
-					::close(fd_verify);
-				}
-			}
+		// the default file now holds everything, start over with an empty journal
+		if (filename && param_journal_file && (param_journal_reset() != PX4_OK)) {
+			PX4_ERR("parameter journal reset %s failed", param_journal_file);
+			param_journal_compact_required = true;
 		}
 	}
 
@@ -1302,6 +1717,10 @@ param_load_default()
 		return -2;
 	}
 
+	if (param_load_journal() != 0) {
+		return -2;
+	}
+
 	return res;
 }
 
@@ -1455,7 +1874,6 @@ static int param_export_internal(int fd, param_filter_func filter)
 	PX4_DEBUG("param_export_internal");
 
 	int result = -1;
-	param_wbuf_s *s = nullptr;
 	bson_encoder_s encoder{};
 	uint8_t bson_buffer[256];
 
@@ -1463,25 +1881,25 @@ static int param_export_internal(int fd, param_filter_func filter)
 		goto out;
 	}
 
-	// no modified parameters, export empty BSON document
-	if (param_values == nullptr) {
-		result = 0;
-		goto out;
-	}
+	for (param_t param = 0; param < param_info_count; param++) {
+		const param_value_u *s = param_find_changed(param);
+
+		if (s == nullptr) {
+			continue;
+		}
 
-	while ((s = (struct param_wbuf_s *)utarray_next(param_values, s)) != nullptr) {
-		if (filter && !filter(s->param)) {
+		if (filter && !filter(param)) {
 			continue;
 		}
 
 		// don't export default values
-		switch (param_type(s->param)) {
+		switch (param_type(param)) {
 		case PARAM_TYPE_INT32: {
 				int32_t default_value = 0;
-				param_get_default_value_internal(s->param, &default_value);
+				param_get_default_value_internal(param, &default_value);
 
-				if (s->val.i == default_value) {
-					PX4_DEBUG("skipping %s %" PRIi32 " export", param_name(s->param), default_value);
+				if (s->i == default_value) {
+					PX4_DEBUG("skipping %s %" PRIi32 " export", param_name(param), default_value);
 					continue;
 				}
 			}
@@ -1489,24 +1907,24 @@ static int param_export_internal(int fd, param_filter_func filter)
 
 		case PARAM_TYPE_FLOAT: {
 				float default_value = 0;
-				param_get_default_value_internal(s->param, &default_value);
+				param_get_default_value_internal(param, &default_value);
 
-				if (fabsf(s->val.f - default_value) <= FLT_EPSILON) {
-					PX4_DEBUG("skipping %s %.3f export", param_name(s->param), (double)default_value);
+				if (fabsf(s->f - default_value) <= FLT_EPSILON) {
+					PX4_DEBUG("skipping %s %.3f export", param_name(param), (double)default_value);
 					continue;
 				}
 			}
 			break;
 		}
 
-		const char *name = param_name(s->param);
-		const size_t size = param_size(s->param);
+		const char *name = param_name(param);
+		const size_t size = param_size(param);
 
 		/* append the appropriate BSON type object */
-		switch (param_type(s->param)) {
+		switch (param_type(param)) {
 		case PARAM_TYPE_INT32: {
-				const int32_t i = s->val.i;
-				PX4_DEBUG("exporting: %s (%d) size: %lu val: %" PRIi32, name, s->param, (long unsigned int)size, i);
+				const int32_t i = s->i;
+				PX4_DEBUG("exporting: %s (%d) size: %lu val: %" PRIi32, name, param, (long unsigned int)size, i);
 
 				if (bson_encoder_append_int32(&encoder, name, i) != 0) {
 					PX4_ERR("BSON append failed for '%s'", name);
@@ -1516,8 +1934,8 @@ static int param_export_internal(int fd, param_filter_func filter)
 			break;
 
 		case PARAM_TYPE_FLOAT: {
-				const double f = (double)s->val.f;
-				PX4_DEBUG("exporting: %s (%d) size: %lu val: %.3f", name, s->param, (long unsigned int)size, (double)f);
+				const double f = (double)s->f;
+				PX4_DEBUG("exporting: %s (%d) size: %lu val: %.3f", name, param, (long unsigned int)size, (double)f);
 
 				if (bson_encoder_append_double(&encoder, name, f) != 0) {
 					PX4_ERR("BSON append failed for '%s'", name);
@@ -1527,7 +1945,7 @@ static int param_export_internal(int fd, param_filter_func filter)
 			break;
 
 		default:
-			PX4_ERR("%s unrecognized parameter type %d, skipping export", name, param_type(s->param));
+			PX4_ERR("%s unrecognized parameter type %d, skipping export", name, param_type(param));
 		}
 	}
 
@@ -1638,6 +2056,10 @@ param_import_internal(int fd)
 {
 	static constexpr int MAX_ATTEMPTS = 3;
 
+	// imported values are marked as saved, but they are neither in the default file nor in the journal
+	param_journal_compact_required = true;
+	param_import_crc = 0;
+
 	for (int attempt = 1; attempt <= MAX_ATTEMPTS; attempt++) {
 		bson_decoder_s decoder{};
 
@@ -1655,6 +2077,11 @@ param_import_internal(int fd)
 						 decoder.total_document_size, decoder.total_decoded_size,
 						 decoder.count_node_int32, decoder.count_node_double);
 
+					// a journal applies to the parameters if it was started for this file
+					if (param_fd_crc(fd, param_import_crc) != PX4_OK) {
+						param_import_crc = 0;
+					}
+
 					return 0;
 
 				} else {
@@ -1804,12 +2231,15 @@ void param_print_status()
 		PX4_INFO("backup file: %s", param_backup_file);
 	}
 
+	if (param_journal_file) {
+		PX4_INFO("journal file: %s (%zu bytes%s)", param_journal_file, param_journal_size,
+			 param_journal_compact_required ? ", compaction pending" : "");
+	}
+
 #endif /* FLASH_BASED_PARAMS */
 
-	if (param_values != nullptr) {
-		PX4_INFO("storage array: %d/%d elements (%zu bytes total)",
-			 utarray_len(param_values), param_values->n, param_values->n * sizeof(UT_icd));
-	}
+	PX4_INFO("storage array: %zu/%d elements (%zu bytes total)",
+		 params_changed.count(), param_info_count, sizeof(param_values));
 
 	if (param_custom_default_values != nullptr) {
 		PX4_INFO("storage array (custom defaults): %d/%d elements (%zu bytes total)",
@@ -1826,5 +2256,6 @@ void param_print_status()
 	perf_print_counter(param_export_perf);
 	perf_print_counter(param_find_perf);
 	perf_print_counter(param_get_perf);
+	perf_print_counter(param_get_locked_perf);
 	perf_print_counter(param_set_perf);
 }
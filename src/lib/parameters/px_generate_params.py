@@ -20,6 +20,73 @@ except ImportError as e:
 
 import os
 
+def name_hash(name, seed):
+    """
+    32 bit FNV-1a hash of name with a seeded offset basis, followed by the
+    murmur3 finalizer. Must match px4::param_name_hash() in px4_parameters.hpp.
+    """
+    h = (0x811c9dc5 ^ seed) & 0xffffffff
+    for c in name.encode('ascii'):
+        h ^= c
+        h = (h * 0x01000193) & 0xffffffff
+    h ^= h >> 16
+    h = (h * 0x85ebca6b) & 0xffffffff
+    h ^= h >> 13
+    h = (h * 0xc2b2ae35) & 0xffffffff
+    h ^= h >> 16
+    return h
+
+def perfect_hash(names):
+    """
+    Build a minimal perfect hash (hash and displace) over the parameter names.
+
+    A name is first assigned to the bucket name_hash(name, 0) % len(displacements).
+    For a displacement d >= 0 its slot is name_hash(name, d) % len(names), a negative
+    displacement directly encodes the slot (-d - 1) of a bucket holding a single name.
+
+    @return: (displacements, index) where index maps each slot to the position of the
+             name in names
+    """
+    num_slots = len(names)
+    num_buckets = max(1, (num_slots + 1) // 2)
+
+    buckets = [[] for _ in range(num_buckets)]
+    for i, name in enumerate(names):
+        buckets[name_hash(name, 0) % num_buckets].append(i)
+
+    displacements = [0] * num_buckets
+    index = [None] * num_slots
+
+    # place the largest buckets first, while most slots are still free
+    order = sorted(range(num_buckets), key=lambda b: len(buckets[b]), reverse=True)
+    free_slots = None
+
+    for b in order:
+        bucket = buckets[b]
+        if len(bucket) == 0:
+            break
+
+        if len(bucket) == 1:
+            if free_slots is None:
+                free_slots = [s for s in range(num_slots) if index[s] is None]
+            slot = free_slots.pop()
+            index[slot] = bucket[0]
+            displacements[b] = -slot - 1
+            continue
+
+        for d in range(1, 0x7fff):
+            slots = [name_hash(names[i], d) % num_slots for i in bucket]
+            if len(set(slots)) == len(slots) and all(index[s] is None for s in slots):
+                break
+        else:
+            raise Exception('failed to find a perfect hash displacement')
+
+        for i, s in zip(bucket, slots):
+            index[s] = i
+        displacements[b] = d
+
+    return displacements, index
+
 def generate(xml_file, dest='.'):
     """
     Generate px4 param source from xml.
@@ -40,6 +107,8 @@ def generate(xml_file, dest='.'):
 
     params = sorted(params, key=lambda name: name.attrib["name"])
 
+    hash_displacements, hash_index = perfect_hash([p.attrib["name"] for p in params])
+
     script_path = os.path.dirname(os.path.realpath(__file__))
 
     # for jinja docs see: http://jinja.pocoo.org/docs/2.9/api/
@@ -56,7 +125,9 @@ def generate(xml_file, dest='.'):
         template = env.get_template(template_file)
         with open(os.path.join(
                 dest, template_file.replace('.jinja','')), 'w') as fid:
-            fid.write(template.render(params=params))
+            fid.write(template.render(params=params,
+                                        hash_displacements=hash_displacements,
+                                        hash_index=hash_index))
 
 if __name__ == "__main__":
     arg_parser = argparse.ArgumentParser()
@@ -41,55 +41,139 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <new>
 #include <sys/queue.h>
 #include <drivers/drv_hrt.h>
 #include <math.h>
 #include <pthread.h>
+#include <px4_platform_common/atomic.h>
 #include <systemlib/err.h>
 
 #include "perf_counter.h"
 
+#if defined(__PX4_POSIX)
+/*
+ * On (multi-core) POSIX targets counters are split into cache line aligned shards,
+ * threads are assigned to a shard round-robin. Updates only touch the shard of the
+ * calling thread, and the shards are summed up when the counter is read.
+ */
+# define PERF_SHARDS		8
+# define PERF_CACHE_LINE	64
+# define PERF_SHARD_ALIGN	alignas(PERF_CACHE_LINE)
+
+template<typename T>
+using perf_field = px4::atomic<T>;
+
+#else
+# define PERF_SHARDS		1
+# define PERF_SHARD_ALIGN
+
+/**
+ * Plain counter field on NuttX: 64 bit atomics would need a critical section for
+ * every update, and lost updates under contention are acceptable for statistics.
+ */
+template<typename T>
+class perf_field
+{
+public:
+	perf_field(T value) : _value(value) {}
+
+	T load() const { return _value; }
+	void store(T value) { _value = value; }
+
+	T fetch_add(T num)
+	{
+		const T ret = _value;
+		_value += num;
+		return ret;
+	}
+
+	bool compare_exchange(T *expected, T desired)
+	{
+		if (_value == *expected) {
+			_value = desired;
+			return true;
+		}
+
+		*expected = _value;
+		return false;
+	}
+
+private:
+	T _value;
+};
+#endif
+
+/**
+ * Number of hash buckets used to look up counters by name (power of 2).
+ */
+static constexpr unsigned PERF_HASH_BUCKETS = 64;
+
 /**
  * Header common to all counters.
  */
 struct perf_ctr_header {
-	sq_entry_t		link;	/**< list linkage */
-	enum perf_counter_type	type;	/**< counter type */
-	const char		*name;	/**< counter name */
+	sq_entry_t		link;		/**< list linkage */
+	perf_ctr_header		*hash_next;	/**< hash bucket linkage */
+	enum perf_counter_type	type;		/**< counter type */
+	const char		*name;		/**< counter name */
+};
+
+/**
+ * PC_EVENT counter shard.
+ */
+struct PERF_SHARD_ALIGN perf_count_shard {
+	perf_field<uint64_t>	event_count{0};
 };
 
 /**
  * PC_EVENT counter.
  */
 struct perf_ctr_count : public perf_ctr_header {
-	uint64_t		event_count{0};
+	perf_count_shard	shards[PERF_SHARDS];
+};
+
+/**
+ * PC_ELAPSED counter shard.
+ */
+struct PERF_SHARD_ALIGN perf_elapsed_shard {
+	perf_field<uint64_t>	event_count{0};
+	perf_field<uint64_t>	time_start{0};
+	perf_field<uint64_t>	time_total{0};
+	perf_field<uint64_t>	time_squared{0};	/**< sum of the squared elapsed times (us^2) */
+	perf_field<uint32_t>	time_least{0};
+	perf_field<uint32_t>	time_most{0};
 };
 
 /**
  * PC_ELAPSED counter.
  */
 struct perf_ctr_elapsed : public perf_ctr_header {
-	uint64_t		event_count{0};
-	uint64_t		time_start{0};
-	uint64_t		time_total{0};
-	uint32_t		time_least{0};
-	uint32_t		time_most{0};
-	float			mean{0.0f};
-	float			M2{0.0f};
+	perf_elapsed_shard	shards[PERF_SHARDS];
 };
 
 /**
- * PC_INTERVAL counter.
+ * PC_INTERVAL counter. Not sharded, as the interval is measured between consecutive
+ * events of all threads.
  */
 struct perf_ctr_interval : public perf_ctr_header {
+	perf_field<uint64_t>	event_count{0};
+	perf_field<uint64_t>	time_first{0};
+	perf_field<uint64_t>	time_last{0};
+	perf_field<uint64_t>	time_squared{0};	/**< sum of the squared intervals (us^2) */
+	perf_field<uint32_t>	time_least{0};
+	perf_field<uint32_t>	time_most{0};
+};
+
+/**
+ * Statistics of a PC_ELAPSED counter summed up over all shards.
+ */
+struct perf_elapsed_stats {
 	uint64_t		event_count{0};
-	uint64_t		time_event{0};
-	uint64_t		time_first{0};
-	uint64_t		time_last{0};
+	uint64_t		time_total{0};
+	uint64_t		time_squared{0};
 	uint32_t		time_least{0};
 	uint32_t		time_most{0};
-	float			mean{0.0f};
-	float			M2{0.0f};
 };
 
 /**
@@ -97,34 +181,134 @@ struct perf_ctr_interval : public perf_ctr_header {
  */
 static sq_queue_t	perf_counters = { nullptr, nullptr };
 
+/**
+ * Counters by name hash (for perf_alloc_once).
+ */
+static perf_counter_t	perf_counters_hash[PERF_HASH_BUCKETS] {};
+
 /**
  * mutex protecting access to the perf_counters linked list (which is read from & written to by different threads)
  */
 pthread_mutex_t perf_counters_mutex = PTHREAD_MUTEX_INITIALIZER;
-// FIXME: the mutex does **not** protect against access to/from the perf
-// counter's data. It can still happen that a counter is updated while it is
-// printed. This can lead to inconsistent output, or completely bogus values
-// (especially the 64bit values which are in general not atomically updated).
-// The same holds for shared perf counters (perf_alloc_once), that can be updated
-// concurrently (this affects the 'ctrl_latency' counter).
+// NOTE: the mutex does not protect the counter's data. All fields are updated
+// atomically on POSIX, but a counter can still be updated while it is printed, so the
+// printed fields might be from slightly different points in time.
 
+static inline unsigned perf_shard()
+{
+#if PERF_SHARDS > 1
+	static px4::atomic<unsigned> next_shard{0};
+	static thread_local unsigned shard = next_shard.fetch_add(1) % PERF_SHARDS;
+	return shard;
+#else
+	return 0;
+#endif
+}
 
-perf_counter_t
-perf_alloc(enum perf_counter_type type, const char *name)
+static unsigned perf_hash(const char *name)
+{
+	// FNV-1a
+	uint32_t hash = 2166136261u;
+
+	for (const char *c = name; *c != '\0'; c++) {
+		hash = (hash ^ (uint8_t)*c) * 16777619u;
+	}
+
+	return hash & (PERF_HASH_BUCKETS - 1);
+}
+
+static inline void atomic_min_nonzero(perf_field<uint32_t> &value, uint32_t sample)
+{
+	uint32_t current = value.load();
+
+	while (((current == 0) || (sample < current)) && !value.compare_exchange(&current, sample)) {}
+}
+
+static inline void atomic_max(perf_field<uint32_t> &value, uint32_t sample)
+{
+	uint32_t current = value.load();
+
+	while ((sample > current) && !value.compare_exchange(&current, sample)) {}
+}
+
+/**
+ * Standard deviation (us) from the number of samples, their sum and the sum of their squares.
+ */
+static float perf_rms(uint64_t count, uint64_t sum, uint64_t sum_squared)
+{
+	if (count < 2) {
+		return 0.f;
+	}
+
+	const double variance = ((double)sum_squared - (double)sum * (double)sum / count) / (count - 1);
+	return (variance > 0.) ? (float)sqrt(variance) : 0.f;
+}
+
+static void perf_elapsed_aggregate(const perf_ctr_elapsed *pce, perf_elapsed_stats &stats)
+{
+	for (const perf_elapsed_shard &shard : pce->shards) {
+		stats.event_count += shard.event_count.load();
+		stats.time_total += shard.time_total.load();
+		stats.time_squared += shard.time_squared.load();
+
+		const uint32_t least = shard.time_least.load();
+
+		if ((least != 0) && ((stats.time_least == 0) || (least < stats.time_least))) {
+			stats.time_least = least;
+		}
+
+		const uint32_t most = shard.time_most.load();
+
+		if (most > stats.time_most) {
+			stats.time_most = most;
+		}
+	}
+}
+
+static uint64_t perf_count_aggregate(const perf_ctr_count *pcc)
+{
+	uint64_t event_count = 0;
+
+	for (const perf_count_shard &shard : pcc->shards) {
+		event_count += shard.event_count.load();
+	}
+
+	return event_count;
+}
+
+template<typename T>
+static T *perf_new()
+{
+	void *mem = nullptr;
+#if defined(__PX4_POSIX)
+
+	if (posix_memalign(&mem, PERF_CACHE_LINE, sizeof(T)) != 0) {
+		mem = nullptr;
+	}
+
+#else
+	mem = malloc(sizeof(T));
+#endif
+
+	return (mem != nullptr) ? new (mem) T() : nullptr;
+}
+
+static perf_counter_t
+perf_alloc_locked(enum perf_counter_type type, const char *name)
 {
 	perf_counter_t ctr = nullptr;
 
 	switch (type) {
 	case PC_COUNT:
-		ctr = new perf_ctr_count();
+		ctr = perf_new<perf_ctr_count>();
 		break;
 
 	case PC_ELAPSED:
-		ctr = new perf_ctr_elapsed();
+		ctr = perf_new<perf_ctr_elapsed>();
 		break;
 
 	case PC_INTERVAL:
-		ctr = new perf_ctr_interval();
+		ctr = perf_new<perf_ctr_interval>();
 		break;
 
 	default:
@@ -134,41 +318,53 @@ perf_alloc(enum perf_counter_type type, const char *name)
 	if (ctr != nullptr) {
 		ctr->type = type;
 		ctr->name = name;
-		pthread_mutex_lock(&perf_counters_mutex);
 		sq_addfirst(&ctr->link, &perf_counters);
-		pthread_mutex_unlock(&perf_counters_mutex);
+
+		perf_counter_t &bucket = perf_counters_hash[perf_hash(name)];
+		ctr->hash_next = bucket;
+		bucket = ctr;
 	}
 
 	return ctr;
 }
 
+perf_counter_t
+perf_alloc(enum perf_counter_type type, const char *name)
+{
+	pthread_mutex_lock(&perf_counters_mutex);
+	perf_counter_t ctr = perf_alloc_locked(type, name);
+	pthread_mutex_unlock(&perf_counters_mutex);
+
+	return ctr;
+}
+
 perf_counter_t
 perf_alloc_once(enum perf_counter_type type, const char *name)
 {
 	pthread_mutex_lock(&perf_counters_mutex);
-	perf_counter_t handle = (perf_counter_t)sq_peek(&perf_counters);
+	perf_counter_t handle = perf_counters_hash[perf_hash(name)];
 
 	while (handle != nullptr) {
 		if (!strcmp(handle->name, name)) {
-			if (type == handle->type) {
-				/* they are the same counter */
-				pthread_mutex_unlock(&perf_counters_mutex);
-				return handle;
-
-			} else {
+			if (type != handle->type) {
 				/* same name but different type, assuming this is an error and not intended */
-				pthread_mutex_unlock(&perf_counters_mutex);
-				return nullptr;
+				handle = nullptr;
 			}
+
+			/* they are the same counter */
+			pthread_mutex_unlock(&perf_counters_mutex);
+			return handle;
 		}
 
-		handle = (perf_counter_t)sq_next(&handle->link);
+		handle = handle->hash_next;
 	}
 
+	/* no existing counter of that name was found */
+	handle = perf_alloc_locked(type, name);
+
 	pthread_mutex_unlock(&perf_counters_mutex);
 
-	/* if the execution reaches here, no existing counter of that name was found */
-	return perf_alloc(type, name);
+	return handle;
 }
 
 void
@@ -180,9 +376,19 @@ perf_free(perf_counter_t handle)
 
 	pthread_mutex_lock(&perf_counters_mutex);
 	sq_rem(&handle->link, &perf_counters);
+
+	for (perf_counter_t *entry = &perf_counters_hash[perf_hash(handle->name)]; *entry != nullptr;
+	     entry = &(*entry)->hash_next) {
+		if (*entry == handle) {
+			*entry = handle->hash_next;
+			break;
+		}
+	}
+
 	pthread_mutex_unlock(&perf_counters_mutex);
 
-	delete handle;
+	// all counter types are trivially destructible
+	free(handle);
 }
 
 void
@@ -194,7 +400,7 @@ perf_count(perf_counter_t handle)
 
 	switch (handle->type) {
 	case PC_COUNT:
-		((struct perf_ctr_count *)handle)->event_count++;
+		((struct perf_ctr_count *)handle)->shards[perf_shard()].event_count.fetch_add(1);
 		break;
 
 	case PC_INTERVAL:
@@ -215,7 +421,7 @@ perf_begin(perf_counter_t handle)
 
 	switch (handle->type) {
 	case PC_ELAPSED:
-		((struct perf_ctr_elapsed *)handle)->time_start = hrt_absolute_time();
+		((struct perf_ctr_elapsed *)handle)->shards[perf_shard()].time_start.store(hrt_absolute_time());
 		break;
 
 	default:
@@ -233,9 +439,10 @@ perf_end(perf_counter_t handle)
 	switch (handle->type) {
 	case PC_ELAPSED: {
 			struct perf_ctr_elapsed *pce = (struct perf_ctr_elapsed *)handle;
+			const hrt_abstime time_start = pce->shards[perf_shard()].time_start.load();
 
-			if (pce->time_start != 0) {
-				perf_set_elapsed(handle, hrt_elapsed_time(&pce->time_start));
+			if (time_start != 0) {
+				perf_set_elapsed(handle, hrt_elapsed_time(&time_start));
 			}
 		}
 		break;
@@ -254,28 +461,17 @@ perf_set_elapsed(perf_counter_t handle, int64_t elapsed)
 
 	switch (handle->type) {
 	case PC_ELAPSED: {
-			struct perf_ctr_elapsed *pce = (struct perf_ctr_elapsed *)handle;
+			perf_elapsed_shard &shard = ((struct perf_ctr_elapsed *)handle)->shards[perf_shard()];
 
 			if (elapsed >= 0) {
-				pce->event_count++;
-				pce->time_total += elapsed;
+				shard.event_count.fetch_add(1);
+				shard.time_total.fetch_add(elapsed);
+				shard.time_squared.fetch_add((uint64_t)elapsed * (uint64_t)elapsed);
 
-				if ((pce->time_least > (uint32_t)elapsed) || (pce->time_least == 0)) {
-					pce->time_least = elapsed;
-				}
+				atomic_min_nonzero(shard.time_least, (uint32_t)elapsed);
+				atomic_max(shard.time_most, (uint32_t)elapsed);
 
-				if (pce->time_most < (uint32_t)elapsed) {
-					pce->time_most = elapsed;
-				}
-
-				// maintain mean and variance of the elapsed time in seconds
-				// Knuth/Welford recursive mean and variance of update intervals (via Wikipedia)
-				float dt = elapsed / 1e6f;
-				float delta_intvl = dt - pce->mean;
-				pce->mean += delta_intvl / pce->event_count;
-				pce->M2 += delta_intvl * (dt - pce->mean);
-
-				pce->time_start = 0;
+				shard.time_start.store(0);
 			}
 		}
 		break;
@@ -296,41 +492,22 @@ perf_count_interval(perf_counter_t handle, hrt_abstime now)
 	case PC_INTERVAL: {
 			struct perf_ctr_interval *pci = (struct perf_ctr_interval *)handle;
 
-			switch (pci->event_count) {
-			case 0:
-				pci->time_first = now;
-				break;
-
-			case 1:
-				pci->time_least = (uint32_t)(now - pci->time_last);
-				pci->time_most = (uint32_t)(now - pci->time_last);
-				pci->mean = pci->time_least / 1e6f;
-				pci->M2 = 0;
-				break;
-
-			default: {
-					hrt_abstime interval = now - pci->time_last;
-
-					if ((uint32_t)interval < pci->time_least) {
-						pci->time_least = (uint32_t)interval;
-					}
-
-					if ((uint32_t)interval > pci->time_most) {
-						pci->time_most = (uint32_t)interval;
-					}
-
-					// maintain mean and variance of interval in seconds
-					// Knuth/Welford recursive mean and variance of update intervals (via Wikipedia)
-					float dt = interval / 1e6f;
-					float delta_intvl = dt - pci->mean;
-					pci->mean += delta_intvl / pci->event_count;
-					pci->M2 += delta_intvl * (dt - pci->mean);
-					break;
-				}
+			hrt_abstime time_last = pci->time_last.load();
+
+			while (!pci->time_last.compare_exchange(&time_last, now)) {}
+
+			if (pci->event_count.fetch_add(1) == 0) {
+				pci->time_first.store(now);
+
+			} else if (now >= time_last) {
+				const hrt_abstime interval = now - time_last;
+
+				pci->time_squared.fetch_add(interval * interval);
+
+				atomic_min_nonzero(pci->time_least, (uint32_t)interval);
+				atomic_max(pci->time_most, (uint32_t)interval);
 			}
 
-			pci->time_last = now;
-			pci->event_count++;
 			break;
 		}
 
@@ -348,7 +525,11 @@ perf_set_count(perf_counter_t handle, uint64_t count)
 
 	switch (handle->type) {
 	case PC_COUNT: {
-			((struct perf_ctr_count *)handle)->event_count = count;
+			struct perf_ctr_count *pcc = (struct perf_ctr_count *)handle;
+
+			for (unsigned i = 0; i < PERF_SHARDS; i++) {
+				pcc->shards[i].event_count.store((i == 0) ? count : 0);
+			}
 		}
 		break;
 
@@ -369,7 +550,7 @@ perf_cancel(perf_counter_t handle)
 	case PC_ELAPSED: {
 			struct perf_ctr_elapsed *pce = (struct perf_ctr_elapsed *)handle;
 
-			pce->time_start = 0;
+			pce->shards[perf_shard()].time_start.store(0);
 		}
 		break;
 
@@ -387,27 +568,32 @@ perf_reset(perf_counter_t handle)
 
 	switch (handle->type) {
 	case PC_COUNT:
-		((struct perf_ctr_count *)handle)->event_count = 0;
+		perf_set_count(handle, 0);
 		break;
 
 	case PC_ELAPSED: {
 			struct perf_ctr_elapsed *pce = (struct perf_ctr_elapsed *)handle;
-			pce->event_count = 0;
-			pce->time_start = 0;
-			pce->time_total = 0;
-			pce->time_least = 0;
-			pce->time_most = 0;
+
+			for (perf_elapsed_shard &shard : pce->shards) {
+				shard.event_count.store(0);
+				shard.time_start.store(0);
+				shard.time_total.store(0);
+				shard.time_squared.store(0);
+				shard.time_least.store(0);
+				shard.time_most.store(0);
+			}
+
 			break;
 		}
 
 	case PC_INTERVAL: {
 			struct perf_ctr_interval *pci = (struct perf_ctr_interval *)handle;
-			pci->event_count = 0;
-			pci->time_event = 0;
-			pci->time_first = 0;
-			pci->time_last = 0;
-			pci->time_least = 0;
-			pci->time_most = 0;
+			pci->event_count.store(0);
+			pci->time_first.store(0);
+			pci->time_last.store(0);
+			pci->time_squared.store(0);
+			pci->time_least.store(0);
+			pci->time_most.store(0);
 			break;
 		}
 	}
@@ -430,44 +616,10 @@ perf_print_counter_fd(int fd, perf_counter_t handle)
 		return;
 	}
 
-	switch (handle->type) {
-	case PC_COUNT:
-		dprintf(fd, "%s: %" PRIu64 " events\n",
-			handle->name,
-			((struct perf_ctr_count *)handle)->event_count);
-		break;
+	char buffer[256];
 
-	case PC_ELAPSED: {
-			struct perf_ctr_elapsed *pce = (struct perf_ctr_elapsed *)handle;
-			float rms = sqrtf(pce->M2 / (pce->event_count - 1));
-			dprintf(fd, "%s: %" PRIu64 " events, %" PRIu64 "us elapsed, %.2fus avg, min %" PRIu32 "us max %" PRIu32
-				"us %5.3fus rms\n",
-				handle->name,
-				pce->event_count,
-				pce->time_total,
-				(pce->event_count == 0) ? 0 : (double)pce->time_total / (double)pce->event_count,
-				pce->time_least,
-				pce->time_most,
-				(double)(1e6f * rms));
-			break;
-		}
-
-	case PC_INTERVAL: {
-			struct perf_ctr_interval *pci = (struct perf_ctr_interval *)handle;
-			float rms = sqrtf(pci->M2 / (pci->event_count - 1));
-
-			dprintf(fd, "%s: %" PRIu64 " events, %.2fus avg, min %" PRIu32 "us max %" PRIu32 "us %5.3fus rms\n",
-				handle->name,
-				pci->event_count,
-				(pci->event_count == 0) ? 0 : (double)(pci->time_last - pci->time_first) / (double)pci->event_count,
-				pci->time_least,
-				pci->time_most,
-				(double)(1e6f * rms));
-			break;
-		}
-
-	default:
-		break;
+	if (perf_print_counter_buffer(buffer, sizeof(buffer), handle) > 0) {
+		dprintf(fd, "%s\n", buffer);
 	}
 }
 
@@ -485,36 +637,37 @@ perf_print_counter_buffer(char *buffer, int length, perf_counter_t handle)
 	case PC_COUNT:
 		num_written = snprintf(buffer, length, "%s: %" PRIu64 " events",
 				       handle->name,
-				       ((struct perf_ctr_count *)handle)->event_count);
+				       perf_count_aggregate((struct perf_ctr_count *)handle));
 		break;
 
 	case PC_ELAPSED: {
-			struct perf_ctr_elapsed *pce = (struct perf_ctr_elapsed *)handle;
-			float rms = sqrtf(pce->M2 / (pce->event_count - 1));
+			perf_elapsed_stats stats;
+			perf_elapsed_aggregate((struct perf_ctr_elapsed *)handle, stats);
 			num_written = snprintf(buffer, length,
 					       "%s: %" PRIu64 " events, %" PRIu64 "us elapsed, %.2fus avg, min %" PRIu32 "us max %" PRIu32 "us %5.3fus rms",
 					       handle->name,
-					       pce->event_count,
-					       pce->time_total,
-					       (pce->event_count == 0) ? 0 : (double)pce->time_total / (double)pce->event_count,
-					       pce->time_least,
-					       pce->time_most,
-					       (double)(1e6f * rms));
+					       stats.event_count,
+					       stats.time_total,
+					       (stats.event_count == 0) ? 0 : (double)stats.time_total / (double)stats.event_count,
+					       stats.time_least,
+					       stats.time_most,
+					       (double)perf_rms(stats.event_count, stats.time_total, stats.time_squared));
 			break;
 		}
 
 	case PC_INTERVAL: {
 			struct perf_ctr_interval *pci = (struct perf_ctr_interval *)handle;
-			float rms = sqrtf(pci->M2 / (pci->event_count - 1));
+			const uint64_t event_count = pci->event_count.load();
+			const uint64_t time_span = pci->time_last.load() - pci->time_first.load();
 
 			num_written = snprintf(buffer, length,
-					       "%s: %" PRIu64 " events, %.2f avg, min %" PRIu32 "us max %" PRIu32 "us %5.3fus rms",
+					       "%s: %" PRIu64 " events, %.2fus avg, min %" PRIu32 "us max %" PRIu32 "us %5.3fus rms",
 					       handle->name,
-					       pci->event_count,
-					       (pci->event_count == 0) ? 0 : (double)(pci->time_last - pci->time_first) / (double)pci->event_count,
-					       pci->time_least,
-					       pci->time_most,
-					       (double)(1e6f * rms));
+					       event_count,
+					       (event_count == 0) ? 0 : (double)time_span / (double)event_count,
+					       pci->time_least.load(),
+					       pci->time_most.load(),
+					       (double)perf_rms((event_count > 0) ? event_count - 1 : 0, time_span, pci->time_squared.load()));
 			break;
 		}
 
@@ -535,16 +688,17 @@ perf_event_count(perf_counter_t handle)
 
 	switch (handle->type) {
 	case PC_COUNT:
-		return ((struct perf_ctr_count *)handle)->event_count;
+		return perf_count_aggregate((struct perf_ctr_count *)handle);
 
 	case PC_ELAPSED: {
-			struct perf_ctr_elapsed *pce = (struct perf_ctr_elapsed *)handle;
-			return pce->event_count;
+			perf_elapsed_stats stats;
+			perf_elapsed_aggregate((struct perf_ctr_elapsed *)handle, stats);
+			return stats.event_count;
 		}
 
 	case PC_INTERVAL: {
 			struct perf_ctr_interval *pci = (struct perf_ctr_interval *)handle;
-			return pci->event_count;
+			return pci->event_count.load();
 		}
 
 	default:
@@ -563,13 +717,16 @@ perf_mean(perf_counter_t handle)
 
 	switch (handle->type) {
 	case PC_ELAPSED: {
-			struct perf_ctr_elapsed *pce = (struct perf_ctr_elapsed *)handle;
-			return pce->mean;
+			perf_elapsed_stats stats;
+			perf_elapsed_aggregate((struct perf_ctr_elapsed *)handle, stats);
+			return (stats.event_count > 0) ? stats.time_total / 1e6f / stats.event_count : 0.f;
 		}
 
 	case PC_INTERVAL: {
 			struct perf_ctr_interval *pci = (struct perf_ctr_interval *)handle;
-			return pci->mean;
+			const uint64_t event_count = pci->event_count.load();
+			const uint64_t time_span = pci->time_last.load() - pci->time_first.load();
+			return (event_count > 1) ? time_span / 1e6f / (event_count - 1) : 0.f;
 		}
 
 	default:
@@ -0,0 +1,291 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file UlogCompressionTest.cpp
+ * Tests for the framed ULog compression.
+ */
+
+#include <gtest/gtest.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <vector>
+
+#include "ulog_compression.h"
+
+using namespace ulog_compression;
+
+// log-like data: repeated records with slowly changing fields
+static std::vector<uint8_t> generate_data(size_t size)
+{
+	std::vector<uint8_t> data(size);
+	uint32_t state = 1;
+
+	for (size_t i = 0; i < size; ++i) {
+		state = state * 1103515245u + 12345u;
+		data[i] = (i % 48 < 24) ? (uint8_t)(i / 48) : (uint8_t)(state >> 24);
+	}
+
+	return data;
+}
+
+TEST(UlogCompression, crc32)
+{
+	EXPECT_EQ(crc32(0, "123456789", 9), 0xcbf43926u);
+	EXPECT_EQ(crc32(crc32(0, "12345", 5), "6789", 4), 0xcbf43926u);
+}
+
+TEST(UlogCompression, lz4_roundtrip)
+{
+	std::vector<uint16_t> hash_table(HASH_TABLE_SIZE);
+
+	for (size_t size : {1, 12, 13, 100, 4096, (int)FRAME_SIZE_DEFAULT, (int)FRAME_SIZE_MAX}) {
+		// GIVEN: compressible input data
+		const std::vector<uint8_t> input = generate_data(size);
+		std::vector<uint8_t> compressed(lz4_compress_bound(size));
+
+		// WHEN: it is compressed and decompressed
+		const size_t compressed_size = lz4_compress(input.data(), size, compressed.data(), compressed.size(), hash_table.data());
+		std::vector<uint8_t> output(size + 1);
+		const int output_size = lz4_decompress(compressed.data(), compressed_size, output.data(), output.size());
+
+		// THEN: the data is restored
+		ASSERT_GT(compressed_size, 0u);
+		ASSERT_EQ(output_size, (int)size);
+		EXPECT_EQ(memcmp(input.data(), output.data(), size), 0);
+
+		if (size >= 4096) {
+			EXPECT_LT(compressed_size, size * 3 / 4);
+		}
+	}
+}
+
+TEST(UlogCompression, lz4_malformed_input)
+{
+	uint8_t output[64];
+
+	// match offset pointing before the start of the output
+	const uint8_t bad_offset[] = {0x10, 'a', 0x05, 0x00};
+	EXPECT_EQ(lz4_decompress(bad_offset, sizeof(bad_offset), output, sizeof(output)), -1);
+
+	// literal length exceeding the input
+	const uint8_t truncated[] = {0xf0, 0x10, 'a'};
+	EXPECT_EQ(lz4_decompress(truncated, sizeof(truncated), output, sizeof(output)), -1);
+}
+
+TEST(UlogCompression, file_recovery)
+{
+	char in_file_name[] = "/tmp/ulog_compression_test_XXXXXX";
+	const int fd = mkstemp(in_file_name);
+	ASSERT_GE(fd, 0);
+	FILE *file = fdopen(fd, "wb");
+	ASSERT_NE(file, nullptr);
+
+	// GIVEN: a compressed file where the second of 4 frames is corrupted, and the last one is truncated
+	const std::vector<uint8_t> input = generate_data(4 * FRAME_SIZE_DEFAULT);
+	Encoder encoder;
+	ASSERT_TRUE(encoder.init());
+
+	file_header_s file_header;
+	encoder.fill_file_header(file_header, 1234);
+	fwrite(&file_header, sizeof(file_header), 1, file);
+
+	for (int frame = 0; frame < 4; ++frame) {
+		EXPECT_EQ(encoder.append(&input[frame * FRAME_SIZE_DEFAULT], FRAME_SIZE_DEFAULT), FRAME_SIZE_DEFAULT);
+		EXPECT_TRUE(encoder.full());
+
+		size_t length;
+		uint8_t *data = const_cast<uint8_t *>(encoder.encode(length));
+
+		if (frame == 1) {
+			data[length / 2] ^= 0x55;
+		}
+
+		if (frame == 3) {
+			length -= 10;
+		}
+
+		fwrite(data, 1, length, file);
+	}
+
+	fclose(file);
+	EXPECT_EQ(encoder.raw_bytes(), input.size());
+	EXPECT_LT(encoder.encoded_bytes(), input.size());
+
+	// WHEN: decompressing it
+	ASSERT_TRUE(is_compressed_file(in_file_name));
+	const std::string out_file_name = std::string(in_file_name) + ".ulg";
+	const int skipped = decompress_file(in_file_name, out_file_name.c_str());
+
+	// THEN: frames 0 and 2 are recovered
+	EXPECT_EQ(skipped, 2);
+
+	file = fopen(out_file_name.c_str(), "rb");
+	ASSERT_NE(file, nullptr);
+	std::vector<uint8_t> output(input.size());
+	EXPECT_EQ(fread(output.data(), 1, output.size(), file), 2 * FRAME_SIZE_DEFAULT);
+	fclose(file);
+
+	EXPECT_EQ(memcmp(output.data(), &input[0], FRAME_SIZE_DEFAULT), 0);
+	EXPECT_EQ(memcmp(output.data() + FRAME_SIZE_DEFAULT, &input[2 * FRAME_SIZE_DEFAULT], FRAME_SIZE_DEFAULT), 0);
+
+	EXPECT_FALSE(is_compressed_file(out_file_name.c_str()));
+
+	unlink(in_file_name);
+	unlink(out_file_name.c_str());
+}
+
+struct FailingOutput {
+	std::vector<uint8_t> data;
+	int calls{0};
+	int fail_call{-1}; ///< this call fails
+	int partial_call{-1}; ///< this call only writes half of the buffer
+};
+
+static ssize_t failing_output_write(void *context, const void *buffer, size_t size)
+{
+	FailingOutput *output = static_cast<FailingOutput *>(context);
+	const int call = output->calls++;
+
+	if (call == output->fail_call) {
+		return -1;
+	}
+
+	if (call == output->partial_call) {
+		size /= 2;
+	}
+
+	const uint8_t *p = static_cast<const uint8_t *>(buffer);
+	output->data.insert(output->data.end(), p, p + size);
+	return size;
+}
+
+static std::vector<uint8_t> decompress_output(const FailingOutput &output, FrameWriter &writer)
+{
+	char file_name[] = "/tmp/ulog_compression_test_XXXXXX";
+	const int fd = mkstemp(file_name);
+	FILE *file = fdopen(fd, "wb");
+	file_header_s file_header;
+	writer.encoder().fill_file_header(file_header, 0);
+	fwrite(&file_header, sizeof(file_header), 1, file);
+	fwrite(output.data.data(), 1, output.data.size(), file);
+	fclose(file);
+
+	const std::string out_file_name = std::string(file_name) + ".ulg";
+	EXPECT_EQ(decompress_file(file_name, out_file_name.c_str()), 0);
+
+	std::vector<uint8_t> result;
+	file = fopen(out_file_name.c_str(), "rb");
+
+	if (file) {
+		uint8_t buffer[1024];
+		size_t n;
+
+		while ((n = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+			result.insert(result.end(), buffer, buffer + n);
+		}
+
+		fclose(file);
+	}
+
+	unlink(file_name);
+	unlink(out_file_name.c_str());
+	return result;
+}
+
+TEST(UlogCompression, frame_write_failure)
+{
+	// GIVEN: an output where writing the second frame fails
+	FailingOutput output;
+	output.fail_call = 1;
+	FrameWriter writer(failing_output_write, &output);
+	ASSERT_TRUE(writer.encoder().init());
+	writer.reset();
+
+	const std::vector<uint8_t> input = generate_data(3 * FRAME_SIZE_DEFAULT + 100);
+
+	// WHEN: writing 3 frames in one call
+	const ssize_t consumed = writer.write(input.data(), 3 * FRAME_SIZE_DEFAULT);
+
+	// THEN: the call stops after the failed frame, its data is consumed and the frame is kept
+	EXPECT_EQ(consumed, (ssize_t)(2 * FRAME_SIZE_DEFAULT));
+	EXPECT_TRUE(writer.frame_pending());
+
+	// WHEN: the caller continues with the remaining data
+	size_t offset = consumed;
+
+	while (offset < input.size()) {
+		const ssize_t ret = writer.write(&input[offset], input.size() - offset);
+		ASSERT_GT(ret, 0);
+		offset += ret;
+	}
+
+	EXPECT_EQ(writer.flush(), 0);
+	EXPECT_FALSE(writer.frame_pending());
+
+	// THEN: every byte is in the file exactly once
+	EXPECT_EQ(decompress_output(output, writer), input);
+}
+
+TEST(UlogCompression, frame_write_partial_and_retry)
+{
+	// GIVEN: an output that writes half of the first frame and then fails twice
+	FailingOutput output;
+	output.partial_call = 0;
+	output.fail_call = 1;
+	FrameWriter writer(failing_output_write, &output);
+	ASSERT_TRUE(writer.encoder().init());
+	writer.reset();
+
+	const std::vector<uint8_t> input = generate_data(2 * FRAME_SIZE_DEFAULT);
+
+	// WHEN: the first frame fails
+	EXPECT_EQ(writer.write(input.data(), FRAME_SIZE_DEFAULT), (ssize_t)FRAME_SIZE_DEFAULT);
+	EXPECT_TRUE(writer.frame_pending());
+
+	// THEN: a retry of the pending frame that fails again consumes nothing
+	output.fail_call = 2;
+	EXPECT_EQ(writer.write(&input[FRAME_SIZE_DEFAULT], FRAME_SIZE_DEFAULT), -1);
+
+	// WHEN: the output recovers
+	EXPECT_EQ(writer.write(&input[FRAME_SIZE_DEFAULT], FRAME_SIZE_DEFAULT), (ssize_t)FRAME_SIZE_DEFAULT);
+	EXPECT_EQ(writer.flush(), 0);
+
+	// THEN: the frame is continued where it stopped, without duplicated data
+	EXPECT_EQ(decompress_output(output, writer), input);
+}
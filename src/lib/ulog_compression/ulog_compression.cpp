@@ -0,0 +1,584 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include "ulog_compression.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace ulog_compression
+{
+
+uint32_t crc32(uint32_t crc, const void *data, size_t length)
+{
+	// nibble table for the reflected polynomial 0xedb88320
+	static const uint32_t table[16] = {
+		0x00000000, 0x1db71064, 0x3b6e20c8, 0x26d930ac, 0x76dc4190, 0x6b6b51f4, 0x4db26158, 0x5005713c,
+		0xedb88320, 0xf00f9344, 0xd6d6a3e8, 0xcb61b38c, 0x9b64c2b0, 0x86d3d2d4, 0xa00ae278, 0xbdbdf21c
+	};
+
+	const uint8_t *p = static_cast<const uint8_t *>(data);
+	crc = ~crc;
+
+	for (size_t i = 0; i < length; ++i) {
+		crc ^= p[i];
+		crc = (crc >> 4) ^ table[crc & 0xf];
+		crc = (crc >> 4) ^ table[crc & 0xf];
+	}
+
+	return ~crc;
+}
+
+static inline uint32_t read32(const uint8_t *p)
+{
+	uint32_t v;
+	memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+static inline uint32_t lz4_hash(uint32_t sequence)
+{
+	static_assert(HASH_TABLE_SIZE == (1 << 12), "hash size mismatch");
+	return (sequence * 2654435761u) >> (32 - 12);
+}
+
+static inline uint8_t *lz4_write_length(uint8_t *op, size_t length)
+{
+	while (length >= 255) {
+		*op++ = 255;
+		length -= 255;
+	}
+
+	*op++ = (uint8_t)length;
+	return op;
+}
+
+/**
+ * write a sequence (literals followed by a match, or only literals for the last sequence)
+ * @return nullptr if it does not fit
+ */
+static uint8_t *lz4_write_sequence(uint8_t *op, const uint8_t *op_end, const uint8_t *literals, size_t literal_length,
+				   size_t offset, size_t match_length)
+{
+	// worst case size of the sequence
+	if ((size_t)(op_end - op) < 1 + literal_length / 255 + 1 + literal_length + 2 + match_length / 255 + 1) {
+		return nullptr;
+	}
+
+	uint8_t *token = op++;
+	*token = (uint8_t)((literal_length < 15 ? literal_length : 15) << 4);
+
+	if (literal_length >= 15) {
+		op = lz4_write_length(op, literal_length - 15);
+	}
+
+	if (literal_length > 0) {
+		memcpy(op, literals, literal_length);
+		op += literal_length;
+	}
+
+	if (match_length > 0) {
+		*op++ = (uint8_t)(offset & 0xff);
+		*op++ = (uint8_t)(offset >> 8);
+
+		const size_t length = match_length - 4;
+		*token |= (uint8_t)(length < 15 ? length : 15);
+
+		if (length >= 15) {
+			op = lz4_write_length(op, length - 15);
+		}
+	}
+
+	return op;
+}
+
+size_t lz4_compress(const uint8_t *src, size_t length, uint8_t *dst, size_t dst_size, uint16_t *hash_table)
+{
+	// block format constraints: the last 5 bytes are always literals, and the last match
+	// must start at least 12 bytes before the end of the block
+	static constexpr size_t LAST_LITERALS = 5;
+	static constexpr size_t MATCH_LIMIT = 12;
+
+	if (length > FRAME_SIZE_MAX) {
+		return 0;
+	}
+
+	uint8_t *op = dst;
+	const uint8_t *op_end = dst + dst_size;
+	size_t anchor = 0;
+
+	if (length > MATCH_LIMIT) {
+		memset(hash_table, 0, HASH_TABLE_SIZE * sizeof(hash_table[0]));
+
+		const size_t input_limit = length - MATCH_LIMIT;
+		size_t ip = 1;
+
+		while (ip < input_limit) {
+			const uint32_t sequence = read32(src + ip);
+			const uint32_t h = lz4_hash(sequence);
+			size_t ref = hash_table[h];
+			hash_table[h] = (uint16_t)ip;
+
+			if (ref >= ip || read32(src + ref) != sequence) {
+				++ip;
+				continue;
+			}
+
+			// extend the match backwards into the pending literals
+			while (ip > anchor && ref > 0 && src[ip - 1] == src[ref - 1]) {
+				--ip;
+				--ref;
+			}
+
+			size_t match_length = 4;
+			const size_t match_max = length - LAST_LITERALS - ip;
+
+			while (match_length < match_max && src[ip + match_length] == src[ref + match_length]) {
+				++match_length;
+			}
+
+			op = lz4_write_sequence(op, op_end, src + anchor, ip - anchor, ip - ref, match_length);
+
+			if (!op) {
+				return 0;
+			}
+
+			ip += match_length;
+			anchor = ip;
+
+			if (ip < input_limit) {
+				hash_table[lz4_hash(read32(src + ip - 2))] = (uint16_t)(ip - 2);
+			}
+		}
+	}
+
+	op = lz4_write_sequence(op, op_end, src + anchor, length - anchor, 0, 0);
+
+	if (!op) {
+		return 0;
+	}
+
+	return op - dst;
+}
+
+int lz4_decompress(const uint8_t *src, size_t length, uint8_t *dst, size_t dst_size)
+{
+	size_t ip = 0;
+	size_t op = 0;
+
+	while (ip < length) {
+		const uint8_t token = src[ip++];
+		size_t literal_length = token >> 4;
+
+		if (literal_length == 15) {
+			uint8_t b;
+
+			do {
+				if (ip >= length) {
+					return -1;
+				}
+
+				b = src[ip++];
+				literal_length += b;
+			} while (b == 255);
+		}
+
+		if (literal_length > length - ip || literal_length > dst_size - op) {
+			return -1;
+		}
+
+		memcpy(dst + op, src + ip, literal_length);
+		ip += literal_length;
+		op += literal_length;
+
+		if (ip == length) {
+			// the last sequence only contains literals
+			break;
+		}
+
+		if (length - ip < 2) {
+			return -1;
+		}
+
+		const size_t offset = src[ip] | (src[ip + 1] << 8);
+		ip += 2;
+
+		if (offset == 0 || offset > op) {
+			return -1;
+		}
+
+		size_t match_length = token & 0xf;
+
+		if (match_length == 15) {
+			uint8_t b;
+
+			do {
+				if (ip >= length) {
+					return -1;
+				}
+
+				b = src[ip++];
+				match_length += b;
+			} while (b == 255);
+		}
+
+		match_length += 4;
+
+		if (match_length > dst_size - op) {
+			return -1;
+		}
+
+		// byte-wise, as the match may overlap with the output
+		for (size_t i = 0; i < match_length; ++i) {
+			dst[op + i] = dst[op - offset + i];
+		}
+
+		op += match_length;
+	}
+
+	return (int)op;
+}
+
+Encoder::~Encoder()
+{
+	free(_raw);
+	free(_frame);
+	free(_hash_table);
+}
+
+bool Encoder::init(size_t frame_size)
+{
+	if (frame_size == 0 || frame_size > FRAME_SIZE_MAX) {
+		return false;
+	}
+
+	if (_raw && frame_size == _frame_size) {
+		return true;
+	}
+
+	free(_raw);
+	free(_frame);
+	free(_hash_table);
+
+	_frame_size = frame_size;
+	_raw = (uint8_t *)malloc(frame_size);
+	_frame = (uint8_t *)malloc(sizeof(frame_header_s) + lz4_compress_bound(frame_size));
+	_hash_table = (uint16_t *)malloc(HASH_TABLE_SIZE * sizeof(uint16_t));
+
+	if (!_raw || !_frame || !_hash_table) {
+		free(_raw);
+		free(_frame);
+		free(_hash_table);
+		_raw = _frame = nullptr;
+		_hash_table = nullptr;
+		return false;
+	}
+
+	reset();
+	return true;
+}
+
+void Encoder::reset()
+{
+	_raw_fill = 0;
+	_raw_offset = 0;
+	_encoded_bytes = 0;
+}
+
+void Encoder::fill_file_header(file_header_s &header, uint64_t timestamp) const
+{
+	memcpy(header.magic, FILE_MAGIC, sizeof(header.magic));
+	header.version = FILE_VERSION;
+	header.frame_size_max = _frame_size;
+	header.timestamp = timestamp;
+}
+
+size_t Encoder::append(const void *data, size_t size)
+{
+	const size_t n = (size < _frame_size - _raw_fill) ? size : _frame_size - _raw_fill;
+	memcpy(_raw + _raw_fill, data, n);
+	_raw_fill += n;
+	return n;
+}
+
+const uint8_t *Encoder::encode(size_t &length)
+{
+	frame_header_s header{};
+	memcpy(header.sync, FRAME_SYNC, sizeof(header.sync));
+	header.raw_size = _raw_fill;
+	header.raw_offset = _raw_offset;
+	header.raw_crc = crc32(0, _raw, _raw_fill);
+
+	uint8_t *payload = _frame + sizeof(frame_header_s);
+	size_t data_size = lz4_compress(_raw, _raw_fill, payload, _raw_fill, _hash_table);
+
+	if (data_size > 0) {
+		header.method = (uint8_t)Method::LZ4;
+
+	} else {
+		// incompressible
+		header.method = (uint8_t)Method::Stored;
+		memcpy(payload, _raw, _raw_fill);
+		data_size = _raw_fill;
+	}
+
+	header.data_size = data_size;
+	memcpy(_frame, &header, sizeof(header));
+
+	length = sizeof(frame_header_s) + data_size;
+	_raw_offset += _raw_fill;
+	_encoded_bytes += length;
+	_raw_fill = 0;
+	return _frame;
+}
+
+void FrameWriter::reset()
+{
+	_encoder.reset();
+	_frame = nullptr;
+	_frame_length = 0;
+	_frame_written = 0;
+	_compress_time = 0;
+}
+
+int FrameWriter::write_frame()
+{
+	if (_frame_length == 0) {
+		const uint64_t start = _clock_function ? _clock_function() : 0;
+		_frame = _encoder.encode(_frame_length);
+		_frame_written = 0;
+
+		if (_clock_function) {
+			_compress_time += _clock_function() - start;
+		}
+	}
+
+	while (_frame_written < _frame_length) {
+		const ssize_t ret = _write_function(_context, _frame + _frame_written, _frame_length - _frame_written);
+
+		if (ret <= 0) {
+			// keep the frame, it is retried with the next write
+			return -1;
+		}
+
+		_frame_written += ret;
+	}
+
+	_frame_length = 0;
+	return 0;
+}
+
+ssize_t FrameWriter::write(const void *data, size_t size)
+{
+	if (_frame_length > 0 && write_frame() != 0) {
+		return -1;
+	}
+
+	const uint8_t *raw = static_cast<const uint8_t *>(data);
+	size_t consumed = 0;
+
+	while (consumed < size) {
+		consumed += _encoder.append(raw + consumed, size - consumed);
+
+		if (_encoder.full() && write_frame() != 0) {
+			// the data is consumed: it is in the pending frame
+			break;
+		}
+	}
+
+	return consumed;
+}
+
+int FrameWriter::flush()
+{
+	if (_frame_length > 0 && write_frame() != 0) {
+		return -1;
+	}
+
+	if (_encoder.pending() > 0) {
+		return write_frame();
+	}
+
+	return 0;
+}
+
+static bool read_file_header(FILE *file, file_header_s &header)
+{
+	return fread(&header, sizeof(header), 1, file) == 1
+	       && memcmp(header.magic, FILE_MAGIC, sizeof(header.magic)) == 0
+	       && header.version == FILE_VERSION
+	       && header.frame_size_max > 0 && header.frame_size_max <= FRAME_SIZE_MAX;
+}
+
+bool is_compressed_file(const char *file_name)
+{
+	FILE *file = fopen(file_name, "rb");
+
+	if (!file) {
+		return false;
+	}
+
+	file_header_s header;
+	const bool ret = read_file_header(file, header);
+	fclose(file);
+	return ret;
+}
+
+/**
+ * find the next frame sync marker at or after position
+ * @return file position, or -1 if there is none
+ */
+static long find_frame_sync(FILE *file, long position)
+{
+	uint8_t buffer[1024];
+
+	while (fseek(file, position, SEEK_SET) == 0) {
+		const size_t n = fread(buffer, 1, sizeof(buffer), file);
+
+		if (n < sizeof(FRAME_SYNC)) {
+			break;
+		}
+
+		for (size_t i = 0; i + sizeof(FRAME_SYNC) <= n; ++i) {
+			if (memcmp(buffer + i, FRAME_SYNC, sizeof(FRAME_SYNC)) == 0) {
+				return position + i;
+			}
+		}
+
+		// overlap, in case the marker spans two reads
+		position += n - (sizeof(FRAME_SYNC) - 1);
+	}
+
+	return -1;
+}
+
+int decompress_file(const char *in_file_name, const char *out_file_name)
+{
+	FILE *in = fopen(in_file_name, "rb");
+
+	if (!in) {
+		return -1;
+	}
+
+	file_header_s file_header;
+
+	if (!read_file_header(in, file_header)) {
+		fclose(in);
+		return -1;
+	}
+
+	FILE *out = fopen(out_file_name, "wb");
+	const size_t data_size_max = lz4_compress_bound(file_header.frame_size_max);
+	uint8_t *data = (uint8_t *)malloc(data_size_max);
+	uint8_t *raw = (uint8_t *)malloc(file_header.frame_size_max);
+
+	int skipped = 0;
+	bool in_sync = true;
+	uint64_t raw_offset = 0;
+	long position = ftell(in);
+
+	while (out && data && raw) {
+		frame_header_s header;
+
+		if (fread(&header, sizeof(header), 1, in) != 1) {
+			break;
+		}
+
+		bool valid = memcmp(header.sync, FRAME_SYNC, sizeof(FRAME_SYNC)) == 0
+			     && header.raw_size <= file_header.frame_size_max
+			     && header.data_size <= data_size_max
+			     && header.raw_offset >= raw_offset;
+
+		if (valid && fread(data, 1, header.data_size, in) != header.data_size) {
+			// truncated at the end of the file
+			++skipped;
+			break;
+		}
+
+		if (valid) {
+			if (header.method == (uint8_t)Method::LZ4) {
+				valid = lz4_decompress(data, header.data_size, raw, header.raw_size) == (int)header.raw_size;
+
+			} else if (header.method == (uint8_t)Method::Stored && header.data_size == header.raw_size) {
+				memcpy(raw, data, header.raw_size);
+
+			} else {
+				valid = false;
+			}
+
+			valid = valid && crc32(0, raw, header.raw_size) == header.raw_crc;
+		}
+
+		if (valid) {
+			// frames before a gap are lost: the ULog sync messages allow parsers to continue
+			if (fwrite(raw, 1, header.raw_size, out) != header.raw_size) {
+				skipped = -1;
+				break;
+			}
+
+			raw_offset = header.raw_offset + header.raw_size;
+			in_sync = true;
+			position = ftell(in);
+
+		} else {
+			if (in_sync) {
+				++skipped;
+				in_sync = false;
+			}
+
+			position = find_frame_sync(in, position + 1);
+
+			if (position < 0 || fseek(in, position, SEEK_SET) != 0) {
+				break;
+			}
+		}
+	}
+
+	if (!out || !data || !raw) {
+		skipped = -1;
+	}
+
+	free(data);
+	free(raw);
+
+	if (out && fclose(out) != 0) {
+		skipped = -1;
+	}
+
+	fclose(in);
+	return skipped;
+}
+
+} // namespace ulog_compression
@@ -0,0 +1,243 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file ulog_compression.h
+ *
+ * Framed LZ4 block compression for ULog files.
+ *
+ * File layout: file_header_s, followed by a sequence of frames, each consisting of a frame_header_s
+ * and data_size bytes of payload. Every frame is compressed independently (no shared dictionary), and
+ * carries the offset of its data in the uncompressed stream and a CRC-32 of the uncompressed data.
+ * This makes the file seekable (a reader can skip frames by only reading the headers) and recoverable:
+ * a truncated or corrupted frame is detected via the checksum, and the reader resynchronizes on the
+ * next frame sync marker.
+ * The uncompressed stream is a regular ULog file.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+namespace ulog_compression
+{
+
+static constexpr uint8_t FILE_MAGIC[7] = {'U', 'L', 'o', 'g', 'L', 'Z', '4'};
+static constexpr uint8_t FILE_VERSION = 1;
+static constexpr uint8_t FRAME_SYNC[4] = {0xab, 'U', 'L', 'Z'};
+
+static constexpr size_t FRAME_SIZE_DEFAULT = 16 * 1024;
+static constexpr size_t FRAME_SIZE_MAX = 64 * 1024; ///< limited by the 16 bit LZ4 match offset
+
+enum class Method : uint8_t {
+	Stored = 0, ///< uncompressed payload (used if the data does not compress)
+	LZ4 = 1,    ///< LZ4 block format
+};
+
+/* declare data structs with byte alignment (no padding) */
+#pragma pack(push, 1)
+
+/** first bytes of the file */
+struct file_header_s {
+	uint8_t magic[7];
+	uint8_t version;
+	uint32_t frame_size_max; ///< upper bound of raw_size of all frames
+	uint64_t timestamp;
+};
+
+struct frame_header_s {
+	uint8_t sync[4];
+	uint8_t method; ///< @see Method
+	uint8_t reserved[3];
+	uint32_t raw_size; ///< uncompressed size
+	uint32_t data_size; ///< payload size following the header
+	uint64_t raw_offset; ///< offset of the first byte in the uncompressed stream
+	uint32_t raw_crc; ///< CRC-32 of the uncompressed data
+};
+
+#pragma pack(pop)
+
+/**
+ * CRC-32 (IEEE 802.3, as used by zlib)
+ * @param crc 0 to start, or the result of the previous call to continue
+ */
+uint32_t crc32(uint32_t crc, const void *data, size_t length);
+
+/** worst case LZ4 output size for length input bytes */
+static inline size_t lz4_compress_bound(size_t length) { return length + length / 255 + 16; }
+
+static constexpr size_t HASH_TABLE_SIZE = 4096;
+
+/**
+ * Compress into a single LZ4 block.
+ * @param hash_table scratch buffer of HASH_TABLE_SIZE entries
+ * @return compressed size, or 0 if it does not fit into dst_size
+ */
+size_t lz4_compress(const uint8_t *src, size_t length, uint8_t *dst, size_t dst_size, uint16_t *hash_table);
+
+/**
+ * Decompress a single LZ4 block.
+ * @return decompressed size, or -1 if the input is malformed or does not fit into dst_size
+ */
+int lz4_decompress(const uint8_t *src, size_t length, uint8_t *dst, size_t dst_size);
+
+/**
+ * @class Encoder
+ * Collects raw data and turns it into frames.
+ */
+class Encoder
+{
+public:
+	Encoder() = default;
+	~Encoder();
+
+	Encoder(const Encoder &) = delete;
+	Encoder &operator=(const Encoder &) = delete;
+
+	/**
+	 * allocate the buffers
+	 * @param frame_size raw data size per frame, at most FRAME_SIZE_MAX
+	 */
+	bool init(size_t frame_size = FRAME_SIZE_DEFAULT);
+
+	/** start a new file */
+	void reset();
+
+	void fill_file_header(file_header_s &header, uint64_t timestamp) const;
+
+	/**
+	 * Buffer raw data for the current frame.
+	 * @return number of bytes consumed (less than size if the frame is full)
+	 */
+	size_t append(const void *data, size_t size);
+
+	/** number of buffered raw bytes */
+	size_t pending() const { return _raw_fill; }
+
+	bool full() const { return _raw_fill == _frame_size; }
+
+	/**
+	 * Compress the buffered data into a frame and clear the buffer.
+	 * @param length frame length (header + payload)
+	 * @return frame, valid until the next call
+	 */
+	const uint8_t *encode(size_t &length);
+
+	/** total uncompressed bytes in encoded frames */
+	uint64_t raw_bytes() const { return _raw_offset; }
+
+	/** total bytes of encoded frames (including headers) */
+	uint64_t encoded_bytes() const { return _encoded_bytes; }
+
+private:
+	size_t _frame_size{0};
+	uint8_t *_raw{nullptr};
+	size_t _raw_fill{0};
+	uint8_t *_frame{nullptr}; ///< frame_header_s + payload
+	uint16_t *_hash_table{nullptr};
+
+	uint64_t _raw_offset{0};
+	uint64_t _encoded_bytes{0};
+};
+
+/**
+ * @class FrameWriter
+ * Feeds an Encoder and writes the completed frames through a write function.
+ * A frame that could not be written completely is kept and written before any new data is accepted,
+ * so that retrying after a write error neither loses nor duplicates data.
+ */
+class FrameWriter
+{
+public:
+	/** write function with ::write() semantics: returns the number of bytes written, or -1 on error */
+	typedef ssize_t (*write_function_t)(void *context, const void *buffer, size_t size);
+
+	/** monotonic time in microseconds, used to measure the compression time */
+	typedef uint64_t (*clock_function_t)();
+
+	FrameWriter(write_function_t write_function, void *context, clock_function_t clock_function = nullptr)
+		: _write_function(write_function), _context(context), _clock_function(clock_function) {}
+
+	Encoder &encoder() { return _encoder; }
+
+	/** start a new file, drops a pending frame */
+	void reset();
+
+	/**
+	 * Compress and write data.
+	 * @return number of bytes consumed. This includes data in a frame that failed to be written, which is
+	 *         retried with the next call. -1 if a frame of a previous call still fails to be written.
+	 */
+	ssize_t write(const void *data, size_t size);
+
+	/**
+	 * Write the pending frame and the partially filled one.
+	 * @return 0 on success, -1 on write error
+	 */
+	int flush();
+
+	/** true if an encoded frame is waiting to be (completely) written */
+	bool frame_pending() const { return _frame_length > 0; }
+
+	/** time spent compressing, in microseconds (0 without clock function) */
+	uint64_t compress_time() const { return _compress_time; }
+
+private:
+	/** encode the buffered data unless a frame is pending, and write the frame */
+	int write_frame();
+
+	Encoder _encoder;
+	write_function_t _write_function;
+	void *_context;
+	clock_function_t _clock_function;
+
+	const uint8_t *_frame{nullptr};
+	size_t _frame_length{0};
+	size_t _frame_written{0};
+	uint64_t _compress_time{0};
+};
+
+/** check if file_name starts with file_header_s */
+bool is_compressed_file(const char *file_name);
+
+/**
+ * Decompress a file into a regular ULog file.
+ * Corrupted or truncated frames are skipped.
+ * @return number of skipped frames, or -1 on error
+ */
+int decompress_file(const char *in_file_name, const char *out_file_name);
+
+} // namespace ulog_compression
@@ -66,6 +66,8 @@ ControlAllocator::ControlAllocator() :
 		_param_handles.slew_rate_servos[i] = param_find(buffer);
 	}
 
+	EnableLatencyHistogramIfConfigured();
+
 	parameters_updated();
 }
 
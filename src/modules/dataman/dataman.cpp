@@ -42,17 +42,23 @@
  */
 
 #include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/atomic.h>
 #include <px4_platform_common/defines.h>
 #include <px4_platform_common/module.h>
 #include <px4_platform_common/posix.h>
 #include <px4_platform_common/tasks.h>
 #include <px4_platform_common/getopt.h>
 #include <drivers/drv_hrt.h>
+#include <lib/mathlib/mathlib.h>
 #include <lib/parameters/param.h>
 #include <lib/perf/perf_counter.h>
 
 #include "dataman.h"
 
+#if defined(__PX4_LINUX)
+#include <sys/mman.h>
+#endif
+
 __BEGIN_DECLS
 __EXPORT int dataman_main(int argc, char *argv[]);
 __END_DECLS
@@ -73,6 +79,15 @@ static int  _ram_clear(dm_item_t item);
 static int _ram_initialize(unsigned max_offset);
 static void _ram_shutdown();
 
+#if defined(__PX4_LINUX)
+/* Private memory-mapped file based Operations (reads are served by _ram_read) */
+static ssize_t _mmap_write(dm_item_t item, unsigned index, const void *buf, size_t count);
+static int  _mmap_clear(dm_item_t item);
+static int _mmap_initialize(unsigned max_offset);
+static void _mmap_shutdown();
+static int _mmap_sync();
+#endif
+
 typedef struct dm_operations_t {
 	ssize_t (*write)(dm_item_t item, unsigned index, const void *buf, size_t count);
 	ssize_t (*read)(dm_item_t item, unsigned index, void *buf, size_t count);
@@ -80,6 +95,7 @@ typedef struct dm_operations_t {
 	int (*initialize)(unsigned max_offset);
 	void (*shutdown)();
 	int (*wait)(px4_sem_t *sem);
+	int (*sync)(); ///< optional: make the changes persistent before writes & clears are reported as completed
 } dm_operations_t;
 
 static constexpr dm_operations_t dm_file_operations = {
@@ -89,6 +105,7 @@ static constexpr dm_operations_t dm_file_operations = {
 	.initialize = _file_initialize,
 	.shutdown = _file_shutdown,
 	.wait = px4_sem_wait,
+	.sync = nullptr,
 };
 
 static constexpr dm_operations_t dm_ram_operations = {
@@ -98,8 +115,21 @@ static constexpr dm_operations_t dm_ram_operations = {
 	.initialize = _ram_initialize,
 	.shutdown = _ram_shutdown,
 	.wait = px4_sem_wait,
+	.sync = nullptr,
 };
 
+#if defined(__PX4_LINUX)
+static constexpr dm_operations_t dm_mmap_operations = {
+	.write   = _mmap_write,
+	.read    = _ram_read,
+	.clear   = _mmap_clear,
+	.initialize = _mmap_initialize,
+	.shutdown = _mmap_shutdown,
+	.wait = px4_sem_wait,
+	.sync = _mmap_sync,
+};
+#endif
+
 static const dm_operations_t *g_dm_ops;
 
 static struct {
@@ -108,8 +138,11 @@ static struct {
 			int fd;
 		} file;
 		struct {
-			uint8_t *data;
+			uint8_t *data; ///< RAM buffer, or the mapping of the file for the mmap backend
 			uint8_t *data_end;
+			int fd; ///< mapped file (mmap backend only)
+			unsigned dirty_start; ///< range of the mapping modified since the last sync (mmap backend only)
+			unsigned dirty_end;
 		} ram;
 	};
 	bool running;
@@ -120,6 +153,7 @@ typedef enum {
 	dm_write_func = 0,
 	dm_read_func,
 	dm_clear_func,
+	dm_read_range_func,
 	dm_number_of_funcs
 } dm_function_t;
 
@@ -146,6 +180,13 @@ typedef struct {
 		struct {
 			dm_item_t item;
 		} clear_params;
+		struct {
+			dm_item_t item;
+			unsigned index;
+			void *buf;
+			size_t buflen;
+			unsigned count;
+		} read_range_params;
 	};
 } work_q_item_t;
 
@@ -185,8 +226,18 @@ static px4_sem_t g_sys_state_mutex_mission;
 static px4_sem_t g_sys_state_mutex_fence;
 
 static perf_counter_t _dm_read_perf{nullptr};
+static perf_counter_t _dm_read_direct_perf{nullptr};
 static perf_counter_t _dm_write_perf{nullptr};
 
+/*
+ * Sequence counter of the RAM backend. The worker thread (the only writer) makes it odd while it modifies the RAM
+ * buffer, which allows readers to copy items directly from the buffer without a round-trip through the work queue.
+ */
+static px4::atomic<uint32_t> g_ram_seq{0};
+
+/* Number of callers copying directly from the RAM buffer, which must not be released before they are done */
+static px4::atomic<uint32_t> g_ram_readers{0};
+
 /* The data manager store file handle and file name */
 static const char *default_device_path = PX4_STORAGEDIR "/dataman";
 static char *k_data_manager_device_path = nullptr;
@@ -195,6 +246,7 @@ static enum {
 	BACKEND_NONE = 0,
 	BACKEND_FILE,
 	BACKEND_RAM,
+	BACKEND_MMAP,
 	BACKEND_LAST
 } backend = BACKEND_NONE;
 
@@ -357,6 +409,12 @@ static bool is_running()
 	return dm_operations_data.running;
 }
 
+/* The RAM and mmap backends keep all items in memory, which can be read directly */
+static bool is_memory_backend()
+{
+	return backend == BACKEND_RAM || backend == BACKEND_MMAP;
+}
+
 /* Calculate the offset in file of specific item */
 static int
 calculate_offset(dm_item_t item, unsigned index)
@@ -387,6 +445,30 @@ calculate_offset(dm_item_t item, unsigned index)
  * The total size must not exceed g_per_item_max_index[item]
  */
 
+static inline void
+ram_write_begin()
+{
+	g_ram_seq.fetch_add(1);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+static inline void
+ram_write_end()
+{
+	g_ram_seq.fetch_add(1);
+}
+
+/* Stop the direct reads for good (the sequence counter stays odd) and wait for the ones in progress */
+static void
+ram_stop_direct_reads()
+{
+	g_ram_seq.fetch_add(1);
+
+	while (g_ram_readers.load() > 0) {
+		px4_usleep(1000);
+	}
+}
+
 /* write to the data manager RAM buffer  */
 static ssize_t _ram_write(dm_item_t item, unsigned index, const void *buf, size_t count)
 {
@@ -409,6 +491,8 @@ static ssize_t _ram_write(dm_item_t item, unsigned index, const void *buf, size_
 		return -1;
 	}
 
+	ram_write_begin();
+
 	/* Write out the data, prefixed with length */
 	buffer[0] = count;
 	buffer[1] = 0;
@@ -419,6 +503,8 @@ static ssize_t _ram_write(dm_item_t item, unsigned index, const void *buf, size_
 		memcpy(buffer + DM_SECTOR_HDR_SIZE, buf, count);
 	}
 
+	ram_write_end();
+
 	/* All is well... return the number of user data written */
 	return count;
 }
@@ -521,19 +607,81 @@ static ssize_t _ram_read(dm_item_t item, unsigned index, void *buf, size_t count
 		return -1;
 	}
 
+	/* Load the length only once, this might run concurrently to a write (@see ram_read_lockfree()) */
+	const uint8_t len = __atomic_load_n(&buffer[0], __ATOMIC_RELAXED);
+
 	/* See if we got data */
-	if (buffer[0] > 0) {
+	if (len > 0) {
 		/* We got more than requested!!! */
-		if (buffer[0] > count) {
+		if (len > count) {
 			return -1;
 		}
 
 		/* Looks good, copy it to the caller's buffer */
-		memcpy(buf, buffer + DM_SECTOR_HDR_SIZE, buffer[0]);
+		memcpy(buf, buffer + DM_SECTOR_HDR_SIZE, len);
 	}
 
 	/* Return the number of bytes of caller data read */
-	return buffer[0];
+	return len;
+}
+
+/**
+ * Read a range of items with the given read function, stopping at the first item that is not exactly buflen long.
+ * @return number of items read, or -1 if the first item failed
+ */
+static ssize_t
+read_range(ssize_t (*read)(dm_item_t item, unsigned index, void *buf, size_t count),
+	   dm_item_t item, unsigned index, void *buf, size_t buflen, unsigned count)
+{
+	for (unsigned i = 0; i < count; i++) {
+		const ssize_t ret = read(item, index + i, (uint8_t *)buf + i * buflen, buflen);
+
+		if (ret != (ssize_t)buflen) {
+			return (i == 0 && ret < 0) ? -1 : (ssize_t)i;
+		}
+	}
+
+	return count;
+}
+
+/**
+ * Read directly from the RAM buffer in the context of the caller.
+ * @param read reads the data from the RAM buffer and returns the result
+ * @return false if the caller has to go through the work queue instead, because of a concurrent write.
+ */
+template<typename ReadFunc>
+static bool
+ram_read_lockfree(ReadFunc read, ssize_t &result)
+{
+	// announce the read before checking the counter, so the buffer can't be released during the copy
+	g_ram_readers.fetch_add(1);
+
+	bool done = false;
+
+	for (int attempt = 0; attempt < 2 && !done; attempt++) {
+		const uint32_t seq = g_ram_seq.load();
+
+		if (seq & 1) {
+			if (!is_running()) {
+				// shutting down, the buffer is about to be released
+				result = -1;
+				done = true;
+			}
+
+			// a write is in progress, don't spin as we might have preempted the worker thread
+			break;
+		}
+
+		result = read();
+
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+		done = (g_ram_seq.load() == seq);
+	}
+
+	g_ram_readers.fetch_sub(1);
+
+	return done;
 }
 
 /* Retrieve from the data manager file */
@@ -625,6 +773,8 @@ static int  _ram_clear(dm_item_t item)
 		return -1;
 	}
 
+	ram_write_begin();
+
 	/* Clear all items of this type */
 	for (i = 0; (unsigned)i < g_per_item_max_index[item]; i++) {
 		uint8_t *buf = &dm_operations_data.ram.data[offset];
@@ -638,6 +788,8 @@ static int  _ram_clear(dm_item_t item)
 		offset += g_per_item_size[item];
 	}
 
+	ram_write_end();
+
 	return result;
 }
 
@@ -777,9 +929,139 @@ _file_shutdown()
 static void
 _ram_shutdown()
 {
+	dm_operations_data.running = false;
+	ram_stop_direct_reads();
 	free(dm_operations_data.ram.data);
+}
+
+#if defined(__PX4_LINUX)
+static void
+_mmap_mark_dirty(unsigned start, unsigned end)
+{
+	if (dm_operations_data.ram.dirty_end <= dm_operations_data.ram.dirty_start) {
+		dm_operations_data.ram.dirty_start = start;
+		dm_operations_data.ram.dirty_end = end;
+
+	} else {
+		dm_operations_data.ram.dirty_start = math::min(dm_operations_data.ram.dirty_start, start);
+		dm_operations_data.ram.dirty_end = math::max(dm_operations_data.ram.dirty_end, end);
+	}
+}
+
+/* write to the mapped data manager file, it is made persistent with _mmap_sync() */
+static ssize_t
+_mmap_write(dm_item_t item, unsigned index, const void *buf, size_t count)
+{
+	const ssize_t ret = _ram_write(item, index, buf, count);
+
+	if (ret >= 0) {
+		const int offset = calculate_offset(item, index);
+		_mmap_mark_dirty(offset, offset + DM_SECTOR_HDR_SIZE + ret);
+	}
+
+	return ret;
+}
+
+static int
+_mmap_clear(dm_item_t item)
+{
+	const int ret = _ram_clear(item);
+
+	if (ret == 0) {
+		const int offset = calculate_offset(item, 0);
+		_mmap_mark_dirty(offset, offset + g_per_item_max_index[item] * g_per_item_size[item]);
+	}
+
+	return ret;
+}
+
+/* write the modified pages of the mapping to the file */
+static int
+_mmap_sync()
+{
+	if (dm_operations_data.ram.dirty_end <= dm_operations_data.ram.dirty_start) {
+		return 0;
+	}
+
+	const unsigned page_size = sysconf(_SC_PAGESIZE);
+	const unsigned start = dm_operations_data.ram.dirty_start - dm_operations_data.ram.dirty_start % page_size;
+	const unsigned end = dm_operations_data.ram.dirty_end;
+	dm_operations_data.ram.dirty_start = dm_operations_data.ram.dirty_end = 0;
+
+	if (msync(dm_operations_data.ram.data + start, end - start, MS_SYNC) != 0) {
+		PX4_ERR("msync failed %d", errno);
+		return -1;
+	}
+
+	return 0;
+}
+
+static int
+_mmap_initialize(unsigned max_offset)
+{
+	/* Open or create the data manager file, and make sure it has the full size (new space reads as empty items) */
+	dm_operations_data.ram.fd = open(k_data_manager_device_path, O_RDWR | O_CREAT | O_BINARY, PX4_O_MODE_666);
+
+	if (dm_operations_data.ram.fd < 0) {
+		PX4_WARN("Could not open data manager file %s", k_data_manager_device_path);
+		px4_sem_post(&g_init_sema); /* Don't want to hang startup */
+		return -1;
+	}
+
+	if (ftruncate(dm_operations_data.ram.fd, max_offset) != 0) {
+		close(dm_operations_data.ram.fd);
+		PX4_WARN("Could not resize data manager file %s", k_data_manager_device_path);
+		px4_sem_post(&g_init_sema); /* Don't want to hang startup */
+		return -1;
+	}
+
+	void *data = mmap(nullptr, max_offset, PROT_READ | PROT_WRITE, MAP_SHARED, dm_operations_data.ram.fd, 0);
+
+	if (data == MAP_FAILED) {
+		close(dm_operations_data.ram.fd);
+		PX4_WARN("Could not map data manager file %s (%d)", k_data_manager_device_path, errno);
+		px4_sem_post(&g_init_sema); /* Don't want to hang startup */
+		return -1;
+	}
+
+	dm_operations_data.ram.data = (uint8_t *)data;
+	dm_operations_data.ram.data_end = &dm_operations_data.ram.data[max_offset - 1];
+	dm_operations_data.ram.dirty_start = dm_operations_data.ram.dirty_end = 0;
+
+	// Read the mission state and check the hash, start with an empty file if it does not match
+	struct dataman_compat_s compat_state;
+	int ret = _ram_read(DM_KEY_COMPAT, 0, &compat_state, sizeof(compat_state));
+
+	if (ret != sizeof(compat_state) || compat_state.key != DM_COMPAT_KEY) {
+		memset(dm_operations_data.ram.data, 0, max_offset);
+		_mmap_mark_dirty(0, max_offset);
+
+		/* Write current compat info */
+		compat_state.key = DM_COMPAT_KEY;
+		ret = _mmap_write(DM_KEY_COMPAT, 0, &compat_state, sizeof(compat_state));
+
+		if (ret != sizeof(compat_state)) {
+			PX4_ERR("Failed writing compat: %d", ret);
+		}
+
+		_mmap_sync();
+	}
+
+	dm_operations_data.running = true;
+
+	return 0;
+}
+
+static void
+_mmap_shutdown()
+{
 	dm_operations_data.running = false;
+	ram_stop_direct_reads();
+	_mmap_sync();
+	munmap(dm_operations_data.ram.data, dm_operations_data.ram.data_end - dm_operations_data.ram.data + 1);
+	close(dm_operations_data.ram.fd);
 }
+#endif
 
 /** Write to the data manager file */
 __EXPORT ssize_t
@@ -826,6 +1108,15 @@ dm_read(dm_item_t item, unsigned index, void *buf, size_t count)
 
 	perf_begin(_dm_read_perf);
 
+	ssize_t ret;
+
+	/* The RAM backend can be read without waiting for the worker thread */
+	if (is_memory_backend() && ram_read_lockfree([&]() { return _ram_read(item, index, buf, count); }, ret)) {
+		perf_count(_dm_read_direct_perf);
+		perf_end(_dm_read_perf);
+		return ret;
+	}
+
 	/* get a work item and queue up a read request */
 	if ((work = create_work_item()) == nullptr) {
 		PX4_ERR("dm_read create_work_item failed");
@@ -840,7 +1131,50 @@ dm_read(dm_item_t item, unsigned index, void *buf, size_t count)
 	work->read_params.count = count;
 
 	/* Enqueue the item on the work queue and wait for the worker thread to complete processing it */
-	ssize_t ret = (ssize_t)enqueue_work_item_and_wait_for_result(work);
+	ret = (ssize_t)enqueue_work_item_and_wait_for_result(work);
+	perf_end(_dm_read_perf);
+	return ret;
+}
+
+/** Retrieve a range of items from the data manager file */
+__EXPORT ssize_t
+dm_read_range(dm_item_t item, unsigned index, void *buf, size_t buflen, unsigned count)
+{
+	work_q_item_t *work;
+
+	/* Make sure data manager has been started and is not shutting down */
+	if (!is_running() || g_task_should_exit) {
+		return -1;
+	}
+
+	perf_begin(_dm_read_perf);
+
+	ssize_t ret;
+
+	/* The RAM backend can be read without waiting for the worker thread */
+	if (is_memory_backend()
+	    && ram_read_lockfree([&]() { return read_range(_ram_read, item, index, buf, buflen, count); }, ret)) {
+		perf_count(_dm_read_direct_perf);
+		perf_end(_dm_read_perf);
+		return ret;
+	}
+
+	/* get a work item and queue up a read request for all items */
+	if ((work = create_work_item()) == nullptr) {
+		PX4_ERR("dm_read_range create_work_item failed");
+		perf_end(_dm_read_perf);
+		return -1;
+	}
+
+	work->func = dm_read_range_func;
+	work->read_range_params.item = item;
+	work->read_range_params.index = index;
+	work->read_range_params.buf = buf;
+	work->read_range_params.buflen = buflen;
+	work->read_range_params.count = count;
+
+	/* Enqueue the item on the work queue and wait for the worker thread to complete processing it */
+	ret = (ssize_t)enqueue_work_item_and_wait_for_result(work);
 	perf_end(_dm_read_perf);
 	return ret;
 }
@@ -944,6 +1278,13 @@ task_main(int argc, char *argv[])
 		g_dm_ops = &dm_ram_operations;
 		break;
 
+#if defined(__PX4_LINUX)
+
+	case BACKEND_MMAP:
+		g_dm_ops = &dm_mmap_operations;
+		break;
+#endif
+
 	default:
 		PX4_WARN("No valid backend set.");
 		return -1;
@@ -953,6 +1294,7 @@ task_main(int argc, char *argv[])
 
 	/* Initialize global variables */
 	g_key_offsets[0] = 0;
+	g_ram_seq.store(0); // left odd by the previous shutdown
 
 	for (int i = 0; i < ((int)DM_KEY_NUM_KEYS - 1); i++) {
 		g_key_offsets[i + 1] = g_key_offsets[i] + (g_per_item_max_index[i] * g_per_item_size[i]);
@@ -988,6 +1330,7 @@ task_main(int argc, char *argv[])
 	px4_sem_setprotocol(&g_work_queued_sema, SEM_PRIO_NONE);
 
 	_dm_read_perf = perf_alloc(PC_ELAPSED, MODULE_NAME": read");
+	_dm_read_direct_perf = perf_alloc(PC_COUNT, MODULE_NAME": read direct");
 	_dm_write_perf = perf_alloc(PC_ELAPSED, MODULE_NAME": write");
 
 	int ret = g_dm_ops->initialize(max_offset);
@@ -1007,6 +1350,10 @@ task_main(int argc, char *argv[])
 		PX4_INFO("data manager RAM size is %u bytes", max_offset);
 		break;
 
+	case BACKEND_MMAP:
+		PX4_INFO("data manager file '%s' size is %u bytes (memory-mapped)", k_data_manager_device_path, max_offset);
+		break;
+
 	default:
 		break;
 	}
@@ -1023,6 +1370,11 @@ task_main(int argc, char *argv[])
 			g_dm_ops->wait(&g_work_queued_sema);
 		}
 
+		/* Writes & clears of a backend with a sync operation are only reported as completed once the whole
+		 * queue is processed and synced, so that a batch of writes needs a single sync */
+		sq_queue_t unsynced_q;
+		sq_init(&unsynced_q);
+
 		/* Empty the work queue */
 		while ((work = dequeue_work_item())) {
 
@@ -1045,15 +1397,35 @@ task_main(int argc, char *argv[])
 				work->result = g_dm_ops->clear(work->clear_params.item);
 				break;
 
+			case dm_read_range_func:
+				g_func_counts[dm_read_range_func]++;
+				work->result =
+					read_range(g_dm_ops->read, work->read_range_params.item, work->read_range_params.index,
+						   work->read_range_params.buf, work->read_range_params.buflen, work->read_range_params.count);
+				break;
+
 			default: /* should never happen */
 				work->result = -1;
 				break;
 			}
 
+			if (g_dm_ops->sync && (work->func == dm_write_func || work->func == dm_clear_func)) {
+				sq_addlast(&work->link, &unsynced_q);
+				continue;
+			}
+
 			/* Inform the caller that work is done */
 			px4_sem_post(&work->wait_sem);
 		}
 
+		if (g_dm_ops->sync && !sq_empty(&unsynced_q)) {
+			g_dm_ops->sync();
+
+			while ((work = (work_q_item_t *)sq_remfirst(&unsynced_q))) {
+				px4_sem_post(&work->wait_sem);
+			}
+		}
+
 		/* time to go???? */
 		if (g_task_should_exit) {
 			break;
@@ -1084,6 +1456,9 @@ end:
 	perf_free(_dm_read_perf);
 	_dm_read_perf = nullptr;
 
+	perf_free(_dm_read_direct_perf);
+	_dm_read_direct_perf = nullptr;
+
 	perf_free(_dm_write_perf);
 	_dm_write_perf = nullptr;
 
@@ -1123,9 +1498,11 @@ status()
 	/* display usage statistics */
 	PX4_INFO("Writes   %u", g_func_counts[dm_write_func]);
 	PX4_INFO("Reads    %u", g_func_counts[dm_read_func]);
+	PX4_INFO("Range reads %u", g_func_counts[dm_read_range_func]);
 	PX4_INFO("Clears   %u", g_func_counts[dm_clear_func]);
 	PX4_INFO("Max Q lengths work %u, free %u", g_work_q.max_size, g_free_q.max_size);
 	perf_print_counter(_dm_read_perf);
+	perf_print_counter(_dm_read_direct_perf);
 	perf_print_counter(_dm_write_perf);
 }
 
@@ -1146,6 +1523,7 @@ usage()
 Module to provide persistent storage for the rest of the system in form of a simple database through a C API.
 Multiple backends are supported:
 - a file (eg. on the SD card)
+- a memory-mapped file (Linux only), which serves reads directly from memory and syncs batches of writes
 - RAM (this is obviously not persistent)
 
 It is used to store structured data of different types: mission waypoints, mission state and geofence polygons.
@@ -1155,6 +1533,11 @@ Each type has a specific type and a fixed maximum amount of storage items, so th
 Reading and writing a single item is always atomic. If multiple items need to be read/modified atomically, there is
 an additional lock per item type via `dm_lock`.
 
+Requests are served by a single worker thread. `dm_read_range` reads consecutive items with a single request.
+With the RAM and memory-mapped backends, reads are copied directly from memory in the context of the caller, and only
+fall back to the worker thread when they overlap with a write. The memory-mapped backend reports a write as completed
+once it is synced to the file, like the file backend, but syncs all writes queued at the same time at once.
+
 **DM_KEY_FENCE_POINTS** and **DM_KEY_SAFE_POINTS** items: the first data element is a `mission_stats_entry_s` struct,
 which stores the number of items for these types. These items are always updated atomically in one transaction (from
 the mavlink mission manager). During that time, navigator will try to acquire the geofence item lock, fail, and will not
@@ -1165,15 +1548,16 @@ check for geofence violations.
 	PRINT_MODULE_USAGE_NAME("dataman", "system");
 	PRINT_MODULE_USAGE_COMMAND("start");
 	PRINT_MODULE_USAGE_PARAM_STRING('f', nullptr, "<file>", "Storage file", true);
+	PRINT_MODULE_USAGE_PARAM_STRING('m', nullptr, "<file>", "Storage file, memory-mapped (Linux only)", true);
 	PRINT_MODULE_USAGE_PARAM_FLAG('r', "Use RAM backend (NOT persistent)", true);
-	PRINT_MODULE_USAGE_PARAM_COMMENT("The options -f and -r are mutually exclusive. If nothing is specified, a file 'dataman' is used");
+	PRINT_MODULE_USAGE_PARAM_COMMENT("The options -f, -m and -r are mutually exclusive. If nothing is specified, a file 'dataman' is used");
 	PRINT_MODULE_USAGE_DEFAULT_COMMANDS();
 }
 
 static int backend_check()
 {
 	if (backend != BACKEND_NONE) {
-		PX4_WARN("-f and -r are mutually exclusive");
+		PX4_WARN("-f, -m and -r are mutually exclusive");
 		usage();
 		return -1;
 	}
@@ -1202,7 +1586,7 @@ dataman_main(int argc, char *argv[])
 
 		/* jump over start and look at options first */
 
-		while ((ch = px4_getopt(argc, argv, "f:r", &dmoptind, &dmoptarg)) != EOF) {
+		while ((ch = px4_getopt(argc, argv, "f:m:r", &dmoptind, &dmoptarg)) != EOF) {
 			switch (ch) {
 			case 'f':
 				if (backend_check()) {
@@ -1214,6 +1598,22 @@ dataman_main(int argc, char *argv[])
 				PX4_INFO("dataman file set to: %s", k_data_manager_device_path);
 				break;
 
+			case 'm':
+#if defined(__PX4_LINUX)
+
+				if (backend_check()) {
+					return -1;
+				}
+
+				backend = BACKEND_MMAP;
+				k_data_manager_device_path = strdup(dmoptarg);
+				PX4_INFO("dataman file set to: %s (memory-mapped)", k_data_manager_device_path);
+				break;
+#else
+				PX4_WARN("memory-mapped backend not supported");
+				return -1;
+#endif
+
 			case 'r':
 				if (backend_check()) {
 					return -1;
@@ -99,6 +99,21 @@ dm_read(
 	size_t buflen			/* Length in bytes of data to retrieve */
 );
 
+/**
+ * Retrieve a range of consecutive items from the data manager store, with a single request to the worker thread
+ * (or none for the RAM backend). Each item is read atomically, but not the range as a whole (@see dm_lock()).
+ * @return number of items read (each exactly buflen bytes long), starting from index. Reading stops at the first
+ *         item which is empty, has a different length, or fails. -1 on error.
+ */
+__EXPORT ssize_t
+dm_read_range(
+	dm_item_t item,			/* The item type to retrieve */
+	unsigned index,			/* The index of the first item */
+	void *buffer,			/* Pointer to caller data buffer, with room for count items */
+	size_t buflen,			/* Length in bytes of each item */
+	unsigned count			/* Number of items to retrieve */
+);
+
 /** write to the data manager store */
 __EXPORT ssize_t
 dm_write(
@@ -41,6 +41,12 @@
 #include <cstdio>
 #include <cstring>
 
+/**
+ * Ring buffer of time stamped samples.
+ * The storage is rounded up to a power of two, so that indices wrap around with a mask. The number of samples kept
+ * is the requested size. Samples are expected to be pushed in order of increasing time_us, while an out of order
+ * sample is in the buffer pop_first_older_than() falls back to a linear search.
+ */
 template <typename data_type>
 class RingBuffer
 {
@@ -55,33 +61,40 @@ public:
 	RingBuffer(RingBuffer &&) = delete;
 	RingBuffer &operator=(RingBuffer &&) = delete;
 
-	bool allocate(uint8_t size)
+	bool allocate(uint16_t size)
 	{
 		if (valid() && (size == _size)) {
 			// no change
 			return true;
 		}
 
-		if (size == 0) {
+		if (size == 0 || size > MAX_SIZE) {
 			return false;
 		}
 
+		uint16_t capacity = 1;
+
+		while (capacity < size) {
+			capacity <<= 1;
+		}
+
 		if (_buffer != nullptr) {
 			delete[] _buffer;
 		}
 
-		_buffer = new data_type[size] {};
+		_buffer = new data_type[capacity] {};
 
 		if (_buffer == nullptr) {
+			_size = 0;
 			return false;
 		}
 
 		_size = size;
+		_mask = capacity - 1;
 
 		_head = 0;
-		_tail = 0;
-
-		_first_write = true;
+		_entries = 0;
+		_unordered = 0;
 
 		return true;
 	}
@@ -90,77 +103,124 @@ public:
 
 	void push(const data_type &sample)
 	{
-		uint8_t head_new = _head;
-
-		if (!_first_write) {
-			head_new = (_head + 1) % _size;
+		if (_unordered > 0) {
+			_unordered--;
 		}
 
-		_buffer[head_new] = sample;
-		_head = head_new;
+		if (_entries > 0) {
+			if (sample.time_us < _buffer[_head].time_us) {
+				// out of order, the binary search is invalid until this sample has left the buffer
+				_unordered = _size;
+			}
+
+			_head = (_head + 1) & _mask;
+		}
 
-		// move tail if we overwrite it
-		if (_head == _tail && !_first_write) {
-			_tail = (_tail + 1) % _size;
+		_buffer[_head] = sample;
 
-		} else {
-			_first_write = false;
+		// the oldest sample is dropped once the buffer is full
+		if (_entries < _size) {
+			_entries++;
 		}
 	}
 
-	uint8_t get_length() const { return _size; }
+	uint16_t get_length() const { return _size; }
 
-	data_type &operator[](const uint8_t index) { return _buffer[index]; }
+	/**
+	 * Access a sample by its position, starting with 0 for the oldest one.
+	 */
+	data_type &operator[](const uint16_t index) { return _buffer[(oldest() + index) & _mask]; }
 
 	const data_type &get_newest() const { return _buffer[_head]; }
-	const data_type &get_oldest() const { return _buffer[_tail]; }
-
-	uint8_t get_oldest_index() const { return _tail; }
+	const data_type &get_oldest() const { return _buffer[oldest()]; }
 
+	/**
+	 * Remove the newest sample which is at most 0.1s older than timestamp, along with all samples older than it.
+	 * @return true if such a sample was found and copied into sample
+	 */
 	bool pop_first_older_than(const uint64_t &timestamp, data_type *sample)
 	{
-		// start looking from newest observation data
-		for (uint8_t i = 0; i < _size; i++) {
-			int index = (_head - i);
-			index = index < 0 ? _size + index : index;
-
-			if (timestamp >= _buffer[index].time_us && timestamp < _buffer[index].time_us + (uint64_t)1e5) {
-				*sample = _buffer[index];
-
-				// Now we can set the tail to the item which
-				// comes after the one we removed since we don't
-				// want to have any older data in the buffer
-				if (index == _head) {
-					_tail = _head;
-					_first_write = true;
-
-				} else {
-					_tail = (index + 1) % _size;
-				}
+		if (_entries == 0) {
+			return false;
+		}
 
-				_buffer[index].time_us = 0;
+		if (_unordered > 0) {
+			// search from the newest sample
+			for (uint16_t count = _entries; count > 0; count--) {
+				const uint64_t time_us = _buffer[(oldest() + count - 1) & _mask].time_us;
 
-				return true;
+				if ((timestamp >= time_us) && (timestamp < time_us + (uint64_t)1e5)) {
+					pop(count, sample);
+					return true;
+				}
 			}
 
-			if (index == _tail) {
-				// we have reached the tail and haven't got a
-				// match
-				return false;
+			return false;
+		}
+
+		// binary search for the number of samples with time_us <= timestamp (samples are ordered by time)
+		uint16_t first = 0;
+		uint16_t count = _entries;
+
+		while (count > 0) {
+			const uint16_t step = count / 2;
+
+			if (_buffer[(oldest() + first + step) & _mask].time_us <= timestamp) {
+				first += step + 1;
+				count -= step + 1;
+
+			} else {
+				count = step;
 			}
 		}
 
-		return false;
+		if (first == 0) {
+			// all samples are newer
+			return false;
+		}
+
+		if (timestamp >= _buffer[(oldest() + first - 1) & _mask].time_us + (uint64_t)1e5) {
+			// the newest sample that qualifies is too old
+			return false;
+		}
+
+		pop(first, sample);
+
+		return true;
 	}
 
-	int get_total_size() const { return sizeof(*this) + sizeof(data_type) * _size; }
+	int get_total_size() const { return sizeof(*this) + sizeof(data_type) * (_mask + 1); }
 
 private:
-	data_type *_buffer{nullptr};
+	static constexpr uint16_t MAX_SIZE = 1 << 15;
 
-	uint8_t _head{0};
-	uint8_t _tail{0};
-	uint8_t _size{0};
+	uint16_t oldest() const { return (_entries > 0) ? ((_head - _entries + 1) & _mask) : _head; }
+
+	/**
+	 * Copy the sample at position count - 1 and remove it along with all older samples.
+	 */
+	void pop(uint16_t count, data_type *sample)
+	{
+		const uint16_t index = (oldest() + count - 1) & _mask;
+
+		*sample = _buffer[index];
+
+		// Now we can drop the sample and all older ones, since we don't want to have any older data in the buffer
+		_entries -= count;
+
+		if (_entries == 0) {
+			_head = index;
+			_unordered = 0;
+		}
+
+		_buffer[index].time_us = 0;
+	}
+
+	data_type *_buffer{nullptr};
 
-	bool _first_write{true};
+	uint16_t _head{0}; ///< index of the newest sample
+	uint16_t _entries{0}; ///< number of samples in the buffer
+	uint16_t _size{0}; ///< maximum number of samples
+	uint16_t _mask{0}; ///< storage size - 1
+	uint16_t _unordered{0}; ///< number of pushes until an out of order sample has left the buffer
 };
@@ -878,18 +878,14 @@ void Ekf::predictCovariance()
 		}
 	}
 
-	// covariance matrix is symmetrical, so copy upper half to lower half
-	for (unsigned row = 1; row < _k_num_states; row++) {
-		for (unsigned column = 0 ; column < row; column++) {
-			P(row, column) = P(column, row) = nextP(column, row);
+	// covariance matrix is symmetrical, only the upper half including the variances (diagonals)
+	// has been computed, copy it to both halves in a single pass
+	for (unsigned row = 0; row < _k_num_states; row++) {
+		for (unsigned column = row; column < _k_num_states; column++) {
+			P(row, column) = P(column, row) = nextP(row, column);
 		}
 	}
 
-	// copy variances (diagonals)
-	for (unsigned i = 0; i < _k_num_states; i++) {
-		P(i, i) = nextP(i, i);
-	}
-
 	// fix gross errors in the covariance matrix and ensure rows and
 	// columns for un-used states are zero
 	fixCovarianceErrors(false);
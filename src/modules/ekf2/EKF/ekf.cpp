@@ -462,17 +462,14 @@ void Ekf::applyCorrectionToVerticalOutputBuffer(float vert_vel_correction)
 {
 	// loop through the vertical output filter state history starting at the oldest and apply the corrections to the
 	// vert_vel states and propagate vert_vel_integ forward using the corrected vert_vel
-	uint8_t index = _output_vert_buffer.get_oldest_index();
+	const uint16_t size = _output_vert_buffer.get_length();
 
-	const uint8_t size = _output_vert_buffer.get_length();
-
-	for (uint8_t counter = 0; counter < (size - 1); counter++) {
-		const uint8_t index_next = (index + 1) % size;
+	for (uint16_t index = 0; index < (size - 1); index++) {
 		outputVert &current_state = _output_vert_buffer[index];
-		outputVert &next_state = _output_vert_buffer[index_next];
+		outputVert &next_state = _output_vert_buffer[index + 1];
 
 		// correct the velocity
-		if (counter == 0) {
+		if (index == 0) {
 			current_state.vert_vel += vert_vel_correction;
 		}
 
@@ -480,9 +477,6 @@ void Ekf::applyCorrectionToVerticalOutputBuffer(float vert_vel_correction)
 
 		// position is propagated forward using the corrected velocity and a trapezoidal integrator
 		next_state.vert_vel_integ = current_state.vert_vel_integ + (current_state.vert_vel + next_state.vert_vel) * 0.5f * next_state.dt;
-
-		// advance the index
-		index = (index + 1) % size;
 	}
 
 	// update output state to corrected values
@@ -500,7 +494,7 @@ void Ekf::applyCorrectionToVerticalOutputBuffer(float vert_vel_correction)
 void Ekf::applyCorrectionToOutputBuffer(const Vector3f &vel_correction, const Vector3f &pos_correction)
 {
 	// loop through the output filter state history and apply the corrections to the velocity and position states
-	for (uint8_t index = 0; index < _output_buffer.get_length(); index++) {
+	for (uint16_t index = 0; index < _output_buffer.get_length(); index++) {
 		// a constant velocity correction is applied
 		_output_buffer[index].vel += vel_correction;
 
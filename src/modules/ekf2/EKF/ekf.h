@@ -725,28 +725,29 @@ private:
 	Vector3f getVisionVelocityVarianceInEkfFrame() const;
 
 	// matrix vector multiplication for computing K<24,1> * H<1,24> * P<24,24>
-	// that is optimized by exploring the sparsity in H
+	// K*H*P is the outer product of K with the row vector H*P, which is computed
+	// only once and is optimized by exploring the sparsity in H
 	template <size_t ...Idxs>
 	SquareMatrix24f computeKHP(const Vector24f &K, const SparseVector24f<Idxs...> &H) const
 	{
-		SquareMatrix24f KHP;
-		constexpr size_t non_zeros = sizeof...(Idxs);
-		float KH[non_zeros];
+		float HP[_k_num_states];
+
+		for (unsigned column = 0; column < _k_num_states; column++) {
+			float tmp = 0.f;
 
-		for (unsigned row = 0; row < _k_num_states; row++) {
 			for (unsigned i = 0; i < H.non_zeros(); i++) {
-				KH[i] = K(row) * H.atCompressedIndex(i);
+				const size_t index = H.index(i);
+				tmp += H.atCompressedIndex(i) * P(index, column);
 			}
 
-			for (unsigned column = 0; column < _k_num_states; column++) {
-				float tmp = 0.f;
+			HP[column] = tmp;
+		}
 
-				for (unsigned i = 0; i < H.non_zeros(); i++) {
-					const size_t index = H.index(i);
-					tmp += KH[i] * P(index, column);
-				}
+		SquareMatrix24f KHP;
 
-				KHP(row, column) = tmp;
+		for (unsigned row = 0; row < _k_num_states; row++) {
+			for (unsigned column = 0; column < _k_num_states; column++) {
+				KHP(row, column) = K(row) * HP[column];
 			}
 		}
 
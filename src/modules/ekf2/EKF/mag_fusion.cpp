@@ -679,22 +679,22 @@ void Ekf::updateQuaternion(const float innovation, const float variance, const f
 	// apply covariance correction via P_new = (I -K*H)*P
 	// first calculate expression for KHP
 	// then calculate P - KHP
-	SquareMatrix24f KHP;
-	float KH[4];
+	// H only has non zero elements for the quaternion states, compute H*P once and use its outer product with K
+	float HP[_k_num_states];
 
-	for (unsigned row = 0; row < _k_num_states; row++) {
+	for (unsigned column = 0; column < _k_num_states; column++) {
+		float tmp = yaw_jacobian(0) * P(0, column);
+		tmp += yaw_jacobian(1) * P(1, column);
+		tmp += yaw_jacobian(2) * P(2, column);
+		tmp += yaw_jacobian(3) * P(3, column);
+		HP[column] = tmp;
+	}
 
-		KH[0] = Kfusion(row) * yaw_jacobian(0);
-		KH[1] = Kfusion(row) * yaw_jacobian(1);
-		KH[2] = Kfusion(row) * yaw_jacobian(2);
-		KH[3] = Kfusion(row) * yaw_jacobian(3);
+	SquareMatrix24f KHP;
 
+	for (unsigned row = 0; row < _k_num_states; row++) {
 		for (unsigned column = 0; column < _k_num_states; column++) {
-			float tmp = KH[0] * P(0, column);
-			tmp += KH[1] * P(1, column);
-			tmp += KH[2] * P(2, column);
-			tmp += KH[3] * P(3, column);
-			KHP(row, column) = tmp;
+			KHP(row, column) = Kfusion(row) * HP[column];
 		}
 	}
 
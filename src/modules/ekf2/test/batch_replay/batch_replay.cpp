@@ -0,0 +1,215 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2021 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "batch_replay.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <thread>
+
+#include "EKF/ekf.h"
+#include "sensor_simulator/sensor_simulator.h"
+#include "sensor_simulator/ekf_wrapper.h"
+
+namespace batch_replay
+{
+
+namespace
+{
+
+// replay step, the EKF fuses at most one measurement of each type per filter update (10 ms)
+constexpr uint32_t REPLAY_STEP_US = 10000;
+
+constexpr const char *innovation_names[INNOVATION_COUNT] = {
+	"gps_hvel",
+	"gps_vvel",
+	"gps_hpos",
+	"gps_vpos",
+	"baro_hgt",
+	"rng_hgt",
+	"mag",
+	"heading",
+	"airspeed",
+	"flow",
+};
+
+float norm(const float v[], int n)
+{
+	float sum_sq = 0.f;
+
+	for (int i = 0; i < n; i++) {
+		sum_sq += v[i] * v[i];
+	}
+
+	return sqrtf(sum_sq);
+}
+
+void sampleInnovations(const Ekf &ekf, InnovationStatistics innovations[])
+{
+	float hvel[2], vvel, hpos[2], vpos;
+	float hvel_ratio, vvel_ratio, hpos_ratio, vpos_ratio;
+	ekf.getGpsVelPosInnov(hvel, vvel, hpos, vpos);
+	ekf.getGpsVelPosInnovRatio(hvel_ratio, vvel_ratio, hpos_ratio, vpos_ratio);
+	innovations[GPS_HVEL].update(norm(hvel, 2), hvel_ratio);
+	innovations[GPS_VVEL].update(vvel, vvel_ratio);
+	innovations[GPS_HPOS].update(norm(hpos, 2), hpos_ratio);
+	innovations[GPS_VPOS].update(vpos, vpos_ratio);
+
+	float innov, ratio;
+	ekf.getBaroHgtInnov(innov);
+	ekf.getBaroHgtInnovRatio(ratio);
+	innovations[BARO_HGT].update(innov, ratio);
+
+	ekf.getRngHgtInnov(innov);
+	ekf.getRngHgtInnovRatio(ratio);
+	innovations[RNG_HGT].update(innov, ratio);
+
+	float mag[3];
+	ekf.getMagInnov(mag);
+	ekf.getMagInnovRatio(ratio);
+	innovations[MAG].update(norm(mag, 3), ratio);
+
+	ekf.getHeadingInnov(innov);
+	ekf.getHeadingInnovRatio(ratio);
+	innovations[HEADING].update(innov, ratio);
+
+	ekf.getAirspeedInnov(innov);
+	ekf.getAirspeedInnovRatio(ratio);
+	innovations[AIRSPEED].update(innov, ratio);
+
+	float flow[2];
+	ekf.getFlowInnov(flow);
+	ekf.getFlowInnovRatio(ratio);
+	innovations[FLOW].update(norm(flow, 2), ratio);
+}
+
+} // namespace
+
+void replayLog(const std::string &file_name, LogResult &result)
+{
+	// report a missing file explicitly rather than as a log without data
+	if (!std::ifstream(file_name).good()) {
+		result.error = "can not open file";
+		return;
+	}
+
+	std::shared_ptr<Ekf> ekf = std::make_shared<Ekf>();
+	SensorSimulator sensor_simulator(ekf);
+	EkfWrapper ekf_wrapper(ekf);
+
+	if (!sensor_simulator.loadSensorDataFromFile(file_name)) {
+		result.error = "malformed sensor data";
+		return;
+	}
+
+	if (sensor_simulator.isReplayFinished()) {
+		result.error = "no sensor data";
+		return;
+	}
+
+	// IMU, Baro and Mag are running by default, start the remaining sensors contained in the log
+	if (sensor_simulator.hasReplayData(sensor_info::GPS)) {
+		sensor_simulator.startGps();
+		ekf_wrapper.enableGpsFusion();
+	}
+
+	if (sensor_simulator.hasReplayData(sensor_info::AIRSPEED)) {
+		sensor_simulator.startAirspeedSensor();
+	}
+
+	if (sensor_simulator.hasReplayData(sensor_info::RANGE)) {
+		sensor_simulator.startRangeFinder();
+	}
+
+	if (sensor_simulator.hasReplayData(sensor_info::FLOW)) {
+		sensor_simulator.startFlow();
+		ekf_wrapper.enableFlowFusion();
+	}
+
+	while (!sensor_simulator.isReplayFinished()) {
+		if (!sensor_simulator.runReplayMicroseconds(REPLAY_STEP_US)) {
+			result.error = "replay failed";
+			return;
+		}
+
+		sampleInnovations(*ekf, result.innovations);
+	}
+
+	result.duration_s = sensor_simulator.getTime() * 1e-6f;
+}
+
+void writeSummary(std::ostream &out, const std::vector<std::string> &files, const std::vector<LogResult> &results)
+{
+	out << "log,innovation,samples,innov_rms,innov_max,test_ratio_mean,test_ratio_max,rejected_fraction" << std::endl;
+
+	for (size_t i = 0; i < files.size(); i++) {
+		for (int k = 0; k < INNOVATION_COUNT; k++) {
+			const InnovationStatistics &s = results[i].innovations[k];
+
+			if (s.samples == 0) {
+				continue;
+			}
+
+			out << files[i] << "," << innovation_names[k] << "," << s.samples << ","
+			    << std::sqrt(s.innov_sum_sq / s.samples) << "," << s.innov_max << ","
+			    << s.test_ratio_sum / s.samples << "," << s.test_ratio_max << ","
+			    << (double)s.rejected / s.samples << std::endl;
+		}
+	}
+}
+
+std::vector<LogResult> replayLogs(const std::vector<std::string> &files, unsigned jobs)
+{
+	std::vector<LogResult> results(files.size());
+	std::atomic<size_t> next_log{0};
+	std::vector<std::thread> workers;
+	jobs = std::max<size_t>(std::min<size_t>(jobs, files.size()), 1);
+
+	for (unsigned i = 0; i < jobs; i++) {
+		workers.emplace_back([&]() {
+			for (size_t log = next_log++; log < files.size(); log = next_log++) {
+				replayLog(files[log], results[log]);
+			}
+		});
+	}
+
+	for (std::thread &worker : workers) {
+		worker.join();
+	}
+
+	return results;
+}
+
+} // namespace batch_replay
@@ -0,0 +1,125 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2021 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * Faster than real-time batch replay of sensor data files.
+ *
+ * Each input file (as written by sensor_simulator/convertULogToSensorData.py)
+ * is replayed into its own Ekf instance without any uORB or scheduling in the
+ * loop. The files are distributed over a pool of worker threads, and a CSV
+ * summary with the innovation and test ratio statistics of every log is
+ * written once all logs have been processed.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace batch_replay
+{
+
+enum Innovation {
+	GPS_HVEL,
+	GPS_VVEL,
+	GPS_HPOS,
+	GPS_VPOS,
+	BARO_HGT,
+	RNG_HGT,
+	MAG,
+	HEADING,
+	AIRSPEED,
+	FLOW,
+	INNOVATION_COUNT
+};
+
+struct InnovationStatistics {
+	void update(float innov, float test_ratio)
+	{
+		// innovations are held between fusions, only count the ones that changed
+		if (test_ratio <= 0.f || (innov == last_innov && test_ratio == last_test_ratio)) {
+			return;
+		}
+
+		last_innov = innov;
+		last_test_ratio = test_ratio;
+
+		samples++;
+		innov_sum_sq += (double)innov * innov;
+		innov_max = std::max(innov_max, std::fabs(innov));
+		test_ratio_sum += test_ratio;
+		test_ratio_max = std::max(test_ratio_max, test_ratio);
+
+		if (test_ratio > 1.f) {
+			rejected++;
+		}
+	}
+
+	uint32_t samples{0};
+	uint32_t rejected{0};
+	double innov_sum_sq{0.0};
+	float innov_max{0.f};
+	double test_ratio_sum{0.0};
+	float test_ratio_max{0.f};
+
+	float last_innov{NAN};
+	float last_test_ratio{NAN};
+};
+
+struct LogResult {
+	std::string error{}; ///< empty if the log was replayed
+	float duration_s{0.f};
+	InnovationStatistics innovations[INNOVATION_COUNT] {};
+};
+
+/**
+ * Replay a single log. Errors (missing or malformed file) are reported in result.error.
+ */
+void replayLog(const std::string &file_name, LogResult &result);
+
+/**
+ * Replay all logs using up to jobs threads. A log that fails does not affect the others.
+ * @return one result per file
+ */
+std::vector<LogResult> replayLogs(const std::vector<std::string> &files, unsigned jobs);
+
+/**
+ * Write the CSV summary of all successfully replayed logs
+ */
+void writeSummary(std::ostream &out, const std::vector<std::string> &files, const std::vector<LogResult> &results);
+
+} // namespace batch_replay
@@ -0,0 +1,133 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2021 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * Command line front end of the batch replay.
+ *
+ * Usage: ekf2_batch_replay [-j jobs] [-o summary.csv] file.csv [file.csv ...]
+ */
+
+#include <getopt.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "batch_replay.h"
+
+using namespace batch_replay;
+
+namespace
+{
+
+void usage(const char *name)
+{
+	std::cerr << "Usage: " << name << " [-j jobs] [-o summary.csv] file.csv [file.csv ...]" << std::endl
+		  << "  -j  number of logs replayed in parallel (default: number of CPUs)" << std::endl
+		  << "  -o  write the summary to a file instead of stdout" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+	unsigned jobs = std::max(std::thread::hardware_concurrency(), 1u);
+	std::string output_file;
+	int ch;
+
+	while ((ch = getopt(argc, argv, "j:o:h")) != -1) {
+		switch (ch) {
+		case 'j':
+			jobs = std::max(atoi(optarg), 1);
+			break;
+
+		case 'o':
+			output_file = optarg;
+			break;
+
+		default:
+			usage(argv[0]);
+			return 1;
+		}
+	}
+
+	std::vector<std::string> files(argv + optind, argv + argc);
+
+	if (files.empty()) {
+		usage(argv[0]);
+		return 1;
+	}
+
+	jobs = std::min<size_t>(jobs, files.size());
+
+	const auto start = std::chrono::steady_clock::now();
+	const std::vector<LogResult> results = replayLogs(files, jobs);
+
+	const float wall_time_s = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+
+	float duration_s = 0.f;
+	int failed = 0;
+
+	for (size_t i = 0; i < files.size(); i++) {
+		if (!results[i].error.empty()) {
+			std::cerr << files[i] << ": " << results[i].error << std::endl;
+			failed++;
+
+		} else {
+			duration_s += results[i].duration_s;
+		}
+	}
+
+	if (output_file.empty()) {
+		writeSummary(std::cout, files, results);
+
+	} else {
+		std::ofstream out(output_file);
+
+		if (!out) {
+			std::cerr << "can not open " << output_file << std::endl;
+			return 1;
+		}
+
+		writeSummary(out, files, results);
+	}
+
+	std::cerr << "replayed " << files.size() - failed << " of " << files.size() << " logs (" << duration_s << " s of data) in "
+		  << wall_time_s << " s using " << jobs << " threads" << std::endl;
+
+	return failed > 0 ? 1 : 0;
+}
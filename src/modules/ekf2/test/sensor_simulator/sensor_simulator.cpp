@@ -17,94 +17,110 @@ SensorSimulator::SensorSimulator(std::shared_ptr<Ekf> ekf):
 	startBasicSensor();
 }
 
-void SensorSimulator::loadSensorDataFromFile(std::string file_name)
+bool SensorSimulator::loadSensorDataFromFile(std::string file_name)
 {
 	std::ifstream file(file_name);
 	std::string line;
 
-	while (!file.eof()) {
-		std::string timestamp;
-		std::string sensor_type;
-		std::string sensor_data;
-		sensor_info sensor_sample;
+	_replay_data.clear();
+	_current_replay_data_index = 0;
+	_has_replay_data = false;
 
-		getline(file, timestamp, ',');
+	try {
+		while (!file.eof()) {
+			std::string timestamp;
+			std::string sensor_type;
+			std::string sensor_data;
+			sensor_info sensor_sample;
 
-		if (!timestamp.compare("")) { // empty line at end of file
-			break;
-		}
+			getline(file, timestamp, ',');
+
+			if (!timestamp.compare("")) { // empty line at end of file
+				break;
+			}
 
-		sensor_sample.timestamp = std::stoul(timestamp);
+			sensor_sample.timestamp = std::stoul(timestamp);
 
-		if (_replay_data.size() > 0) {
-			sensor_info last_sample = _replay_data.back();
+			if (_replay_data.size() > 0) {
+				sensor_info last_sample = _replay_data.back();
 
-			if (sensor_sample.timestamp < last_sample.timestamp) {
-				std::cout << "Timestamps not sorted ascendingly" << std::endl;
-				system_exit(-1);
+				if (sensor_sample.timestamp < last_sample.timestamp) {
+					std::cout << "Timestamps not sorted ascendingly" << std::endl;
+					_replay_data.clear();
+					return false;
+				}
 			}
-		}
 
-		getline(file, sensor_type, ',');
+			getline(file, sensor_type, ',');
 
-		if (!sensor_type.compare("imu")) {
-			sensor_sample.sensor_type = sensor_info::IMU;
+			if (!sensor_type.compare("imu")) {
+				sensor_sample.sensor_type = sensor_info::IMU;
 
-		} else if (!sensor_type.compare("mag")) {
-			sensor_sample.sensor_type = sensor_info::MAG;
+			} else if (!sensor_type.compare("mag")) {
+				sensor_sample.sensor_type = sensor_info::MAG;
 
-		} else if (!sensor_type.compare("baro")) {
-			sensor_sample.sensor_type = sensor_info::BARO;
+			} else if (!sensor_type.compare("baro")) {
+				sensor_sample.sensor_type = sensor_info::BARO;
 
-		} else if (!sensor_type.compare("gps")) {
-			sensor_sample.sensor_type = sensor_info::GPS;
+			} else if (!sensor_type.compare("gps")) {
+				sensor_sample.sensor_type = sensor_info::GPS;
 
-		} else if (!sensor_type.compare("airspeed")) {
-			sensor_sample.sensor_type = sensor_info::AIRSPEED;
+			} else if (!sensor_type.compare("airspeed")) {
+				sensor_sample.sensor_type = sensor_info::AIRSPEED;
 
-		} else if (!sensor_type.compare("range")) {
-			sensor_sample.sensor_type = sensor_info::RANGE;
+			} else if (!sensor_type.compare("range")) {
+				sensor_sample.sensor_type = sensor_info::RANGE;
 
-		} else if (!sensor_type.compare("flow")) {
-			sensor_sample.sensor_type = sensor_info::FLOW;
+			} else if (!sensor_type.compare("flow")) {
+				sensor_sample.sensor_type = sensor_info::FLOW;
 
-		} else if (!sensor_type.compare("vio")) {
-			sensor_sample.sensor_type = sensor_info::VISION;
+			} else if (!sensor_type.compare("vio")) {
+				sensor_sample.sensor_type = sensor_info::VISION;
 
-		} else if (!sensor_type.compare("landed")) {
-			sensor_sample.sensor_type = sensor_info::LANDING_STATUS;
+			} else if (!sensor_type.compare("landed")) {
+				sensor_sample.sensor_type = sensor_info::LANDING_STATUS;
 
-		} else {
-			std::cout << "Sensor type in file unknown" << std::endl;
-			system_exit(-1);
-		}
+			} else {
+				std::cout << "Sensor type in file unknown" << std::endl;
+				_replay_data.clear();
+				return false;
+			}
 
-		getline(file, sensor_data);
-		std::stringstream ss(sensor_data);
-		int8_t i = 0;
+			getline(file, sensor_data);
+			std::stringstream ss(sensor_data);
+			int8_t i = 0;
 
-		while (ss.good()) {
-			if (i >= 10) {
-				std::cout << "sensor data bigger than expected" << std::endl;
-				system_exit(-1);
-			}
+			while (ss.good()) {
+				if (i >= 10) {
+					std::cout << "sensor data bigger than expected" << std::endl;
+					_replay_data.clear();
+					return false;
+				}
 
-			std::string value_string;
-			getline(ss, value_string, ',');
+				std::string value_string;
+				getline(ss, value_string, ',');
 
-			if (!value_string.compare("")) {
-				continue;
+				if (!value_string.compare("")) {
+					continue;
+				}
+
+				sensor_sample.sensor_data[i] = std::stod(value_string);
+				i++;
 			}
 
-			sensor_sample.sensor_data[i] = std::stod(value_string);
-			i++;
+			_replay_data.emplace_back(sensor_sample);
 		}
 
-		_replay_data.emplace_back(sensor_sample);
+	} catch (const std::exception &e) {
+		// std::stoul / std::stod on a malformed number
+		std::cout << "Malformed sensor data: " << e.what() << std::endl;
+		_replay_data.clear();
+		return false;
 	}
 
 	file.close();
 	_has_replay_data = true;
+	return true;
 }
 
 void SensorSimulator::setSensorRateToDefault()
@@ -171,16 +187,16 @@ void SensorSimulator::updateSensors()
 	_airspeed.update(_time);
 }
 
-void SensorSimulator::runReplaySeconds(float duration_seconds)
+bool SensorSimulator::runReplaySeconds(float duration_seconds)
 {
-	runReplayMicroseconds(uint32_t(duration_seconds * 1e6f));
+	return runReplayMicroseconds(uint32_t(duration_seconds * 1e6f));
 }
 
-void SensorSimulator::runReplayMicroseconds(uint32_t duration)
+bool SensorSimulator::runReplayMicroseconds(uint32_t duration)
 {
-	if (!_has_replay_data) {
+	if (!_has_replay_data || _replay_data.empty()) {
 		std::cout << "Can not run replay without replay data" << std::endl;
-		system_exit(-1);
+		return false;
 	}
 
 	// simulate in 1000us steps
@@ -196,29 +212,27 @@ void SensorSimulator::runReplayMicroseconds(uint32_t duration)
 			_ekf->update();
 		}
 	}
+
+	return true;
 }
 
-void SensorSimulator::setSensorDataFromReplayData()
+bool SensorSimulator::hasReplayData(sensor_info::measurement_t sensor_type) const
 {
-	if (_replay_data.size() > 0) {
-		sensor_info sample = _replay_data[_current_replay_data_index];
-
-		while (sample.timestamp < _time) {
-			setSingleReplaySample(sample);
-
-			if (_current_replay_data_index < _replay_data.size()) {
-				_current_replay_data_index ++;
-
-			} else {
-				break;
-			}
-
-			sample = _replay_data[_current_replay_data_index];
+	for (const sensor_info &sample : _replay_data) {
+		if (sample.sensor_type == sensor_type) {
+			return true;
 		}
+	}
 
-	} else {
-		std::cerr << "Loaded replay data empty. Likely could not load replay data" << std::endl;
-		system_exit(-1);
+	return false;
+}
+
+void SensorSimulator::setSensorDataFromReplayData()
+{
+	while (_current_replay_data_index < _replay_data.size()
+	       && _replay_data[_current_replay_data_index].timestamp < _time) {
+		setSingleReplaySample(_replay_data[_current_replay_data_index]);
+		_current_replay_data_index++;
 	}
 }
 
@@ -81,8 +81,9 @@ public:
 	void runSeconds(float duration_seconds);
 	void runMicroseconds(uint32_t duration);
 
-	void runReplaySeconds(float duration_seconds);
-	void runReplayMicroseconds(uint32_t duration);
+	// return false if no replay data is loaded
+	bool runReplaySeconds(float duration_seconds);
+	bool runReplayMicroseconds(uint32_t duration);
 
 	void setTrajectoryTargetVelocity(const Vector3f &velocity_target);
 	void runTrajectorySeconds(float duration_seconds);
@@ -116,7 +117,10 @@ public:
 	void setOrientation(const Quatf &orientation) { _R_body_to_world = Dcmf(orientation); }
 	void setOrientation(const Dcmf &orientation) { _R_body_to_world = orientation; }
 
-	void loadSensorDataFromFile(std::string filename);
+	// return false if the file is malformed, no replay data is loaded in that case
+	bool loadSensorDataFromFile(std::string filename);
+	bool hasReplayData(sensor_info::measurement_t sensor_type) const;
+	bool isReplayFinished() const { return _current_replay_data_index >= _replay_data.size(); }
 
 	Airspeed    _airspeed;
 	Baro        _baro;
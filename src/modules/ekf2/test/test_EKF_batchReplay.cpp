@@ -0,0 +1,87 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2019 ECL Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include "batch_replay/batch_replay.h"
+
+using namespace batch_replay;
+
+class EkfBatchReplayTest : public ::testing::Test
+{
+public:
+	void SetUp() override
+	{
+		// timestamps going backwards, rejected by the loader
+		std::ofstream corrupt(_corrupt_log);
+		corrupt << "4000,imu,0,0,-9.81,0,0,0" << std::endl
+			<< "2000,imu,0,0,-9.81,0,0,0" << std::endl;
+	}
+
+	void TearDown() override
+	{
+		std::remove(_corrupt_log.c_str());
+	}
+
+	const std::string _valid_log{TEST_DATA_PATH"/replay_data/iris_gps.csv"};
+	const std::string _corrupt_log{"ekf_batch_replay_corrupt.csv"};
+};
+
+TEST_F(EkfBatchReplayTest, corruptLogDoesNotAbortBatch)
+{
+	const std::vector<std::string> files{_valid_log, _corrupt_log};
+	const std::vector<LogResult> results = replayLogs(files, 2);
+
+	ASSERT_EQ(results.size(), files.size());
+
+	// THEN: the valid log is replayed completely and only the corrupt log reports an error
+	EXPECT_TRUE(results[0].error.empty());
+	EXPECT_GT(results[0].duration_s, 30.f);
+	EXPECT_GT(results[0].innovations[GPS_HPOS].samples, 0u);
+	EXPECT_FALSE(results[1].error.empty());
+
+	// AND: the summary only contains the valid log
+	std::stringstream summary;
+	writeSummary(summary, files, results);
+	EXPECT_NE(summary.str().find(_valid_log), std::string::npos);
+	EXPECT_EQ(summary.str().find(_corrupt_log), std::string::npos);
+}
+
+TEST_F(EkfBatchReplayTest, missingLog)
+{
+	LogResult result;
+	replayLog("does_not_exist.csv", result);
+	EXPECT_FALSE(result.error.empty());
+}
@@ -33,6 +33,7 @@
 
 #include <gtest/gtest.h>
 #include <math.h>
+#include <deque>
 #include "EKF/ekf.h"
 
 struct sample {
@@ -79,10 +80,8 @@ TEST_F(EkfRingBufferTest, badInitialisation)
 {
 	// WHEN: buffer allocation input is bad
 	// THEN: allocation should fail
-
-	// TODO: Change buffer implementation to pass this test
-	// ASSERT_EQ(false, _buffer->allocate(-1));
-	// ASSERT_EQ(false, _buffer->allocate(0));
+	ASSERT_EQ(false, _buffer->allocate(-1));
+	ASSERT_EQ(false, _buffer->allocate(0));
 }
 
 TEST_F(EkfRingBufferTest, orderOfSamples)
@@ -158,3 +157,145 @@ TEST_F(EkfRingBufferTest, reallocateBuffer)
 	EXPECT_EQ(3, _buffer->get_length());
 
 }
+
+TEST_F(EkfRingBufferTest, keepRequestedLength)
+{
+	// GIVEN: a buffer with a length that is not a power of two
+	ASSERT_EQ(true, _buffer->allocate(5));
+
+	// WHEN: pushing more samples than its length
+	for (uint64_t i = 1; i <= 12; i++) {
+		sample s = _x;
+		s.time_us = i * 10000;
+		_buffer->push(s);
+	}
+
+	// THEN: only the newest samples of the requested length are kept, in order
+	EXPECT_EQ(5, _buffer->get_length());
+	EXPECT_EQ(80000u, _buffer->get_oldest().time_us);
+	EXPECT_EQ(120000u, _buffer->get_newest().time_us);
+
+	for (uint16_t i = 0; i < 5; i++) {
+		EXPECT_EQ((8 + i) * 10000u, (*_buffer)[i].time_us);
+	}
+}
+
+TEST_F(EkfRingBufferTest, popDropsOlderSamples)
+{
+	ASSERT_EQ(true, _buffer->allocate(6));
+
+	for (uint64_t i = 1; i <= 9; i++) {
+		sample s = _x;
+		s.time_us = i * 10000;
+		_buffer->push(s);
+	}
+
+	// GIVEN: a wrapped around buffer holding the samples 40ms to 90ms
+	sample pop = {};
+
+	// WHEN: popping at a time between two samples
+	// THEN: we get the newest sample older than the time, and the older ones are gone
+	EXPECT_EQ(true, _buffer->pop_first_older_than(65000, &pop));
+	EXPECT_EQ(60000u, pop.time_us);
+	EXPECT_EQ(70000u, _buffer->get_oldest().time_us);
+	EXPECT_EQ(false, _buffer->pop_first_older_than(65000, &pop));
+
+	// WHEN: the buffer was emptied by a pop
+	EXPECT_EQ(true, _buffer->pop_first_older_than(95000, &pop));
+	EXPECT_EQ(90000u, pop.time_us);
+	EXPECT_EQ(false, _buffer->pop_first_older_than(95000, &pop));
+
+	// THEN: new samples are buffered as usual
+	sample s = _x;
+	s.time_us = 100000;
+	_buffer->push(s);
+	EXPECT_EQ(100000u, _buffer->get_oldest().time_us);
+	EXPECT_EQ(100000u, _buffer->get_newest().time_us);
+	EXPECT_EQ(true, _buffer->pop_first_older_than(100000, &pop));
+	EXPECT_EQ(100000u, pop.time_us);
+}
+
+TEST_F(EkfRingBufferTest, outOfOrderSample)
+{
+	ASSERT_EQ(true, _buffer->allocate(5));
+
+	// GIVEN: a buffer with a sample that was pushed out of order
+	for (uint64_t time_us : {10000, 20000, 40000, 30000, 50000}) {
+		sample s = _x;
+		s.time_us = time_us;
+		_buffer->push(s);
+	}
+
+	sample pop = {};
+
+	// WHEN: popping at a time after the out of order sample
+	// THEN: we get the newest matching sample in buffer order, and the ones pushed before it are gone
+	EXPECT_EQ(true, _buffer->pop_first_older_than(35000, &pop));
+	EXPECT_EQ(30000u, pop.time_us);
+	EXPECT_EQ(50000u, _buffer->get_oldest().time_us);
+	EXPECT_EQ(false, _buffer->pop_first_older_than(45000, &pop));
+
+	// WHEN: the out of order sample has left the buffer
+	for (uint64_t i = 6; i <= 10; i++) {
+		sample s = _x;
+		s.time_us = i * 10000;
+		_buffer->push(s);
+	}
+
+	// THEN: popping works as before
+	EXPECT_EQ(true, _buffer->pop_first_older_than(85000, &pop));
+	EXPECT_EQ(80000u, pop.time_us);
+	EXPECT_EQ(90000u, _buffer->get_oldest().time_us);
+}
+
+TEST_F(EkfRingBufferTest, largeBuffer)
+{
+	// GIVEN: a buffer longer than 255 samples with irregular sample intervals
+	const uint16_t length = 1000;
+	ASSERT_EQ(true, _buffer->allocate(length));
+
+	std::deque<uint64_t> buffered;
+	uint64_t time_us = 0;
+
+	for (int i = 0; i < 1500; i++) {
+		time_us += 1000 + (i % 7) * 500;
+		sample s = _x;
+		s.time_us = time_us;
+		_buffer->push(s);
+
+		buffered.push_back(time_us);
+
+		if (buffered.size() > length) {
+			buffered.pop_front();
+		}
+	}
+
+	EXPECT_EQ(length, _buffer->get_length());
+	EXPECT_EQ(buffered.front(), _buffer->get_oldest().time_us);
+
+	// WHEN: popping at increasing times
+	// THEN: the result matches a linear search from the newest sample
+	for (uint64_t query = buffered.front() - 5000; query < time_us + 200000; query += 7777) {
+		bool expected = false;
+		uint64_t expected_time_us = 0;
+
+		for (auto it = buffered.rbegin(); it != buffered.rend(); ++it) {
+			if (*it <= query) {
+				if (query < *it + 100000) {
+					expected = true;
+					expected_time_us = *it;
+					buffered.erase(buffered.begin(), it.base());
+				}
+
+				break;
+			}
+		}
+
+		sample pop = {};
+		ASSERT_EQ(expected, _buffer->pop_first_older_than(query, &pop));
+
+		if (expected) {
+			EXPECT_EQ(expected_time_us, pop.time_us);
+		}
+	}
+}
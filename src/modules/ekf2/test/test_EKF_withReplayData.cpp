@@ -56,7 +56,7 @@ public:
 
 TEST_F(EkfReplayTest, irisGps)
 {
-	_sensor_simulator.loadSensorDataFromFile(TEST_DATA_PATH"/replay_data/iris_gps.csv");
+	ASSERT_TRUE(_sensor_simulator.loadSensorDataFromFile(TEST_DATA_PATH"/replay_data/iris_gps.csv"));
 	_ekf_logger.setFilePath(TEST_DATA_PATH"/change_indication/iris_gps.csv");
 
 	// Start simulation and enable fusion of additional sensor types here
@@ -67,14 +67,14 @@ TEST_F(EkfReplayTest, irisGps)
 	uint8_t logging_rate_hz = 10;
 
 	for (int i = 0; i < 35 * logging_rate_hz; ++i) {
-		_sensor_simulator.runReplaySeconds(1.0f / logging_rate_hz);
+		ASSERT_TRUE(_sensor_simulator.runReplaySeconds(1.0f / logging_rate_hz));
 		_ekf_logger.writeStateToFile();
 	}
 }
 
 TEST_F(EkfReplayTest, ekfGsfReset)
 {
-	_sensor_simulator.loadSensorDataFromFile(TEST_DATA_PATH"/replay_data/ekf_gsf_reset.csv");
+	ASSERT_TRUE(_sensor_simulator.loadSensorDataFromFile(TEST_DATA_PATH"/replay_data/ekf_gsf_reset.csv"));
 	_ekf_logger.setFilePath(TEST_DATA_PATH"/change_indication/ekf_gsf_reset.csv");
 
 	// Start simulation and enable fusion of additional sensor types here
@@ -88,7 +88,7 @@ TEST_F(EkfReplayTest, ekfGsfReset)
 	uint8_t logging_rate_hz = 10;
 
 	for (int i = 0; i < 39 * logging_rate_hz; ++i) {
-		_sensor_simulator.runReplaySeconds(1.0f / logging_rate_hz);
+		ASSERT_TRUE(_sensor_simulator.runReplaySeconds(1.0f / logging_rate_hz));
 		_ekf_logger.writeStateToFile();
 	}
 }
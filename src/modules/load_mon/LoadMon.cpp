@@ -101,6 +101,8 @@ void LoadMon::Run()
 
 	cpuload();
 
+	work_item_latency();
+
 #if defined(__PX4_NUTTX)
 
 	if (_param_sys_stck_en.get()) {
@@ -238,6 +240,26 @@ void LoadMon::cpuload()
 #endif
 }
 
+void LoadMon::work_item_latency()
+{
+	px4::LatencyHistogram histogram;
+	work_item_latency_s report{};
+	static_assert(sizeof(report.buckets) / sizeof(report.buckets[0]) == px4::LatencyHistogram::NUM_BUCKETS,
+		      "work_item_latency.buckets must match LatencyHistogram::NUM_BUCKETS");
+
+	for (unsigned i = 0; px4::WorkItemLatencyHistogram(i, report.item_name, sizeof(report.item_name), histogram);
+	     i++) {
+
+		report.count = histogram.count;
+		report.latency_mean_us = histogram.latency_mean_us();
+		report.latency_max_us = histogram.latency_max_us;
+		memcpy(report.buckets, histogram.buckets, sizeof(report.buckets));
+		report.timestamp = hrt_absolute_time();
+
+		_work_item_latency_pub.publish(report);
+	}
+}
+
 #if defined(__PX4_NUTTX)
 void LoadMon::stack_usage()
 {
@@ -306,6 +328,8 @@ int LoadMon::print_usage(const char *reason)
 Background process running periodically on the low priority work queue to calculate the CPU load and RAM
 usage and publish the `cpuload` topic.
 
+It also publishes the scheduling latency of WorkItems with latency recording enabled (`work_item_latency`, see SYS_WQ_LATENCY).
+
 On NuttX it also checks the stack usage of each process and if it falls below 300 bytes, a warning is output,
 which will also appear in the log file.
 )DESCR_STR");
@@ -47,6 +47,7 @@
 #include <uORB/Publication.hpp>
 #include <uORB/topics/cpuload.h>
 #include <uORB/topics/task_stack_info.h>
+#include <uORB/topics/work_item_latency.h>
 
 #if defined(__PX4_LINUX)
 #include <sys/times.h>
@@ -81,6 +82,9 @@ private:
 	/** Do a calculation of the CPU load and publish it. */
 	void cpuload();
 
+	/** Publish the scheduling latency of all WorkItems with latency recording enabled. */
+	void work_item_latency();
+
 	/* Stack check only available on Nuttx */
 #if defined(__PX4_NUTTX)
 	/* Calculate stack usage */
@@ -91,6 +95,7 @@ private:
 	uORB::Publication<task_stack_info_s> _task_stack_info_pub{ORB_ID(task_stack_info)};
 #endif
 	uORB::Publication<cpuload_s> _cpuload_pub {ORB_ID(cpuload)};
+	uORB::Publication<work_item_latency_s> _work_item_latency_pub{ORB_ID(work_item_latency)};
 
 #if defined(__PX4_LINUX)
 	FILE *_proc_fd = nullptr;
@@ -38,3 +38,16 @@
  * @group System
  */
 PARAM_DEFINE_INT32(SYS_STCK_EN, 1);
+
+/**
+ * Record work queue scheduling latency
+ *
+ * Record the scheduling latency of the gyro to actuator path (vehicle_angular_velocity,
+ * mc_rate_control, control_allocator). The statistics are shown by 'work_queue status'
+ * and published as work_item_latency.
+ *
+ * @boolean
+ * @reboot_required true
+ * @group System
+ */
+PARAM_DEFINE_INT32(SYS_WQ_LATENCY, 0);
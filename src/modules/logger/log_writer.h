@@ -138,6 +138,38 @@ public:
 		return 0;
 	}
 
+	size_t get_io_pending_bytes_file(LogType type) const
+	{
+		if (_log_writer_file) { return _log_writer_file->get_io_pending_bytes(type); }
+
+		return 0;
+	}
+
+	uint32_t get_io_stalls_file(LogType type) const
+	{
+		if (_log_writer_file) { return _log_writer_file->get_io_stalls(type); }
+
+		return 0;
+	}
+
+	void set_async_io(bool enable)
+	{
+		if (_log_writer_file) { _log_writer_file->set_async_io(enable); }
+	}
+
+	void set_compression(bool enable)
+	{
+		if (_log_writer_file) { _log_writer_file->set_compression(enable); }
+	}
+
+	bool get_compression_stats_file(LogType type, uint64_t &raw_bytes, uint64_t &compressed_bytes,
+					hrt_abstime &cpu_time) const
+	{
+		if (_log_writer_file) { return _log_writer_file->get_compression_stats(type, raw_bytes, compressed_bytes, cpu_time); }
+
+		return false;
+	}
+
 	pthread_t thread_id_file() const
 	{
 		if (_log_writer_file) { return _log_writer_file->thread_id(); }
@@ -246,7 +246,13 @@ void LogWriterFile::start_log(LogType type, const char *filename)
 
 #endif
 
-	if (_buffers[(int)type].start_log(filename)) {
+	bool compress = _compress && type == LogType::Full;
+#if defined(PX4_CRYPTO)
+	// encrypted data does not compress
+	compress = compress && _algorithm == CRYPTO_NONE;
+#endif
+
+	if (_buffers[(int)type].start_log(filename, _async_io && type == LogType::Full, compress)) {
 		PX4_INFO("Opened %s log file: %s", log_type_str(type), filename);
 		notify();
 	}
@@ -579,10 +585,11 @@ LogWriterFile::LogFileBuffer::LogFileBuffer(size_t log_buffer_size, perf_counter
 LogWriterFile::LogFileBuffer::~LogFileBuffer()
 {
 	if (_fd >= 0) {
-		close(_fd);
+		close_fd();
 	}
 
 	free(_buffer);
+	delete _frame_writer;
 
 	perf_free(_perf_write);
 	perf_free(_perf_fsync);
@@ -629,9 +636,28 @@ size_t LogWriterFile::LogFileBuffer::get_read_ptr(void **ptr, bool *is_part)
 	}
 }
 
-bool LogWriterFile::LogFileBuffer::start_log(const char *filename)
+bool LogWriterFile::LogFileBuffer::start_log(const char *filename, bool async_io, bool compress)
 {
-	_fd = ::open(filename, O_CREAT | O_WRONLY, PX4_O_MODE_666);
+#if defined(__PX4_LINUX)
+
+	if (async_io) {
+		if (_async_file.open(filename)) {
+			_fd = _async_file.fd();
+			PX4_INFO("using %s file writes",
+				 _async_file.mode() == AsyncFileWriter::Mode::IoUring ? "io_uring" : "O_DIRECT");
+
+		} else {
+			PX4_WARN("asynchronous file writes not supported (%i), falling back to buffered writes", errno);
+		}
+	}
+
+#else
+	(void)async_io;
+#endif /* __PX4_LINUX */
+
+	if (_fd < 0) {
+		_fd = ::open(filename, O_CREAT | O_WRONLY, PX4_O_MODE_666);
+	}
 
 	if (_fd < 0) {
 		PX4_ERR("Can't open log file %s, errno: %d", filename, errno);
@@ -643,8 +669,7 @@ bool LogWriterFile::LogFileBuffer::start_log(const char *filename)
 
 		if (_buffer == nullptr) {
 			PX4_ERR("Can't create log buffer");
-			::close(_fd);
-			_fd = -1;
+			close_fd();
 			return false;
 		}
 	}
@@ -654,22 +679,103 @@ bool LogWriterFile::LogFileBuffer::start_log(const char *filename)
 	_count = 0;
 	_total_written = 0;
 
+	_compress = false;
+
+	if (compress) {
+		if (_frame_writer == nullptr) {
+			_frame_writer = new ulog_compression::FrameWriter(write_frame_data, this, hrt_absolute_time);
+		}
+
+		if (_frame_writer && _frame_writer->encoder().init()) {
+			_frame_writer->reset();
+
+			ulog_compression::file_header_s header;
+			_frame_writer->encoder().fill_file_header(header, hrt_absolute_time());
+
+			if (write_raw(&header, sizeof(header)) != sizeof(header)) {
+				PX4_ERR("Can't write log file header");
+				close_fd();
+				return false;
+			}
+
+			_compress = true;
+
+		} else {
+			PX4_ERR("Can't create compression buffers, logging uncompressed");
+		}
+	}
+
 	_should_run = true;
 
 	return true;
 }
 
-void LogWriterFile::LogFileBuffer::fsync() const
+void LogWriterFile::LogFileBuffer::fsync()
 {
+	// flush the partial frame, so that at most one fsync interval of data is lost on a crash
+	if (_compress) {
+		_frame_writer->flush();
+	}
+
 	perf_begin(_perf_fsync);
-	::fsync(_fd);
+#if defined(__PX4_LINUX)
+
+	if (_async_file.is_open()) {
+		_async_file.sync();
+
+	} else
+#endif /* __PX4_LINUX */
+	{
+		::fsync(_fd);
+	}
+
 	perf_end(_perf_fsync);
 }
 
-ssize_t LogWriterFile::LogFileBuffer::write_to_file(const void *buffer, size_t size, bool call_fsync) const
+ssize_t LogWriterFile::LogFileBuffer::write_raw(const void *buffer, size_t size)
+{
+#if defined(__PX4_LINUX)
+
+	if (_async_file.is_open()) {
+		return _async_file.write(buffer, size);
+	}
+
+#endif /* __PX4_LINUX */
+
+	return ::write(_fd, buffer, size);
+}
+
+ssize_t LogWriterFile::LogFileBuffer::write_frame_data(void *context, const void *buffer, size_t size)
+{
+	return static_cast<LogFileBuffer *>(context)->write_raw(buffer, size);
+}
+
+bool LogWriterFile::LogFileBuffer::compression_stats(uint64_t &raw_bytes, uint64_t &compressed_bytes,
+		hrt_abstime &cpu_time) const
+{
+	if (!_compress) {
+		return false;
+	}
+
+	raw_bytes = _frame_writer->encoder().raw_bytes();
+	compressed_bytes = _frame_writer->encoder().encoded_bytes() + sizeof(ulog_compression::file_header_s);
+	cpu_time = _frame_writer->compress_time();
+	return true;
+}
+
+ssize_t LogWriterFile::LogFileBuffer::write_to_file(const void *buffer, size_t size, bool call_fsync)
 {
 	perf_begin(_perf_write);
-	ssize_t ret = ::write(_fd, buffer, size);
+	ssize_t ret;
+
+	if (_compress) {
+		// data of a frame that fails to be written counts as written, the frame is retried with the next call
+		ret = _frame_writer->write(buffer, size);
+
+	} else {
+		ret = write_raw(buffer, size);
+	}
+
 	perf_end(_perf_write);
 
 	if (call_fsync) {
@@ -679,14 +785,36 @@ ssize_t LogWriterFile::LogFileBuffer::write_to_file(const void *buffer, size_t s
 	return ret;
 }
 
+int LogWriterFile::LogFileBuffer::close_fd()
+{
+	int ret;
+#if defined(__PX4_LINUX)
+
+	if (_async_file.is_open()) {
+		// flushes the staged data and truncates the file to its actual size
+		ret = _async_file.close();
+
+	} else
+#endif /* __PX4_LINUX */
+	{
+		ret = ::close(_fd);
+	}
+
+	_fd = -1;
+	return ret;
+}
+
 void LogWriterFile::LogFileBuffer::close_file()
 {
 	_head = 0;
 	_count = 0;
 
+	if (_fd >= 0 && _compress && _frame_writer->flush() != 0) {
+		PX4_ERR("writing the last compressed frame failed (%i)", errno);
+	}
+
 	if (_fd >= 0) {
-		int res = close(_fd);
-		_fd = -1;
+		int res = close_fd();
 
 		if (res) {
 			PX4_WARN("closing log file failed (%i)", errno);
@@ -40,6 +40,10 @@
 #include <perf/perf_counter.h>
 #include <px4_platform_common/crypto.h>
 
+#include <lib/ulog_compression/ulog_compression.h>
+
+#include "log_writer_file_async.h"
+
 namespace px4
 {
 namespace logger
@@ -117,6 +121,46 @@ public:
 		return _buffers[(int)type].count();
 	}
 
+	/** bytes accepted by the asynchronous file backend, but not yet on storage */
+	size_t get_io_pending_bytes(LogType type) const
+	{
+		return _buffers[(int)type].io_pending_bytes();
+	}
+
+	/** number of times the asynchronous file backend had to wait for storage */
+	uint32_t get_io_stalls(LogType type) const
+	{
+		return _buffers[(int)type].io_stalls();
+	}
+
+	/**
+	 * Use the asynchronous (O_DIRECT/io_uring) file backend for subsequently started logs, if supported.
+	 */
+	void set_async_io(bool enable)
+	{
+		_async_io = enable;
+	}
+
+	/**
+	 * Write the full log as compressed ULog stream for subsequently started logs.
+	 */
+	void set_compression(bool enable)
+	{
+		_compress = enable;
+	}
+
+	/**
+	 * get compression statistics of the current log
+	 * @param raw_bytes uncompressed bytes
+	 * @param compressed_bytes bytes written to the file
+	 * @param cpu_time time spent compressing [us]
+	 * @return false if the log is not compressed
+	 */
+	bool get_compression_stats(LogType type, uint64_t &raw_bytes, uint64_t &compressed_bytes, hrt_abstime &cpu_time) const
+	{
+		return _buffers[(int)type].compression_stats(raw_bytes, compressed_bytes, cpu_time);
+	}
+
 	void set_need_reliable_transfer(bool need_reliable)
 	{
 		_need_reliable_transfer = need_reliable;
@@ -166,7 +210,7 @@ private:
 
 		~LogFileBuffer();
 
-		bool start_log(const char *filename);
+		bool start_log(const char *filename, bool async_io, bool compress);
 
 		void close_file();
 
@@ -181,9 +225,9 @@ private:
 
 		int fd() const { return _fd; }
 
-		inline ssize_t write_to_file(const void *buffer, size_t size, bool call_fsync) const;
+		inline ssize_t write_to_file(const void *buffer, size_t size, bool call_fsync);
 
-		inline void fsync() const;
+		inline void fsync();
 
 		void mark_read(size_t n) { _count -= n; _total_written += n; }
 
@@ -191,8 +235,25 @@ private:
 		size_t buffer_size() const { return _buffer_size; }
 		size_t count() const { return _count; }
 
+#if defined(__PX4_LINUX)
+		size_t io_pending_bytes() const { return _async_file.pending_bytes(); }
+		uint32_t io_stalls() const { return _async_file.stalls(); }
+#else
+		size_t io_pending_bytes() const { return 0; }
+		uint32_t io_stalls() const { return 0; }
+#endif
+
+		bool compression_stats(uint64_t &raw_bytes, uint64_t &compressed_bytes, hrt_abstime &cpu_time) const;
+
 		bool _should_run = false;
 	private:
+		int close_fd();
+
+		/** write to the file (bypassing compression) */
+		inline ssize_t write_raw(const void *buffer, size_t size);
+
+		static ssize_t write_frame_data(void *context, const void *buffer, size_t size);
+
 		const size_t _buffer_size;
 		int	_fd = -1;
 		uint8_t *_buffer = nullptr;
@@ -201,12 +262,19 @@ private:
 		size_t _total_written = 0;
 		perf_counter_t _perf_write;
 		perf_counter_t _perf_fsync;
+#if defined(__PX4_LINUX)
+		AsyncFileWriter _async_file;
+#endif
+		ulog_compression::FrameWriter *_frame_writer = nullptr; ///< allocated when compression is first used
+		bool _compress = false;
 	};
 
 	LogFileBuffer _buffers[(int)LogType::Count];
 
 	bool 		_exit_thread = false;
 	bool		_need_reliable_transfer = false;
+	bool		_async_io = false;
+	bool		_compress = false;
 	pthread_mutex_t		_mtx;
 	pthread_cond_t		_cv;
 	pthread_t _thread = 0;
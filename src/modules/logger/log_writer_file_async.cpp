@@ -0,0 +1,529 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include "log_writer_file_async.h"
+
+#if defined(__PX4_LINUX)
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+#include <px4_platform_common/log.h>
+#include <px4_platform_common/posix.h>
+
+#if __has_include(<linux/io_uring.h>) && defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#include <linux/io_uring.h>
+#define ASYNC_FILE_WRITER_IO_URING 1
+#endif
+
+namespace px4
+{
+namespace logger
+{
+
+constexpr size_t AsyncFileWriter::BLOCK_BYTES;
+constexpr size_t AsyncFileWriter::ALIGNMENT;
+
+static_assert(AsyncFileWriter::BLOCK_BYTES % AsyncFileWriter::ALIGNMENT == 0, "BLOCK_BYTES must be a multiple of ALIGNMENT");
+
+static inline size_t round_up_aligned(size_t n)
+{
+	return (n + AsyncFileWriter::ALIGNMENT - 1) & ~(AsyncFileWriter::ALIGNMENT - 1);
+}
+
+#if defined(ASYNC_FILE_WRITER_IO_URING)
+
+/**
+ * Minimal io_uring submission/completion ring (a single producer and consumer: the log writer thread)
+ */
+struct AsyncFileWriter::Ring {
+	static constexpr unsigned ENTRIES = 4; // at most NUM_BLOCKS requests are in flight
+
+	int fd{-1};
+
+	void *sq_ptr{MAP_FAILED};
+	size_t sq_size{0};
+	void *cq_ptr{MAP_FAILED};
+	size_t cq_size{0};
+	io_uring_sqe *sqes{(io_uring_sqe *)MAP_FAILED};
+	size_t sqes_size{0};
+
+	unsigned *sq_tail{nullptr};
+	unsigned *sq_mask{nullptr};
+	unsigned *sq_array{nullptr};
+
+	unsigned *cq_head{nullptr};
+	unsigned *cq_tail{nullptr};
+	unsigned *cq_mask{nullptr};
+	io_uring_cqe *cqes{nullptr};
+
+	~Ring()
+	{
+		if (sqes != MAP_FAILED) { munmap(sqes, sqes_size); }
+
+		if (cq_ptr != MAP_FAILED && cq_ptr != sq_ptr) { munmap(cq_ptr, cq_size); }
+
+		if (sq_ptr != MAP_FAILED) { munmap(sq_ptr, sq_size); }
+
+		if (fd >= 0) { ::close(fd); }
+	}
+
+	bool init()
+	{
+		io_uring_params params{};
+		fd = syscall(__NR_io_uring_setup, ENTRIES, &params);
+
+		if (fd < 0) {
+			return false;
+		}
+
+#if defined(IORING_FEAT_RW_CUR_POS)
+
+		// IORING_OP_WRITE was added in the same kernel release (5.6)
+		if (!(params.features & IORING_FEAT_RW_CUR_POS)) {
+			return false;
+		}
+
+#endif
+
+		sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+		cq_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+		const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+
+		if (single_mmap) {
+			sq_size = cq_size = (sq_size > cq_size) ? sq_size : cq_size;
+		}
+
+		sq_ptr = mmap(nullptr, sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+
+		if (sq_ptr == MAP_FAILED) {
+			return false;
+		}
+
+		if (single_mmap) {
+			cq_ptr = sq_ptr;
+
+		} else {
+			cq_ptr = mmap(nullptr, cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+
+			if (cq_ptr == MAP_FAILED) {
+				return false;
+			}
+		}
+
+		sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+		sqes = (io_uring_sqe *)mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+					    IORING_OFF_SQES);
+
+		if (sqes == MAP_FAILED) {
+			return false;
+		}
+
+		uint8_t *sq = (uint8_t *)sq_ptr;
+		sq_tail = (unsigned *)(sq + params.sq_off.tail);
+		sq_mask = (unsigned *)(sq + params.sq_off.ring_mask);
+		sq_array = (unsigned *)(sq + params.sq_off.array);
+
+		uint8_t *cq = (uint8_t *)cq_ptr;
+		cq_head = (unsigned *)(cq + params.cq_off.head);
+		cq_tail = (unsigned *)(cq + params.cq_off.tail);
+		cq_mask = (unsigned *)(cq + params.cq_off.ring_mask);
+		cqes = (io_uring_cqe *)(cq + params.cq_off.cqes);
+
+		return true;
+	}
+
+	int enter(unsigned to_submit, unsigned min_complete)
+	{
+		const unsigned flags = min_complete > 0 ? IORING_ENTER_GETEVENTS : 0;
+		int ret;
+
+		do {
+			ret = syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0);
+		} while (ret < 0 && errno == EINTR);
+
+		return ret;
+	}
+
+	int submit_write(int file_fd, const void *data, unsigned len, off_t offset, uint64_t user_data)
+	{
+		const unsigned tail = *sq_tail; // we are the only producer
+		const unsigned index = tail & *sq_mask;
+
+		io_uring_sqe &sqe = sqes[index];
+		memset(&sqe, 0, sizeof(sqe));
+		sqe.opcode = IORING_OP_WRITE;
+		sqe.fd = file_fd;
+		sqe.addr = (uint64_t)(uintptr_t)data;
+		sqe.len = len;
+		sqe.off = offset;
+		sqe.user_data = user_data;
+
+		sq_array[index] = index;
+		__atomic_store_n(sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+		return enter(1, 0);
+	}
+};
+
+#else
+
+struct AsyncFileWriter::Ring {};
+
+#endif /* ASYNC_FILE_WRITER_IO_URING */
+
+AsyncFileWriter::~AsyncFileWriter()
+{
+	close();
+}
+
+bool AsyncFileWriter::open(const char *filename)
+{
+	if (_fd >= 0) {
+		close();
+	}
+
+	_fd = ::open(filename, O_CREAT | O_WRONLY | O_TRUNC | O_DIRECT, PX4_O_MODE_666);
+
+	if (_fd < 0) {
+		// EINVAL: the file system does not support O_DIRECT
+		return false;
+	}
+
+	if (posix_memalign((void **)&_staging, ALIGNMENT, NUM_BLOCKS * BLOCK_BYTES) != 0) {
+		_staging = nullptr;
+		::close(_fd);
+		_fd = -1;
+		return false;
+	}
+
+	for (int i = 0; i < NUM_BLOCKS; ++i) {
+		_blocks[i] = Block{};
+		_blocks[i].data = _staging + i * BLOCK_BYTES;
+	}
+
+	_fill_block = 0;
+	_file_size = 0;
+	_error = 0;
+	_pending_bytes = 0;
+	_stalls = 0;
+
+	_mode = setup_ring() ? Mode::IoUring : Mode::Direct;
+
+	return true;
+}
+
+bool AsyncFileWriter::setup_ring()
+{
+#if defined(ASYNC_FILE_WRITER_IO_URING)
+	_ring = new Ring();
+
+	if (_ring && _ring->init()) {
+		return true;
+	}
+
+	release_ring();
+#endif /* ASYNC_FILE_WRITER_IO_URING */
+
+	return false;
+}
+
+void AsyncFileWriter::release_ring()
+{
+	delete _ring;
+	_ring = nullptr;
+}
+
+ssize_t AsyncFileWriter::write(const void *buffer, size_t size)
+{
+	if (_error == 0) {
+		reap(false);
+	}
+
+	if (_error != 0) {
+		errno = _error;
+		return -1;
+	}
+
+	const uint8_t *data = static_cast<const uint8_t *>(buffer);
+	size_t remaining = size;
+
+	while (remaining > 0) {
+		Block &block = _blocks[_fill_block];
+		const size_t n = (BLOCK_BYTES - block.fill < remaining) ? BLOCK_BYTES - block.fill : remaining;
+
+		memcpy(block.data + block.fill, data, n);
+		block.fill += n;
+		data += n;
+		remaining -= n;
+		_file_size += n;
+		_pending_bytes += n;
+
+		if (block.fill == BLOCK_BYTES) {
+			if (submit(_fill_block, false) != 0) {
+				return -1;
+			}
+
+			// continue with the next block once its previous content is on storage
+			_fill_block = (_fill_block + 1) % NUM_BLOCKS;
+
+			if (_blocks[_fill_block].in_flight) {
+				++_stalls;
+
+				if (wait_idle(_fill_block) != 0) {
+					return -1;
+				}
+			}
+
+			Block &next = _blocks[_fill_block];
+			next.fill = 0;
+			next.submitted = 0;
+			next.durable = 0;
+			next.file_offset = _file_size;
+		}
+	}
+
+	return size;
+}
+
+int AsyncFileWriter::submit(int index, bool wait)
+{
+	Block &block = _blocks[index];
+
+	// a previous (partial) write of the same block must complete first, as requests are not ordered
+	if (wait_idle(index) != 0) {
+		return -1;
+	}
+
+	const size_t len = round_up_aligned(block.fill);
+
+	if (len > block.fill) {
+		memset(block.data + block.fill, 0, len - block.fill);
+	}
+
+	block.submitted = block.fill;
+	block.in_flight = true;
+
+#if defined(ASYNC_FILE_WRITER_IO_URING)
+
+	if (_mode == Mode::IoUring) {
+		if (_ring->submit_write(_fd, block.data, len, block.file_offset, index) < 0) {
+			// the kernel rejected the request: continue with synchronous writes
+			PX4_WARN("io_uring submission failed (%i), using synchronous writes", errno);
+			release_ring();
+			_mode = Mode::Direct;
+
+		} else {
+			return wait ? wait_idle(index) : 0;
+		}
+	}
+
+#endif /* ASYNC_FILE_WRITER_IO_URING */
+
+	size_t written = 0;
+
+	while (written < len) {
+		ssize_t ret = ::pwrite(_fd, block.data + written, len - written, block.file_offset + written);
+
+		if (ret < 0 && errno == EINTR) {
+			continue;
+		}
+
+		if (ret <= 0) {
+			complete(index, ret < 0 ? -errno : -ENOSPC);
+			errno = _error;
+			return -1;
+		}
+
+		written += ret;
+	}
+
+	complete(index, written);
+	return 0;
+}
+
+void AsyncFileWriter::complete(int index, int result)
+{
+	Block &block = _blocks[index];
+
+	if (!block.in_flight) {
+		return;
+	}
+
+	block.in_flight = false;
+
+	if (result < 0) {
+		if (_error == 0) {
+			_error = -result;
+		}
+
+	} else if ((size_t)result < round_up_aligned(block.submitted)) {
+		// short write: out of space
+		if (_error == 0) {
+			_error = ENOSPC;
+		}
+
+	} else if (block.submitted > block.durable) {
+		const size_t completed = block.submitted - block.durable;
+		_pending_bytes -= (_pending_bytes < completed) ? _pending_bytes : completed;
+		block.durable = block.submitted;
+	}
+}
+
+int AsyncFileWriter::reap(bool wait)
+{
+#if defined(ASYNC_FILE_WRITER_IO_URING)
+
+	if (_mode != Mode::IoUring) {
+		return 0;
+	}
+
+	if (wait && _ring->enter(0, 1) < 0) {
+		if (_error == 0) {
+			_error = errno;
+		}
+
+		return -1;
+	}
+
+	unsigned head = *_ring->cq_head; // we are the only consumer
+	const unsigned tail = __atomic_load_n(_ring->cq_tail, __ATOMIC_ACQUIRE);
+
+	while (head != tail) {
+		const io_uring_cqe &cqe = _ring->cqes[head & *_ring->cq_mask];
+
+		if (cqe.user_data < NUM_BLOCKS) {
+			complete((int)cqe.user_data, cqe.res);
+		}
+
+		++head;
+	}
+
+	__atomic_store_n(_ring->cq_head, head, __ATOMIC_RELEASE);
+#endif /* ASYNC_FILE_WRITER_IO_URING */
+
+	return 0;
+}
+
+int AsyncFileWriter::wait_idle(int index)
+{
+	while (_blocks[index].in_flight) {
+		if (reap(true) != 0 || _mode != Mode::IoUring) {
+			// only io_uring writes can be in flight
+			_blocks[index].in_flight = false;
+			break;
+		}
+	}
+
+	if (_error != 0) {
+		errno = _error;
+		return -1;
+	}
+
+	return 0;
+}
+
+int AsyncFileWriter::sync()
+{
+	if (_fd < 0) {
+		return 0;
+	}
+
+	for (int i = 0; i < NUM_BLOCKS; ++i) {
+		if (wait_idle(i) != 0) {
+			return -1;
+		}
+	}
+
+	Block &block = _blocks[_fill_block];
+
+	if (block.fill > block.submitted) {
+		// write the partial block (padded), it is overwritten once the block is full
+		if (submit(_fill_block, true) != 0) {
+			return -1;
+		}
+	}
+
+	// remove the padding and persist the file size (there is no dirty data in the page cache)
+	if (::ftruncate(_fd, _file_size) != 0 || ::fdatasync(_fd) != 0) {
+		return -1;
+	}
+
+	return 0;
+}
+
+int AsyncFileWriter::close()
+{
+	if (_fd < 0) {
+		return 0;
+	}
+
+	int ret = sync();
+	int err = errno;
+
+	release_ring();
+
+	if (::close(_fd) != 0 && ret == 0) {
+		ret = -1;
+		err = errno;
+	}
+
+	_fd = -1;
+	_mode = Mode::Closed;
+	_pending_bytes = 0;
+
+	free(_staging);
+	_staging = nullptr;
+
+	for (int i = 0; i < NUM_BLOCKS; ++i) {
+		_blocks[i] = Block{};
+	}
+
+	if (ret != 0) {
+		errno = err;
+	}
+
+	return ret;
+}
+
+} // namespace logger
+} // namespace px4
+
+#endif /* __PX4_LINUX */
@@ -0,0 +1,155 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#if defined(__PX4_LINUX)
+
+namespace px4
+{
+namespace logger
+{
+
+/**
+ * @class AsyncFileWriter
+ * Asynchronous, page cache bypassing file writer for the log writer thread (Linux only).
+ *
+ * The file is opened with O_DIRECT and data is staged into NUM_BLOCKS aligned blocks.
+ * A full block is submitted to the kernel via io_uring while the next one is being filled,
+ * so the writer thread only blocks if the storage cannot keep up. If io_uring is not available,
+ * full blocks are written synchronously with pwrite().
+ *
+ * Since there is no dirty page cache, sync() only needs to flush the partially filled block and
+ * update the file size, which avoids the long fsync() stalls of buffered writes.
+ */
+class AsyncFileWriter
+{
+public:
+	enum class Mode : uint8_t {
+		Closed = 0,
+		Direct,  ///< O_DIRECT with synchronous pwrite()
+		IoUring, ///< O_DIRECT with io_uring submission
+	};
+
+	static constexpr size_t BLOCK_BYTES = 64 * 1024; ///< must be a multiple of ALIGNMENT
+	static constexpr size_t ALIGNMENT = 4096; ///< O_DIRECT buffer, size and offset alignment
+	static constexpr int NUM_BLOCKS = 2;
+
+	AsyncFileWriter() = default;
+	~AsyncFileWriter();
+
+	AsyncFileWriter(const AsyncFileWriter &) = delete;
+	AsyncFileWriter &operator=(const AsyncFileWriter &) = delete;
+
+	/**
+	 * Create/open a file for writing.
+	 * @return false if O_DIRECT is not supported for this file (the caller should fall back to buffered I/O)
+	 */
+	bool open(const char *filename);
+
+	/**
+	 * Append data to the file. The data is copied, so the caller can reuse the buffer immediately.
+	 * @return size, or -1 on error (errno is set)
+	 */
+	ssize_t write(const void *buffer, size_t size);
+
+	/**
+	 * Wait for all outstanding writes, write out the partially filled block and update the file size.
+	 * @return 0 on success, -1 on error (errno is set)
+	 */
+	int sync();
+
+	/**
+	 * Flush all data, truncate the file to the written size and close it.
+	 * @return 0 on success, -1 on error (errno is set)
+	 */
+	int close();
+
+	bool is_open() const { return _fd >= 0; }
+	int fd() const { return _fd; }
+	Mode mode() const { return _mode; }
+
+	/** number of bytes accepted by write() but not yet completed on storage */
+	size_t pending_bytes() const { return _pending_bytes; }
+
+	/** number of times write() had to wait for a block to become available */
+	uint32_t stalls() const { return _stalls; }
+
+private:
+	struct Block {
+		uint8_t *data{nullptr};
+		size_t fill{0};         ///< number of valid bytes
+		off_t file_offset{0};   ///< file offset of the first byte
+		size_t submitted{0};    ///< number of valid bytes in the last submitted write
+		size_t durable{0};      ///< number of valid bytes completed on storage
+		bool in_flight{false};
+	};
+
+	bool setup_ring();
+	void release_ring();
+
+	/** write out block (partial blocks are padded), asynchronously if possible */
+	int submit(int index, bool wait);
+
+	/** wait until block index is no longer in flight */
+	int wait_idle(int index);
+
+	/** process completed requests, optionally wait for at least one */
+	int reap(bool wait);
+
+	void complete(int index, int result);
+
+	int _fd{-1};
+	Mode _mode{Mode::Closed};
+	uint8_t *_staging{nullptr};
+	Block _blocks[NUM_BLOCKS] {};
+	int _fill_block{0};
+	off_t _file_size{0}; ///< logical file size (bytes accepted by write())
+	int _error{0}; ///< first asynchronous write error (errno value)
+
+	size_t _pending_bytes{0};
+	uint32_t _stalls{0};
+
+	struct Ring;
+	Ring *_ring{nullptr};
+};
+
+} // namespace logger
+} // namespace px4
+
+#endif /* __PX4_LINUX */
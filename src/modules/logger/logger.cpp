@@ -229,6 +229,16 @@ void Logger::print_statistics(LogType type)
 		PX4_INFO("Wrote %4.2f MiB (avg %5.2f KiB/s)", (double)mebibytes, (double)(kibibytes / seconds));
 	}
 
+	uint64_t raw_bytes;
+	uint64_t compressed_bytes;
+	hrt_abstime compress_time;
+
+	if (_writer.get_compression_stats_file(type, raw_bytes, compressed_bytes, compress_time) && compressed_bytes > 0) {
+		PX4_INFO("Compression: ratio %.2f (%.2f MiB written), CPU time: %.2f s (%.1f%%)",
+			 (double)((float)raw_bytes / (float)compressed_bytes), (double)(compressed_bytes / (1024.f * 1024.f)),
+			 (double)(compress_time * 1e-6f), (double)(100.f * compress_time * 1e-6f / seconds));
+	}
+
 	PX4_INFO("Since last status: dropouts: %zu (max len: %.3f s), max used buffer: %zu / %zu B",
 		 stats.write_dropouts, (double)stats.max_dropout_duration, stats.high_water, _writer.get_buffer_size_file(type));
 	stats.high_water = 0;
@@ -718,16 +728,23 @@ void Logger::run()
 				}
 			}
 
+			/* check all subscriptions for updates at once, so that only the updated ones are touched */
+			uORB::updated_set(_subscriptions, _num_subscriptions, _updated_subscriptions);
+
 			/* wait for lock on log buffer */
 			_writer.lock();
 
 			for (int sub_idx = 0; sub_idx < _num_subscriptions; ++sub_idx) {
+				const bool try_to_subscribe = (sub_idx == next_subscribe_topic_index);
+
+				if (!_updated_subscriptions[sub_idx] && !try_to_subscribe) {
+					continue;
+				}
+
 				LoggerSubscription &sub = _subscriptions[sub_idx];
 				/* if this topic has been updated, copy the new data into the message buffer
 				 * and write a message to the log
 				 */
-				const bool try_to_subscribe = (sub_idx == next_subscribe_topic_index);
-
 				if (copy_if_updated(sub_idx, _msg_buffer + sizeof(ulog_message_data_header_s), try_to_subscribe)) {
 					// each message consists of a header followed by an orb data object
 					const size_t msg_size = sizeof(ulog_message_data_header_s) + sub.get_topic()->o_size_no_padding;
@@ -1025,6 +1042,8 @@ void Logger::publish_logger_status()
 				status.message_gaps = _message_gaps;
 				status.buffer_used_bytes = buffer_fill_count_file;
 				status.buffer_size_bytes = _writer.get_buffer_size_file(log_type);
+				status.io_pending_bytes = _writer.get_io_pending_bytes_file(log_type);
+				status.io_stalls = _writer.get_io_stalls_file(log_type);
 				status.num_messages = _num_subscriptions;
 				status.timestamp = hrt_absolute_time();
 				_logger_status_pub[i].publish(status);
@@ -1269,15 +1288,20 @@ int Logger::get_log_file_name(LogType type, char *file_name, size_t file_name_si
 		replay_suffix = "_replayed";
 	}
 
-	const char *crypto_suffix = "";
+	const char *file_suffix = "";
 #if defined(PX4_CRYPTO)
 
 	if (_param_sdlog_crypto_algorithm.get() != 0) {
-		crypto_suffix = "c";
+		file_suffix = "c";
 	}
 
 #endif
 
+	if (type == LogType::Full && _param_sdlog_compress.get() && file_suffix[0] == '\0') {
+		// compressed ULog stream (encrypted logs are not compressed)
+		file_suffix = "z";
+	}
+
 	char *log_file_name = _file_name[(int)type].log_file_name;
 
 	if (time_ok) {
@@ -1290,7 +1314,7 @@ int Logger::get_log_file_name(LogType type, char *file_name, size_t file_name_si
 		char log_file_name_time[16] = "";
 		strftime(log_file_name_time, sizeof(log_file_name_time), "%H_%M_%S", &tt);
 		snprintf(log_file_name, sizeof(LogFileName::log_file_name), "%s%s.ulg%s", log_file_name_time, replay_suffix,
-			 crypto_suffix);
+			 file_suffix);
 		snprintf(file_name + n, file_name_size - n, "/%s", log_file_name);
 
 		if (notify) {
@@ -1321,7 +1345,7 @@ int Logger::get_log_file_name(LogType type, char *file_name, size_t file_name_si
 		while (file_number <= MAX_NO_LOGFILE) {
 			/* format log file path: e.g. /fs/microsd/log/sess001/log001.ulg */
 			snprintf(log_file_name, sizeof(LogFileName::log_file_name), "log%03" PRIu16 "%s.ulg%s", file_number, replay_suffix,
-				 crypto_suffix);
+				 file_suffix);
 			snprintf(file_name + n, file_name_size - n, "/%s", log_file_name);
 
 			if (!util::file_exist(file_name)) {
@@ -1386,6 +1410,8 @@ void Logger::start_log_file(LogType type)
 		_param_sdlog_crypto_exchange_key.get());
 #endif
 
+	_writer.set_async_io(_param_sdlog_async_io.get());
+	_writer.set_compression(_param_sdlog_compress.get());
 	_writer.start_log_file(type, file_name);
 	_writer.select_write_backend(LogWriter::BackendFile);
 	_writer.set_need_reliable_transfer(true);
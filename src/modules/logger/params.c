@@ -174,6 +174,36 @@ PARAM_DEFINE_INT32(SDLOG_DIRS_MAX, 0);
  */
 PARAM_DEFINE_INT32(SDLOG_UUID, 1);
 
+/**
+ * Asynchronous log file writes
+ *
+ * If enabled, the full log file bypasses the page cache (O_DIRECT) and is written
+ * asynchronously via io_uring, or with synchronous aligned writes if io_uring is not available.
+ * This avoids long stalls of the writer thread during fsync.
+ * Falls back to regular writes if the file system does not support it.
+ *
+ * Only supported on Linux.
+ *
+ * @boolean
+ * @group SD Logging
+ */
+PARAM_DEFINE_INT32(SDLOG_ASYNC_IO, 0);
+
+/**
+ * Compressed log files
+ *
+ * If enabled, the full log is written as a stream of independently compressed (LZ4)
+ * frames, with the file extension .ulgz. Frames carry a checksum, so that a file can
+ * still be read after a crash. Use Tools/decompress_ulog.py to convert it into a
+ * regular ULog file.
+ *
+ * Not used for encrypted logs.
+ *
+ * @boolean
+ * @group SD Logging
+ */
+PARAM_DEFINE_INT32(SDLOG_COMPRESS, 0);
+
 /**
  * Logfile Encryption algorithm
  *
@@ -66,6 +66,7 @@ MavlinkFTP::~MavlinkFTP()
 {
 	delete[] _work_buffer1;
 	delete[] _work_buffer2;
+	delete[] _burst_buffer;
 }
 
 unsigned
@@ -538,6 +539,7 @@ MavlinkFTP::_workOpen(PayloadHeader *payload, int oflag)
 	}
 
 	_session_info.fd = fd;
+	_burst_buffer_fill = 0;
 	_session_info.file_size = fileSize;
 	_session_info.stream_download = false;
 
@@ -596,6 +598,13 @@ MavlinkFTP::_workBurst(PayloadHeader *payload, uint8_t target_system_id, uint8_t
 	}
 
 	PX4_DEBUG("FTP: burst offset:%" PRIu32, payload->offset);
+
+	if (!_burst_buffer) {
+		// not fatal, _burst_read() falls back to reading each packet directly
+		_burst_buffer = new uint8_t[kBurstBufferLen];
+		_burst_buffer_fill = 0;
+	}
+
 	// Setup for streaming sends
 	_session_info.stream_download = true;
 	_session_info.stream_offset = payload->offset;
@@ -607,6 +616,64 @@ MavlinkFTP::_workBurst(PayloadHeader *payload, uint8_t target_system_id, uint8_t
 	return kErrNone;
 }
 
+int
+MavlinkFTP::_burst_read(uint32_t offset, uint8_t *data, unsigned len)
+{
+	if (!_burst_buffer) {
+		if (lseek(_session_info.fd, offset, SEEK_SET) < 0) {
+			_our_errno = errno;
+			return -1;
+		}
+
+		int bytes_read = ::read(_session_info.fd, data, len);
+
+		if (bytes_read < 0) {
+			_our_errno = errno;
+		}
+
+		return bytes_read;
+	}
+
+	unsigned copied = 0;
+
+	while (copied < len) {
+		const uint32_t position = offset + copied;
+
+		if (position < _burst_buffer_offset || position >= _burst_buffer_offset + _burst_buffer_fill) {
+			// refill the whole buffer, consecutive refills then read complete file system blocks
+			const uint32_t aligned_offset = position - position % kBurstBufferLen;
+			_burst_buffer_fill = 0;
+
+			if (lseek(_session_info.fd, aligned_offset, SEEK_SET) < 0) {
+				_our_errno = errno;
+				return -1;
+			}
+
+			int bytes_read = ::read(_session_info.fd, _burst_buffer, kBurstBufferLen);
+
+			if (bytes_read < 0) {
+				_our_errno = errno;
+				return -1;
+			}
+
+			_burst_buffer_offset = aligned_offset;
+			_burst_buffer_fill = bytes_read;
+
+			if (position >= _burst_buffer_offset + _burst_buffer_fill) {
+				// end of file
+				break;
+			}
+		}
+
+		const unsigned available = _burst_buffer_offset + _burst_buffer_fill - position;
+		const unsigned n = (len - copied < available) ? len - copied : available;
+		memcpy(&data[copied], &_burst_buffer[position - _burst_buffer_offset], n);
+		copied += n;
+	}
+
+	return copied;
+}
+
 /// @brief Responds to a Write command
 MavlinkFTP::ErrorCode
 MavlinkFTP::_workWrite(PayloadHeader *payload)
@@ -626,6 +693,8 @@ MavlinkFTP::_workWrite(PayloadHeader *payload)
 		return kErrFailErrno;
 	}
 
+	_burst_buffer_fill = 0;
+
 	PX4_DEBUG("write %d bytes", payload->size);
 	int bytes_written = ::write(_session_info.fd, &payload->data[0], payload->size);
 
@@ -1029,9 +1098,9 @@ MavlinkFTP::_copy_file(const char *src_path, const char *dst_path, size_t length
 void MavlinkFTP::send()
 {
 
-	if (_work_buffer1 || _work_buffer2) {
-		// free the work buffers if they are not used for a while
-		if (hrt_elapsed_time(&_last_work_buffer_access) > 2_s) {
+	if (_work_buffer1 || _work_buffer2 || _burst_buffer) {
+		// free the work buffers if they are not used for a while, the burst buffer is in use while streaming
+		if (!_session_info.stream_download && (hrt_elapsed_time(&_last_work_buffer_access) > 2_s)) {
 			if (_work_buffer1) {
 				delete[] _work_buffer1;
 				_work_buffer1 = nullptr;
@@ -1041,6 +1110,12 @@ void MavlinkFTP::send()
 				delete[] _work_buffer2;
 				_work_buffer2 = nullptr;
 			}
+
+			if (_burst_buffer) {
+				delete[] _burst_buffer;
+				_burst_buffer = nullptr;
+				_burst_buffer_fill = 0;
+			}
 		}
 
 	} else if (_session_info.fd != -1) {
@@ -1060,8 +1135,8 @@ void MavlinkFTP::send()
 	}
 
 #ifndef MAVLINK_FTP_UNIT_TEST
-	// Skip send if not enough room
-	unsigned max_bytes_to_send = _mavlink->get_free_tx_buf();
+	// Skip send if not enough room, otherwise pack as many packets as the link allows
+	unsigned max_bytes_to_send = _mavlink->get_bulk_tx_budget();
 	PX4_DEBUG("MavlinkFTP::send max_bytes_to_send(%u) get_free_tx_buf(%u)", max_bytes_to_send, _mavlink->get_free_tx_buf());
 
 	if (max_bytes_to_send < get_size()) {
@@ -1098,14 +1173,7 @@ void MavlinkFTP::send()
 		}
 
 		if (error_code == kErrNone) {
-			if (lseek(_session_info.fd, payload->offset, SEEK_SET) < 0) {
-				error_code = kErrFailErrno;
-				PX4_WARN("stream download: seek fail");
-			}
-		}
-
-		if (error_code == kErrNone) {
-			int bytes_read = ::read(_session_info.fd, &payload->data[0], kMaxDataLength);
+			int bytes_read = _burst_read(payload->offset, &payload->data[0], kMaxDataLength);
 
 			if (bytes_read < 0) {
 				// Negative return indicates error other than eof
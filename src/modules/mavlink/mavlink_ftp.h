@@ -163,6 +163,13 @@ private:
 	 */
 	bool _ensure_buffers_exist();
 
+	/**
+	 * Read burst download data of the session file, served from the read-ahead buffer which is
+	 * refilled with large reads aligned to its size. Reads directly if the buffer is not allocated.
+	 * @return number of bytes read (less than len at the end of the file), -1 on error
+	 */
+	int _burst_read(uint32_t offset, uint8_t *data, unsigned len);
+
 	static const char	kDirentFile = 'F';	///< Identifies File returned from List command
 	static const char	kDirentDir = 'D';	///< Identifies Directory returned from List command
 	static const char	kDirentSkip = 'S';	///< Identifies Skipped entry from List command
@@ -198,6 +205,16 @@ private:
 	static constexpr int _work_buffer2_len = 256;
 	hrt_abstime _last_work_buffer_access{0}; ///< timestamp when the buffers were last accessed
 
+	/* burst download read-ahead buffer, allocated with the first burst request */
+#ifdef __PX4_NUTTX
+	static constexpr unsigned kBurstBufferLen = 1024;	///< multiple of the SD card sector size
+#else
+	static constexpr unsigned kBurstBufferLen = 16384;
+#endif
+	uint8_t *_burst_buffer{nullptr};
+	uint32_t _burst_buffer_offset{0};	///< file offset of _burst_buffer[0]
+	unsigned _burst_buffer_fill{0};		///< valid bytes in _burst_buffer, 0 if empty
+
 	// prepend a root directory to each file/dir access to avoid enumerating the full FS tree (e.g. on Linux).
 	// Note that requests can still fall outside of the root dir by using ../..
 #ifdef MAVLINK_FTP_UNIT_TEST
@@ -95,6 +95,10 @@ static void usage();
 
 hrt_abstime Mavlink::_first_start_time = {0};
 
+Mavlink::ForwardFrame *Mavlink::_forward_pool = nullptr;
+int Mavlink::_forward_pool_users = 0;
+int Mavlink::_forward_pool_next = 0;
+
 bool Mavlink::_boot_complete = false;
 
 Mavlink::Mavlink() :
@@ -475,14 +479,175 @@ Mavlink::forward_message(const mavlink_message_t *msg, Mavlink *self)
 
 	LockGuard lg{mavlink_module_mutex};
 
+	Mavlink *targets[MAVLINK_COMM_NUM_BUFFERS];
+	int target_count = 0;
+
 	for (Mavlink *inst : mavlink_module_instances) {
 		if (inst && (inst != self) && (inst->_forwarding_on)) {
 			// Pass message only if target component was seen before
 			if (inst->_receiver.component_was_seen(target_system_id, target_component_id)) {
-				inst->pass_message(msg);
+				targets[target_count++] = inst;
 			}
 		}
 	}
+
+	if (target_count == 0) {
+		return;
+	}
+
+	ForwardFrame *frame = forward_frame_alloc();
+
+	if (frame == nullptr) {
+		for (int i = 0; i < target_count; i++) {
+			targets[i]->_forward_dropped++;
+		}
+
+		return;
+	}
+
+	// serialize once, as received (no payload trimming, the checksum and signature must stay valid)
+	uint8_t *buf = frame->data;
+	uint16_t len = 0;
+
+	if (msg->magic == MAVLINK_STX_MAVLINK1) {
+		buf[len++] = msg->magic;
+		buf[len++] = msg->len;
+		buf[len++] = msg->seq;
+		buf[len++] = msg->sysid;
+		buf[len++] = msg->compid;
+		buf[len++] = msg->msgid & 0xFF;
+
+	} else {
+		buf[len++] = msg->magic;
+		buf[len++] = msg->len;
+		buf[len++] = msg->incompat_flags;
+		buf[len++] = msg->compat_flags;
+		buf[len++] = msg->seq;
+		buf[len++] = msg->sysid;
+		buf[len++] = msg->compid;
+		buf[len++] = msg->msgid & 0xFF;
+		buf[len++] = (msg->msgid >> 8) & 0xFF;
+		buf[len++] = (msg->msgid >> 16) & 0xFF;
+	}
+
+	memcpy(&buf[len], _MAV_PAYLOAD(msg), msg->len);
+	len += msg->len;
+	buf[len++] = msg->checksum & 0xFF;
+	buf[len++] = msg->checksum >> 8;
+
+	if (msg->magic != MAVLINK_STX_MAVLINK1 && (msg->incompat_flags & MAVLINK_IFLAG_SIGNED)) {
+		memcpy(&buf[len], msg->signature, MAVLINK_SIGNATURE_BLOCK_LEN);
+		len += MAVLINK_SIGNATURE_BLOCK_LEN;
+	}
+
+	frame->len = len;
+
+	// take all references before publishing the frame, a target may send and release it right away
+	frame->refcount.store((uint8_t)target_count);
+
+	for (int i = 0; i < target_count; i++) {
+		if (!targets[i]->forward_queue_push(frame)) {
+			targets[i]->_forward_dropped++;
+			forward_frame_release(frame);
+		}
+	}
+}
+
+Mavlink::ForwardFrame *
+Mavlink::forward_frame_alloc()
+{
+	if (_forward_pool == nullptr) {
+		return nullptr;
+	}
+
+	for (int i = 0; i < FORWARD_POOL_SIZE; i++) {
+		ForwardFrame *frame = &_forward_pool[(_forward_pool_next + i) % FORWARD_POOL_SIZE];
+
+		// only the allocator (holding mavlink_module_mutex) takes a free frame, so no other thread can race us here
+		if (frame->refcount.load() == 0) {
+			_forward_pool_next = (_forward_pool_next + i + 1) % FORWARD_POOL_SIZE;
+			return frame;
+		}
+	}
+
+	return nullptr;
+}
+
+void
+Mavlink::forward_frame_release(ForwardFrame *frame)
+{
+	frame->refcount.fetch_sub(1);
+}
+
+bool
+Mavlink::forward_queue_push(ForwardFrame *frame)
+{
+	const uint8_t head = _forward_queue_head.load();
+
+	if ((uint8_t)(head - _forward_queue_tail.load()) >= FORWARD_QUEUE_SIZE) {
+		return false;
+	}
+
+	_forward_queue[head & (FORWARD_QUEUE_SIZE - 1)] = frame;
+	_forward_queue_head.store(head + 1);
+	return true;
+}
+
+void
+Mavlink::forward_queue_send()
+{
+	const uint8_t head = _forward_queue_head.load();
+	uint8_t tail = _forward_queue_tail.load();
+
+	while (tail != head) {
+		ForwardFrame *frame = _forward_queue[tail & (FORWARD_QUEUE_SIZE - 1)];
+
+		send_start(frame->len);
+		send_bytes(frame->data, frame->len);
+		send_finish();
+
+		forward_frame_release(frame);
+		_forward_queue_tail.store(++tail);
+	}
+}
+
+int
+Mavlink::forward_pool_attach()
+{
+	LockGuard lg{mavlink_module_mutex};
+
+	if (_forward_pool == nullptr) {
+		_forward_pool = new ForwardFrame[FORWARD_POOL_SIZE];
+
+		if (_forward_pool == nullptr) {
+			return PX4_ERROR;
+		}
+	}
+
+	_forward_pool_users++;
+	return PX4_OK;
+}
+
+void
+Mavlink::forward_pool_detach()
+{
+	LockGuard lg{mavlink_module_mutex};
+
+	// no more frames can be queued to this instance once forwarding is off
+	_forwarding_on = false;
+
+	const uint8_t head = _forward_queue_head.load();
+
+	for (uint8_t tail = _forward_queue_tail.load(); tail != head; tail++) {
+		forward_frame_release(_forward_queue[tail & (FORWARD_QUEUE_SIZE - 1)]);
+	}
+
+	_forward_queue_tail.store(head);
+
+	if (--_forward_pool_users == 0) {
+		delete[] _forward_pool;
+		_forward_pool = nullptr;
+	}
 }
 
 int
@@ -765,6 +930,36 @@ void Mavlink::send_finish()
 
 	else if (get_protocol() == Protocol::UDP) {
 
+		bool send_broadcast = false;
+
+		if ((_mode != MAVLINK_MODE_ONBOARD) && broadcast_enabled() &&
+		    (!get_client_source_initialized() || !is_connected())) {
+
+			if (!_broadcast_address_found) {
+				find_broadcast_address();
+			}
+
+			send_broadcast = _broadcast_address_found;
+		}
+
+# if defined(MAVLINK_UDP_MMSG)
+
+		if (_udp_tx_batching) {
+			// sent and counted by udp_tx_flush()
+			udp_tx_queue(send_broadcast);
+
+			// other threads (eg the receiver) don't wait for the end of the main loop pass
+			if (!pthread_equal(pthread_self(), _udp_tx_batch_thread)) {
+				udp_tx_flush();
+			}
+
+			_buf_fill = 0;
+			pthread_mutex_unlock(&_send_mutex);
+			return;
+		}
+
+# endif // MAVLINK_UDP_MMSG
+
 # if defined(CONFIG_NET)
 
 		if (_src_addr_initialized) {
@@ -775,26 +970,18 @@ void Mavlink::send_finish()
 
 # endif // CONFIG_NET
 
-		if ((_mode != MAVLINK_MODE_ONBOARD) && broadcast_enabled() &&
-		    (!get_client_source_initialized() || !is_connected())) {
-
-			if (!_broadcast_address_found) {
-				find_broadcast_address();
-			}
-
-			if (_broadcast_address_found && _buf_fill > 0) {
+		if (send_broadcast) {
 
-				int bret = sendto(_socket_fd, _buf, _buf_fill, 0, (struct sockaddr *)&_bcast_addr, sizeof(_bcast_addr));
+			int bret = sendto(_socket_fd, _buf, _buf_fill, 0, (struct sockaddr *)&_bcast_addr, sizeof(_bcast_addr));
 
-				if (bret <= 0) {
-					if (!_broadcast_failed_warned) {
-						PX4_ERR("sending broadcast failed, errno: %d: %s", errno, strerror(errno));
-						_broadcast_failed_warned = true;
-					}
-
-				} else {
-					_broadcast_failed_warned = false;
+			if (bret <= 0) {
+				if (!_broadcast_failed_warned) {
+					PX4_ERR("sending broadcast failed, errno: %d: %s", errno, strerror(errno));
+					_broadcast_failed_warned = true;
 				}
+
+			} else {
+				_broadcast_failed_warned = false;
 			}
 		}
 	}
@@ -805,6 +992,7 @@ void Mavlink::send_finish()
 		_tstatus.tx_message_count++;
 		count_txbytes(_buf_fill);
 		_last_write_success_time = _last_write_try_time;
+		_link_budget -= _buf_fill;
 
 	} else {
 		count_txerrbytes(_buf_fill);
@@ -828,6 +1016,114 @@ void Mavlink::send_bytes(const uint8_t *buf, unsigned packet_len)
 	}
 }
 
+#if defined(MAVLINK_UDP_MMSG)
+void Mavlink::udp_tx_batch_begin()
+{
+	if (get_protocol() == Protocol::UDP) {
+		pthread_mutex_lock(&_send_mutex);
+		_udp_tx_batching = true;
+		_udp_tx_batch_thread = pthread_self();
+		pthread_mutex_unlock(&_send_mutex);
+	}
+}
+
+void Mavlink::udp_tx_batch_end()
+{
+	if (get_protocol() == Protocol::UDP) {
+		pthread_mutex_lock(&_send_mutex);
+
+		if (_udp_tx_msg_count > 0) {
+			udp_tx_flush();
+		}
+
+		_udp_tx_batching = false;
+		pthread_mutex_unlock(&_send_mutex);
+	}
+}
+
+void Mavlink::udp_tx_queue(bool broadcast)
+{
+	if (_udp_tx_queued >= UDP_TX_BATCH_SIZE) {
+		udp_tx_flush();
+	}
+
+	const unsigned slot = _udp_tx_queued++;
+	memcpy(_udp_tx_buf[slot], _buf, _buf_fill);
+	_udp_tx_iov[slot].iov_base = _udp_tx_buf[slot];
+	_udp_tx_iov[slot].iov_len = _buf_fill;
+
+	sockaddr_in *addresses[2] {&_src_addr, &_bcast_addr};
+
+	for (unsigned i = 0; i < (broadcast ? 2u : 1u); i++) {
+		mmsghdr &msg = _udp_tx_msgs[_udp_tx_msg_count++];
+		msg = {};
+		msg.msg_hdr.msg_name = addresses[i];
+		msg.msg_hdr.msg_namelen = sizeof(sockaddr_in);
+		msg.msg_hdr.msg_iov = &_udp_tx_iov[slot];
+		msg.msg_hdr.msg_iovlen = 1;
+	}
+}
+
+void Mavlink::udp_tx_flush()
+{
+	unsigned next = 0;
+	int error = 0;
+
+	while (next < _udp_tx_msg_count) {
+		const int ret = sendmmsg(_socket_fd, &_udp_tx_msgs[next], _udp_tx_msg_count - next, 0);
+		_udp_tx_syscalls++;
+
+		if (ret > 0) {
+			next += ret;
+
+		} else {
+			// skip the failing datagram, its msg_len stays 0 and it is counted as an error below
+			error = errno;
+			next++;
+		}
+	}
+
+	bool broadcast_sent = false;
+	bool broadcast_failed = false;
+
+	for (unsigned i = 0; i < _udp_tx_msg_count; i++) {
+		const mmsghdr &msg = _udp_tx_msgs[i];
+		const unsigned len = msg.msg_hdr.msg_iov->iov_len;
+		const bool sent = (msg.msg_len == len);
+
+		if (sent) {
+			_udp_tx_datagrams++;
+		}
+
+		if (msg.msg_hdr.msg_name == &_bcast_addr) {
+			broadcast_sent |= sent;
+			broadcast_failed |= !sent;
+
+		} else if (sent) {
+			_tstatus.tx_message_count++;
+			count_txbytes(len);
+			_last_write_success_time = _last_write_try_time;
+
+		} else {
+			count_txerrbytes(len);
+		}
+	}
+
+	if (broadcast_failed) {
+		if (!_broadcast_failed_warned) {
+			PX4_ERR("sending broadcast failed, errno: %d: %s", error, strerror(error));
+			_broadcast_failed_warned = true;
+		}
+
+	} else if (broadcast_sent) {
+		_broadcast_failed_warned = false;
+	}
+
+	_udp_tx_queued = 0;
+	_udp_tx_msg_count = 0;
+}
+#endif // MAVLINK_UDP_MMSG
+
 #ifdef MAVLINK_UDP
 void Mavlink::find_broadcast_address()
 {
@@ -1140,6 +1436,8 @@ Mavlink::configure_stream(const char *stream_name, const float rate)
 {
 	PX4_DEBUG("configure_stream(%s, %.3f)", stream_name, (double)rate);
 
+	_stream_schedule_invalid = true;
+
 	/* calculate interval in us, -1 means unlimited stream, 0 means disabled */
 	int interval = 0;
 
@@ -1186,147 +1484,157 @@ Mavlink::configure_stream(const char *stream_name, const float rate)
 #endif
 }
 
-void
-Mavlink::configure_stream_threadsafe(const char *stream_name, const float rate)
+bool
+Mavlink::rebuild_stream_schedule()
 {
-	/* orb subscription must be done from the main thread,
-	 * set _subscribe_to_stream and _subscribe_to_stream_rate fields
-	 * which polled in mavlink main loop */
-	if (!should_exit()) {
-		/* wait for previous subscription completion */
-		while (_subscribe_to_stream != nullptr) {
-			px4_usleep(MAIN_LOOP_DELAY / 2);
-		}
+	const unsigned num_streams = _streams.size();
 
-		/* copy stream name */
-		unsigned n = strlen(stream_name) + 1;
-		char *s = new char[n];
-		strcpy(s, stream_name);
+	if (num_streams > _stream_schedule_capacity) {
+		delete[] _stream_schedule;
+		_stream_schedule = new StreamScheduleEntry[num_streams];
+		_stream_schedule_capacity = (_stream_schedule != nullptr) ? num_streams : 0;
+	}
 
-		/* set subscription task */
-		_subscribe_to_stream_rate = rate;
-		_subscribe_to_stream = s;
+	_stream_schedule_size = 0;
 
-		/* wait for subscription */
-		do {
-			px4_usleep(MAIN_LOOP_DELAY / 2);
-		} while (_subscribe_to_stream != nullptr);
+	if (_stream_schedule == nullptr) {
+		return false;
+	}
 
-		delete[] s;
+	for (const auto &stream : _streams) {
+		_stream_schedule[_stream_schedule_size++] = {stream->get_next_update(), stream};
 	}
+
+	for (unsigned i = _stream_schedule_size / 2; i-- > 0;) {
+		stream_schedule_sift_down(i);
+	}
+
+	_stream_schedule_invalid = false;
+	return true;
 }
 
-int
-Mavlink::message_buffer_init(int size)
+void
+Mavlink::stream_schedule_sift_down(unsigned index)
 {
-	_message_buffer.size = size;
-	_message_buffer.write_ptr = 0;
-	_message_buffer.read_ptr = 0;
-	_message_buffer.data = (char *)malloc(_message_buffer.size);
+	const StreamScheduleEntry entry = _stream_schedule[index];
 
-	int ret;
+	for (;;) {
+		unsigned child = 2 * index + 1;
 
-	if (_message_buffer.data == nullptr) {
-		ret = PX4_ERROR;
-		_message_buffer.size = 0;
+		if (child >= _stream_schedule_size) {
+			break;
+		}
 
-	} else {
-		ret = OK;
+		if ((child + 1 < _stream_schedule_size) && (_stream_schedule[child + 1].due < _stream_schedule[child].due)) {
+			child++;
+		}
+
+		if (_stream_schedule[child].due >= entry.due) {
+			break;
+		}
+
+		_stream_schedule[index] = _stream_schedule[child];
+		index = child;
 	}
 
-	return ret;
+	_stream_schedule[index] = entry;
 }
 
 void
-Mavlink::message_buffer_destroy()
+Mavlink::update_streams(const hrt_abstime &t)
 {
-	_message_buffer.size = 0;
-	_message_buffer.write_ptr = 0;
-	_message_buffer.read_ptr = 0;
-	free(_message_buffer.data);
-}
-
-int
-Mavlink::message_buffer_count()
-{
-	int n = _message_buffer.write_ptr - _message_buffer.read_ptr;
+	if (_stream_schedule_invalid && !rebuild_stream_schedule()) {
+		// no memory for the schedule, update every stream in every iteration
+		for (const auto &stream : _streams) {
+			stream->update(t);
+		}
 
-	if (n < 0) {
-		n += _message_buffer.size;
+		return;
 	}
 
-	return n;
-}
+	while ((_stream_schedule_size > 0) && (_stream_schedule[0].due <= t)) {
+		MavlinkStream *stream = _stream_schedule[0].stream;
 
-bool
-Mavlink::message_buffer_write(const void *ptr, int size)
-{
-	// bytes available to write
-	int available = _message_buffer.read_ptr - _message_buffer.write_ptr - 1;
+		if (!link_budget_allows(*stream)) {
+			// link is busy, try again in the next iteration
+			_stream_schedule[0].due = t + _main_loop_delay;
+			stream_schedule_sift_down(0);
+			continue;
+		}
 
-	if (available < 0) {
-		available += _message_buffer.size;
-	}
+		stream->update(t);
 
-	if (size > available) {
-		// buffer overflow
-		return false;
-	}
+		if (!_first_heartbeat_sent) {
+			if (_mode == MAVLINK_MODE_IRIDIUM) {
+				if (stream->get_id() == MAVLINK_MSG_ID_HIGH_LATENCY2) {
+					_first_heartbeat_sent = stream->first_message_sent();
+				}
 
-	char *c = (char *) ptr;
-	int n = _message_buffer.size - _message_buffer.write_ptr;	// bytes to end of the buffer
+			} else {
+				if (stream->get_id() == MAVLINK_MSG_ID_HEARTBEAT) {
+					_first_heartbeat_sent = stream->first_message_sent();
+				}
+			}
+		}
 
-	if (n < size) {
-		// message goes over end of the buffer
-		memcpy(&(_message_buffer.data[_message_buffer.write_ptr]), c, n);
-		_message_buffer.write_ptr = 0;
+		// re-insert with the current rate multiplier, streams which did not send (no new data)
+		// are polled again after their interval, or in the next iteration if they need every one
+		hrt_abstime due = stream->get_next_update();
 
-	} else {
-		n = 0;
-	}
+		if (due <= t) {
+			due = t + math::max(stream->get_poll_interval(), _main_loop_delay);
+		}
 
-	// now: n = bytes already written
-	int p = size - n;	// number of bytes to write
-	memcpy(&(_message_buffer.data[_message_buffer.write_ptr]), &(c[n]), p);
-	_message_buffer.write_ptr = (_message_buffer.write_ptr + p) % _message_buffer.size;
-	return true;
+		_stream_schedule[0].due = due;
+		stream_schedule_sift_down(0);
+	}
 }
 
-int
-Mavlink::message_buffer_get_ptr(void **ptr, bool *is_part)
+unsigned
+Mavlink::get_main_loop_sleep()
 {
-	// bytes available to read
-	int available = _message_buffer.write_ptr - _message_buffer.read_ptr;
-
-	if (available == 0) {
-		return 0;	// buffer is empty
+	if (!should_transmit() || _stream_schedule_invalid || (_stream_schedule_size == 0)) {
+		return _main_loop_delay;
 	}
 
-	int n = 0;
-
-	if (available > 0) {
-		// read pointer is before write pointer, all available bytes can be read
-		n = available;
-		*is_part = false;
+	const hrt_abstime now = hrt_absolute_time();
+	const hrt_abstime due = _stream_schedule[0].due;
 
-	} else {
-		// read pointer is after write pointer, read bytes from read_ptr to end of the buffer
-		n = _message_buffer.size - _message_buffer.read_ptr;
-		*is_part = _message_buffer.write_ptr > 0;
+	if (due <= now) {
+		return 0;
 	}
 
-	*ptr = &(_message_buffer.data[_message_buffer.read_ptr]);
-	return n;
+	return math::min(due - now, (hrt_abstime)_main_loop_delay);
 }
 
 void
-Mavlink::pass_message(const mavlink_message_t *msg)
+Mavlink::configure_stream_threadsafe(const char *stream_name, const float rate)
 {
-	/* size is 8 bytes plus variable payload */
-	int size = MAVLINK_NUM_NON_PAYLOAD_BYTES + msg->len;
-	pthread_mutex_lock(&_message_buffer_mutex);
-	message_buffer_write(msg, size);
-	pthread_mutex_unlock(&_message_buffer_mutex);
+	/* orb subscription must be done from the main thread,
+	 * set _subscribe_to_stream and _subscribe_to_stream_rate fields
+	 * which polled in mavlink main loop */
+	if (!should_exit()) {
+		/* wait for previous subscription completion */
+		while (_subscribe_to_stream != nullptr) {
+			px4_usleep(MAIN_LOOP_DELAY / 2);
+		}
+
+		/* copy stream name */
+		unsigned n = strlen(stream_name) + 1;
+		char *s = new char[n];
+		strcpy(s, stream_name);
+
+		/* set subscription task */
+		_subscribe_to_stream_rate = rate;
+		_subscribe_to_stream = s;
+
+		/* wait for subscription */
+		do {
+			px4_usleep(MAIN_LOOP_DELAY / 2);
+		} while (_subscribe_to_stream != nullptr);
+
+		delete[] s;
+	}
 }
 
 MavlinkShell *
@@ -1366,14 +1674,18 @@ Mavlink::update_rate_mult()
 {
 	float const_rate = 0.0f;
 	float rate = 0.0f;
+	float rate_priority[(int)MavlinkStream::Priority::Count] {};
 
 	/* scale down rates if their theoretical bandwidth is exceeding the link bandwidth */
 	for (const auto &stream : _streams) {
-		if (stream->const_rate()) {
-			const_rate += (stream->get_interval() > 0) ? stream->get_size_avg() * 1000000.0f / stream->get_interval() : 0;
+		const float stream_rate = (stream->get_interval() > 0) ? stream->get_size_avg() * 1000000.0f / stream->get_interval() : 0;
+
+		if (stream->const_rate() || (stream->priority() == MavlinkStream::Priority::High)) {
+			const_rate += stream_rate;
 
 		} else {
-			rate += (stream->get_interval() > 0) ? stream->get_size_avg() * 1000000.0f / stream->get_interval() : 0;
+			rate += stream_rate;
+			rate_priority[(int)stream->priority()] += stream_rate;
 		}
 	}
 
@@ -1427,6 +1739,94 @@ Mavlink::update_rate_mult()
 
 	/* ensure the rate multiplier never drops below 5% so that something is always sent */
 	_rate_mult = math::constrain(_rate_mult, 0.05f, 1.0f);
+
+	/* distribute the permitted bandwidth in order of priority: normal priority streams
+	 * are only scaled down once low priority streams are at their minimum rate */
+	float budget = _rate_mult * rate;
+
+	for (int priority = (int)MavlinkStream::Priority::High - 1; priority >= 0; priority--) {
+		float mult = 1.0f;
+
+		if (rate_priority[priority] > 0.f) {
+			// leave the minimum rate for the lower priority classes
+			float reserved = 0.f;
+
+			for (int lower = 0; lower < priority; lower++) {
+				reserved += 0.05f * rate_priority[lower];
+			}
+
+			mult = math::constrain((budget - reserved) / rate_priority[priority], 0.05f, 1.0f);
+			budget -= mult * rate_priority[priority];
+		}
+
+		_rate_mult_priority[priority] = mult;
+	}
+}
+
+void
+Mavlink::update_link_budget(const hrt_abstime &t)
+{
+	_link_budget_enabled = (get_protocol() == Protocol::SERIAL) && !get_flow_control_enabled() && (_datarate > 0);
+
+	// allow bursts of 100 ms worth of data, but at least two full packets
+	const float capacity = math::max(_datarate * 0.1f, 2.f * MAVLINK_MAX_PACKET_LEN);
+
+	pthread_mutex_lock(&_send_mutex);
+
+	if (_link_budget_timestamp != 0) {
+		_link_budget = math::constrain(_link_budget + _datarate * (t - _link_budget_timestamp) * 1e-6f, -capacity, capacity);
+	}
+
+	_link_budget_timestamp = t;
+
+	pthread_mutex_unlock(&_send_mutex);
+}
+
+bool
+Mavlink::link_budget_allows(MavlinkStream &stream)
+{
+	if (!_link_budget_enabled || (stream.priority() == MavlinkStream::Priority::High)) {
+		return true;
+	}
+
+	float required = stream.get_size();
+
+	if (stream.priority() == MavlinkStream::Priority::Low) {
+		// keep half of the burst capacity for normal and high priority messages
+		required += link_budget_reserve();
+	}
+
+	return _link_budget >= required;
+}
+
+float
+Mavlink::link_budget_reserve() const
+{
+	return math::max(_datarate * 0.05f, (float)MAVLINK_MAX_PACKET_LEN);
+}
+
+unsigned
+Mavlink::get_bulk_tx_budget()
+{
+	unsigned budget = get_free_tx_buf();
+
+#if defined(MAVLINK_UDP) && defined(__PX4_POSIX)
+
+	if (get_protocol() == Protocol::UDP) {
+		// the free space of the socket buffer is unknown, allow the data of one send interval at the
+		// configured rate (bulk transfers are sent by the receiver thread every 10 ms)
+		budget = math::max(budget, (unsigned)_datarate / 100);
+	}
+
+#endif // MAVLINK_UDP && __PX4_POSIX
+
+	if (_link_budget_enabled) {
+		// bulk data is sent with low priority
+		const float available = _link_budget - link_budget_reserve();
+		budget = math::min(budget, available > 0.f ? (unsigned)available : 0u);
+	}
+
+	return budget;
 }
 
 void
@@ -2166,19 +2566,12 @@ Mavlink::task_main(int argc, char *argv[])//实例任务开始
 	pthread_mutex_init(&_send_mutex, nullptr);
 	pthread_mutex_init(&_radio_status_mutex, nullptr);
 
-	/* if we are passing on mavlink messages, we need to prepare a buffer for this instance */
+	/* if we are passing on mavlink messages, forwarded frames are shared through a common pool */
 	if (_forwarding_on) {
-		/* initialize message buffer if multiplexing is on.
-		 * make space for two messages plus off-by-one space as we use the empty element
-		 * marker ring buffer approach.
-		 */
-		if (OK != message_buffer_init(2 * sizeof(mavlink_message_t) + 1)) {
+		if (OK != forward_pool_attach()) {
 			PX4_ERR("msg buf alloc fail");
 			return 1;
 		}
-
-		/* initialize message buffer mutex */
-		pthread_mutex_init(&_message_buffer_mutex, nullptr);
 	}
 
 	/* Activate sending the data by default (for the IRIDIUM mode it will be disabled after the first round of packages is sent)*/
@@ -2255,8 +2648,12 @@ Mavlink::task_main(int argc, char *argv[])//实例任务开始
 	_mavlink_start_time = hrt_absolute_time();
 
 	while (!should_exit()) {
-		/* main loop */
-		px4_usleep(_main_loop_delay);
+		/* main loop, wakes up earlier if a stream is due before the next regular iteration */
+		const unsigned sleep_time = get_main_loop_sleep();
+
+		if (sleep_time > 0) {
+			px4_usleep(sleep_time);
+		}
 
 		if (!should_transmit()) {
 			check_requested_subscriptions();
@@ -2268,6 +2665,26 @@ Mavlink::task_main(int argc, char *argv[])//实例任务开始
 
 		const hrt_abstime t = hrt_absolute_time();
 
+		update_link_budget(t);
+
+		if (t < _last_housekeeping + _main_loop_delay) {
+			// woken up early for a stream deadline, only send what is due
+#if defined(MAVLINK_UDP_MMSG)
+			udp_tx_batch_begin();
+#endif // MAVLINK_UDP_MMSG
+
+			update_streams(t);
+
+#if defined(MAVLINK_UDP_MMSG)
+			udp_tx_batch_end();
+#endif // MAVLINK_UDP_MMSG
+
+			perf_end(_loop_perf);
+			continue;
+		}
+
+		_last_housekeeping = t;
+
 		update_rate_mult();
 
 		// check for parameter updates
@@ -2369,6 +2786,11 @@ Mavlink::task_main(int argc, char *argv[])//实例任务开始
 			}
 		}
 
+#if defined(MAVLINK_UDP_MMSG)
+		// send everything produced in this pass with a single sendmmsg()
+		udp_tx_batch_begin();
+#endif // MAVLINK_UDP_MMSG
+
 		/* send command ACK */
 		bool cmd_logging_start_acknowledgement = false;
 		bool cmd_logging_stop_acknowledgement = false;
@@ -2428,23 +2850,8 @@ Mavlink::task_main(int argc, char *argv[])//实例任务开始
 
 		check_requested_subscriptions();
 
-		/* update streams */
-		for (const auto &stream : _streams) {
-			stream->update(t);
-
-			if (!_first_heartbeat_sent) {
-				if (_mode == MAVLINK_MODE_IRIDIUM) {
-					if (stream->get_id() == MAVLINK_MSG_ID_HIGH_LATENCY2) {
-						_first_heartbeat_sent = stream->first_message_sent();
-					}
-
-				} else {
-					if (stream->get_id() == MAVLINK_MSG_ID_HEARTBEAT) {
-						_first_heartbeat_sent = stream->first_message_sent();
-					}
-				}
-			}
-		}
+		/* update streams which are due */
+		update_streams(t);
 
 		/* check for ulog streaming messages */
 		if (_mavlink_ulog) {
@@ -2500,52 +2907,13 @@ Mavlink::task_main(int argc, char *argv[])//实例任务开始
 
 		/* pass messages from other UARTs */
 		if (_forwarding_on) {
-
-			bool is_part;
-			uint8_t *read_ptr;
-			uint8_t *write_ptr;
-
-			pthread_mutex_lock(&_message_buffer_mutex);
-			int available = message_buffer_get_ptr((void **)&read_ptr, &is_part);
-			pthread_mutex_unlock(&_message_buffer_mutex);
-
-			if (available > 0) {
-				// Reconstruct message from buffer
-
-				mavlink_message_t msg;
-				write_ptr = (uint8_t *)&msg;
-
-				// Pull a single message from the buffer
-				size_t read_count = available;
-
-				if (read_count > sizeof(mavlink_message_t)) {
-					read_count = sizeof(mavlink_message_t);
-				}
-
-				memcpy(write_ptr, read_ptr, read_count);
-
-				// We hold the mutex until after we complete the second part of the buffer. If we don't
-				// we may end up breaking the empty slot overflow detection semantics when we mark the
-				// possibly partial read below.
-				pthread_mutex_lock(&_message_buffer_mutex);
-
-				message_buffer_mark_read(read_count);
-
-				/* write second part of buffer if there is some */
-				if (is_part && read_count < sizeof(mavlink_message_t)) {
-					write_ptr += read_count;
-					available = message_buffer_get_ptr((void **)&read_ptr, &is_part);
-					read_count = sizeof(mavlink_message_t) - read_count;
-					memcpy(write_ptr, read_ptr, read_count);
-					message_buffer_mark_read(available);
-				}
-
-				pthread_mutex_unlock(&_message_buffer_mutex);
-
-				resend_message(&msg);
-			}
+			forward_queue_send();
 		}
 
+#if defined(MAVLINK_UDP_MMSG)
+		udp_tx_batch_end();
+#endif // MAVLINK_UDP_MMSG
+
 		/* update TX/RX rates*/
 		if (t > _bytes_timestamp + 1_s) {
 			if (_bytes_timestamp != 0) {
@@ -2558,6 +2926,10 @@ Mavlink::task_main(int argc, char *argv[])//实例任务开始
 				_bytes_tx = 0;
 				_bytes_txerr = 0;
 				_bytes_rx = 0;
+
+				for (const auto &stream : _streams) {
+					stream->update_achieved_rate(dt);
+				}
 			}
 
 			_bytes_timestamp = t;
@@ -2579,6 +2951,12 @@ Mavlink::task_main(int argc, char *argv[])//实例任务开始
 	/* delete streams */
 	_streams.clear();
 
+	delete[] _stream_schedule;
+	_stream_schedule = nullptr;
+	_stream_schedule_size = 0;
+	_stream_schedule_capacity = 0;
+	_stream_schedule_invalid = true;
+
 	if (_uart_fd >= 0) {
 		/* discard all pending data, as close() might block otherwise on NuttX with flow control enabled */
 		tcflush(_uart_fd, TCIOFLUSH);
@@ -2592,8 +2970,7 @@ Mavlink::task_main(int argc, char *argv[])//实例任务开始
 	}
 
 	if (_forwarding_on) {
-		message_buffer_destroy();
-		pthread_mutex_destroy(&_message_buffer_mutex);
+		forward_pool_detach();
 	}
 
 	if (_mavlink_ulog) {
@@ -2888,7 +3265,14 @@ Mavlink::display_status()
 	printf("\trates:\n");
 	printf("\t  tx: %.1f B/s\n", (double)_tstatus.tx_rate_avg);
 	printf("\t  txerr: %.1f B/s\n", (double)_tstatus.tx_error_rate_avg);
-	printf("\t  tx rate mult: %.3f\n", (double)_rate_mult);
+	printf("\t  tx rate mult: %.3f (normal: %.3f, low: %.3f)\n", (double)_rate_mult,
+	       (double)_rate_mult_priority[(int)MavlinkStream::Priority::Normal],
+	       (double)_rate_mult_priority[(int)MavlinkStream::Priority::Low]);
+
+	if (_link_budget_enabled) {
+		printf("\t  tx budget: %.0f B\n", (double)_link_budget);
+	}
+
 	printf("\t  tx rate max: %i B/s\n", _datarate);
 	printf("\t  rx: %.1f B/s\n", (double)_tstatus.rx_rate_avg);
 	printf("\t  rx loss: %.1f%%\n", (double)_tstatus.rx_message_lost_rate);
@@ -2906,6 +3290,11 @@ Mavlink::display_status()
 	       _ftp_on ? "YES" : "NO",
 	       _transmitting_enabled ? "YES" : "NO");
 	printf("\tmode: %s\n", mavlink_mode_str(_mode));
+
+	if (_forwarding_on) {
+		printf("\tforwarding: %" PRIu32 " messages dropped\n", _forward_dropped);
+	}
+
 	printf("\tMAVLink version: %" PRId32 "\n", _protocol_version);
 
 	printf("\ttransport protocol: ");
@@ -2928,6 +3317,13 @@ Mavlink::display_status()
 		}
 
 #endif
+#if defined(MAVLINK_UDP_MMSG)
+		printf("\tUDP tx: %" PRIu32 " datagrams in %" PRIu32 " syscalls (%.1f per syscall)\n", _udp_tx_datagrams,
+		       _udp_tx_syscalls, _udp_tx_syscalls > 0 ? (double)_udp_tx_datagrams / _udp_tx_syscalls : 0.);
+		printf("\tUDP rx: %" PRIu32 " datagrams in %" PRIu32 " syscalls (%.1f per syscall), %" PRIu32 " truncated\n",
+		       _udp_rx_datagrams, _udp_rx_syscalls, _udp_rx_syscalls > 0 ? (double)_udp_rx_datagrams / _udp_rx_syscalls : 0.,
+		       _udp_rx_truncated);
+#endif // MAVLINK_UDP_MMSG
 		break;
 #endif // MAVLINK_UDP
 
@@ -2949,9 +3345,10 @@ Mavlink::display_status()
 void
 Mavlink::display_status_streams()
 {
-	printf("\t%-20s%-16s %s\n", "Name", "Rate Config (current) [Hz]", "Message Size (if active) [B]");
+	static constexpr const char *priority_str[] {"low", "normal", "high"};
 
-	const float rate_mult = _rate_mult;
+	printf("\t%-20s%-16s %-14s %-9s %s\n", "Name", "Rate Config (current) [Hz]", "Achieved [Hz]", "Priority",
+	       "Message Size (if active) [B]");
 
 	for (const auto &stream : _streams) {
 		const int interval = stream->get_interval();
@@ -2965,11 +3362,12 @@ Mavlink::display_status_streams()
 			float rate = 1000000.0f / (float)interval;
 			// Note that the actual current rate can be lower if the associated uORB topic updates at a
 			// lower rate.
-			float rate_current = stream->const_rate() ? rate : rate * rate_mult;
+			float rate_current = stream->const_rate() ? rate : rate * get_rate_mult(stream->priority());
 			snprintf(rate_str, sizeof(rate_str), "%6.2f (%.3f)", (double)rate, (double)rate_current);
 		}
 
-		printf("\t%-30s%-16s", stream->get_name(), rate_str);
+		printf("\t%-30s%-16s %8.2f       %-9s", stream->get_name(), rate_str, (double)stream->get_achieved_rate(),
+		       priority_str[(int)stream->priority()]);
 
 		if (size > 0) {
 			printf(" %3u\n", size);
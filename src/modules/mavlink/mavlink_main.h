@@ -95,6 +95,10 @@
 # define DEFAULT_REMOTE_PORT_UDP 14550 ///< GCS port per MAVLink spec
 #endif // CONFIG_NET || __PX4_POSIX
 
+#if defined(MAVLINK_UDP) && defined(__PX4_LINUX)
+# define MAVLINK_UDP_MMSG ///< batch UDP datagrams with sendmmsg() and recvmmsg()
+#endif // MAVLINK_UDP && __PX4_LINUX
+
 enum class Protocol {
 	SERIAL = 0,
 #if defined(MAVLINK_UDP)
@@ -306,6 +310,13 @@ public:
 	 */
 	unsigned		get_free_tx_buf();
 
+	/**
+	 * Get the number of bytes a bulk transfer (e.g. FTP burst download) may send right now
+	 *
+	 * @return free space in the transmit buffer, limited by the link budget
+	 */
+	unsigned		get_bulk_tx_budget();
+
 	static int		start_helper(int argc, char *argv[]);
 
 	/**
@@ -338,11 +349,6 @@ public:
 	 */
 	void             	send_finish();
 
-	/**
-	 * Resend message as is, don't change sequence number and CRC.
-	 */
-	void			resend_message(mavlink_message_t *msg) { _mavlink_resend_uart(_channel, msg); }
-
 	void			handle_message(const mavlink_message_t *msg);
 
 	int			get_instance_id() const { return _instance_id; }
@@ -406,6 +412,14 @@ public:
 
 	float			get_rate_mult() const { return _rate_mult; }
 
+	/**
+	 * Get the rate multiplier for streams of the given priority class, high priority streams are not scaled
+	 */
+	float			get_rate_mult(MavlinkStream::Priority priority) const
+	{
+		return (priority == MavlinkStream::Priority::High) ? 1.f : _rate_mult_priority[(int)priority];
+	}
+
 	float			get_baudrate() { return _baudrate; }
 
 	/* Functions for waiting to start transmission until message received. */
@@ -415,11 +429,6 @@ public:
 	bool			get_wait_to_transmit() { return _wait_to_transmit; }
 	bool			should_transmit() { return (_transmitting_enabled && (!_wait_to_transmit || (_wait_to_transmit && _received_messages))); }
 
-	bool			message_buffer_write(const void *ptr, int size);
-
-	void			lockMessageBufferMutex(void) { pthread_mutex_lock(&_message_buffer_mutex); }
-	void			unlockMessageBufferMutex(void) { pthread_mutex_unlock(&_message_buffer_mutex); }
-
 	/**
 	 * Count transmitted bytes
 	 */
@@ -467,6 +476,25 @@ public:
 	bool			get_client_source_initialized() { return _src_addr_initialized; }
 #endif
 
+#if defined(MAVLINK_UDP_MMSG)
+	/**
+	 * Queue outgoing UDP datagrams of the calling thread until udp_tx_batch_end(), which sends them with as few
+	 * sendmmsg() calls as possible. Datagrams of other threads flush the queue right away.
+	 */
+	void			udp_tx_batch_begin();
+	void			udp_tx_batch_end();
+
+	/**
+	 * Count the datagrams received with a single recvmmsg() call
+	 */
+	void			count_udp_rx_batch(unsigned datagrams, unsigned truncated)
+	{
+		_udp_rx_syscalls++;
+		_udp_rx_datagrams += datagrams;
+		_udp_rx_truncated += truncated;
+	}
+#endif // MAVLINK_UDP_MMSG
+
 	uint64_t		get_start_time() { return _mavlink_start_time; }
 
 	static bool		boot_complete() { return _boot_complete; }
@@ -566,6 +594,17 @@ private:
 
 	List<MavlinkStream *>		_streams;
 
+	struct StreamScheduleEntry {
+		hrt_abstime due;
+		MavlinkStream *stream;
+	};
+
+	StreamScheduleEntry	*_stream_schedule{nullptr};	///< min-heap of all streams ordered by the time they are due
+	unsigned		_stream_schedule_size{0};
+	unsigned		_stream_schedule_capacity{0};
+	bool			_stream_schedule_invalid{true};	///< set whenever streams are added, removed or reconfigured
+	hrt_abstime		_last_housekeeping{0};		///< last full main loop iteration, wake-ups in between only update the streams
+
 	MavlinkShell		*_mavlink_shell{nullptr};
 	MavlinkULog		*_mavlink_ulog{nullptr};
 	static events::EventBuffer	*_event_buffer;
@@ -584,6 +623,11 @@ private:
 	int			_baudrate{57600};
 	int			_datarate{1000};		///< data rate for normal streams (attitude, position, etc.)
 	float			_rate_mult{1.0f};
+	float			_rate_mult_priority[(int)MavlinkStream::Priority::Count] {1.0f, 1.0f, 1.0f};
+
+	bool			_link_budget_enabled{false};	///< token bucket limiting non high priority streams to _datarate
+	float			_link_budget{0.f};		///< available bytes, consumed by every sent message
+	hrt_abstime		_link_budget_timestamp{0};
 
 	bool			_radio_status_available{false};
 	bool			_radio_status_critical{false};
@@ -634,6 +678,24 @@ private:
 	uint8_t			_buf[MAVLINK_MAX_PACKET_LEN] {};
 	unsigned		_buf_fill{0};
 
+#if defined(MAVLINK_UDP_MMSG)
+	static constexpr unsigned UDP_TX_BATCH_SIZE = 32;	///< max queued datagrams, each may additionally be broadcast
+
+	uint8_t			_udp_tx_buf[UDP_TX_BATCH_SIZE][MAVLINK_MAX_PACKET_LEN] {};
+	iovec			_udp_tx_iov[UDP_TX_BATCH_SIZE] {};
+	mmsghdr			_udp_tx_msgs[2 * UDP_TX_BATCH_SIZE] {};
+	unsigned		_udp_tx_queued{0};	///< number of datagrams in _udp_tx_buf
+	unsigned		_udp_tx_msg_count{0};	///< number of entries in _udp_tx_msgs
+	bool			_udp_tx_batching{false};
+	pthread_t		_udp_tx_batch_thread{};	///< thread whose sends are batched (main loop)
+
+	uint32_t		_udp_tx_syscalls{0};
+	uint32_t		_udp_tx_datagrams{0};
+	uint32_t		_udp_rx_syscalls{0};
+	uint32_t		_udp_rx_datagrams{0};
+	uint32_t		_udp_rx_truncated{0};
+#endif // MAVLINK_UDP_MMSG
+
 	bool			_tx_buffer_low{false};
 
 	const char 		*_interface_name{nullptr};
@@ -647,16 +709,29 @@ private:
 
 	ping_statistics_s	_ping_stats {};
 
-	struct mavlink_message_buffer {
-		int write_ptr;
-		int read_ptr;
-		int size;
-		char *data;
+	/**
+	 * Serialized message shared by all instances it is forwarded to. The frame is free
+	 * once the reference count drops to zero, each instance releases its reference after sending.
+	 */
+	struct ForwardFrame {
+		px4::atomic<uint8_t> refcount{0};
+		uint16_t len{0};
+		uint8_t data[MAVLINK_MAX_PACKET_LEN];
 	};
 
-	mavlink_message_buffer	_message_buffer {};
+	static constexpr int FORWARD_POOL_SIZE{16};
+	static constexpr int FORWARD_QUEUE_SIZE{8};	///< must be a power of two
+	static_assert((FORWARD_QUEUE_SIZE & (FORWARD_QUEUE_SIZE - 1)) == 0, "FORWARD_QUEUE_SIZE must be a power of two");
+
+	static ForwardFrame	*_forward_pool;		///< allocated while at least one instance forwards, guarded by mavlink_module_mutex
+	static int		_forward_pool_users;
+	static int		_forward_pool_next;
 
-	pthread_mutex_t		_message_buffer_mutex {};
+	/* single producer (forward_message() under mavlink_module_mutex), single consumer (this instance) */
+	ForwardFrame		*_forward_queue[FORWARD_QUEUE_SIZE] {};
+	px4::atomic<uint8_t>	_forward_queue_head{0};
+	px4::atomic<uint8_t>	_forward_queue_tail{0};
+	uint32_t		_forward_dropped{0};
 	pthread_mutex_t		_send_mutex {};
 	pthread_mutex_t         _radio_status_mutex {};
 
@@ -700,6 +775,24 @@ private:
 	 */
 	int configure_stream(const char *stream_name, const float rate = -1.0f);
 
+	/**
+	 * Update all streams which are due, in order of their deadline
+	 */
+	void update_streams(const hrt_abstime &t);
+
+	/**
+	 * Rebuild the stream schedule from _streams
+	 * @return false if the schedule could not be allocated
+	 */
+	bool rebuild_stream_schedule();
+
+	void stream_schedule_sift_down(unsigned index);
+
+	/**
+	 * Get the time to sleep until the next main loop iteration, which is shortened if a stream is due earlier
+	 */
+	unsigned get_main_loop_sleep();
+
 	/**
 	 * Configure default streams according to _mode for either all streams or only a single
 	 * stream.
@@ -708,19 +801,35 @@ private:
 	 */
 	int configure_streams_to_default(const char *configure_single_stream = nullptr);
 
-	int message_buffer_init(int size);
-
-	void message_buffer_destroy();
+	/**
+	 * Register this instance as user of the shared forwarding frame pool, allocating it if needed
+	 * @return 0 on success, <0 on error
+	 */
+	int forward_pool_attach();
 
-	int message_buffer_count();
+	/**
+	 * Release all frames still queued to this instance and free the pool with the last user
+	 */
+	void forward_pool_detach();
 
-	int message_buffer_is_empty() const { return (_message_buffer.read_ptr == _message_buffer.write_ptr); }
+	/**
+	 * Get a free frame from the pool, must be called with mavlink_module_mutex held
+	 * @return nullptr if all frames are in use
+	 */
+	static ForwardFrame *forward_frame_alloc();
 
-	int message_buffer_get_ptr(void **ptr, bool *is_part);
+	static void forward_frame_release(ForwardFrame *frame);
 
-	void message_buffer_mark_read(int n) { _message_buffer.read_ptr = (_message_buffer.read_ptr + n) % _message_buffer.size; }
+	/**
+	 * Queue a frame for sending, must be called with mavlink_module_mutex held
+	 * @return false if the queue is full
+	 */
+	bool forward_queue_push(ForwardFrame *frame);
 
-	void pass_message(const mavlink_message_t *msg);
+	/**
+	 * Send all frames forwarded to this instance
+	 */
+	void forward_queue_send();
 
 	void publish_telemetry_status();
 
@@ -739,12 +848,39 @@ private:
 	 */
 	void update_rate_mult();
 
+	/**
+	 * Refill the link budget at _datarate, on serial links without flow control
+	 */
+	void update_link_budget(const hrt_abstime &t);
+
+	/**
+	 * @return true if the link budget allows sending a message of the given stream now
+	 */
+	bool link_budget_allows(MavlinkStream &stream);
+
+	/**
+	 * @return part of the link budget kept for normal and high priority messages
+	 */
+	float link_budget_reserve() const;
+
 #if defined(MAVLINK_UDP)
 	void find_broadcast_address();
 
 	void init_udp();
 #endif // MAVLINK_UDP
 
+#if defined(MAVLINK_UDP_MMSG)
+	/**
+	 * Queue the datagram in _buf for the partner and optionally the broadcast address. Called with _send_mutex held.
+	 */
+	void udp_tx_queue(bool broadcast);
+
+	/**
+	 * Send all queued datagrams. Called with _send_mutex held.
+	 */
+	void udp_tx_flush();
+#endif // MAVLINK_UDP_MMSG
+
 
 	void set_channel();
 
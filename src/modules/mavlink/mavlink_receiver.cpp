@@ -3178,6 +3178,58 @@ MavlinkReceiver::handle_message_gimbal_device_information(mavlink_message_t *msg
 	_gimbal_device_information_pub.publish(gimbal_information);
 }
 
+#if defined(MAVLINK_UDP_MMSG)
+/**
+ * Receive up to UDP_RX_BATCH_SIZE datagrams with a single recvmmsg() call, each into its own slot of buf.
+ * The datagrams are then moved next to each other, so they can be parsed as one stream.
+ * Datagrams which do not fit into a slot are dropped.
+ * @return number of bytes in buf, -1 on error
+ */
+static ssize_t recv_udp_batch(Mavlink *mavlink, uint8_t *buf, size_t buf_size, sockaddr_in &srcaddr)
+{
+	static constexpr unsigned UDP_RX_BATCH_SIZE = 5;
+	const size_t slot_size = buf_size / UDP_RX_BATCH_SIZE;
+
+	mmsghdr msgs[UDP_RX_BATCH_SIZE] {};
+	iovec iov[UDP_RX_BATCH_SIZE];
+	sockaddr_in addr[UDP_RX_BATCH_SIZE];
+
+	for (unsigned i = 0; i < UDP_RX_BATCH_SIZE; i++) {
+		iov[i].iov_base = buf + i * slot_size;
+		iov[i].iov_len = slot_size;
+		msgs[i].msg_hdr.msg_name = &addr[i];
+		msgs[i].msg_hdr.msg_namelen = sizeof(addr[i]);
+		msgs[i].msg_hdr.msg_iov = &iov[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	const int received = recvmmsg(mavlink->get_socket_fd(), msgs, UDP_RX_BATCH_SIZE, MSG_DONTWAIT, nullptr);
+
+	if (received <= 0) {
+		return -1;
+	}
+
+	size_t len = 0;
+	unsigned truncated = 0;
+
+	for (int i = 0; i < received; i++) {
+		if (msgs[i].msg_hdr.msg_flags & MSG_TRUNC) {
+			truncated++;
+			continue;
+		}
+
+		// buf + len is never past the start of slot i, so this only moves data down
+		memmove(buf + len, iov[i].iov_base, msgs[i].msg_len);
+		len += msgs[i].msg_len;
+	}
+
+	srcaddr = addr[received - 1];
+	mavlink->count_udp_rx_batch(received, truncated);
+
+	return len;
+}
+#endif // MAVLINK_UDP_MMSG
+
 void
 MavlinkReceiver::run()
 {
@@ -3212,7 +3264,9 @@ MavlinkReceiver::run()
 
 #if defined(MAVLINK_UDP)
 	struct sockaddr_in srcaddr = {};
+# if !defined(MAVLINK_UDP_MMSG)
 	socklen_t addrlen = sizeof(srcaddr);
+# endif // !MAVLINK_UDP_MMSG
 
 	if (_mavlink->get_protocol() == Protocol::UDP) {
 		fds[0].fd = _mavlink->get_socket_fd();
@@ -3252,7 +3306,11 @@ MavlinkReceiver::run()
 
 			else if (_mavlink->get_protocol() == Protocol::UDP) {
 				if (fds[0].revents & POLLIN) {
+# if defined(MAVLINK_UDP_MMSG)
+					nread = recv_udp_batch(_mavlink, buf, sizeof(buf), srcaddr);
+# else
 					nread = recvfrom(_mavlink->get_socket_fd(), buf, sizeof(buf), 0, (struct sockaddr *)&srcaddr, &addrlen);
+# endif // MAVLINK_UDP_MMSG
 				}
 
 				struct sockaddr_in &srcaddr_last = _mavlink->get_client_source_address();
@@ -3399,9 +3457,18 @@ bool MavlinkReceiver::component_was_seen(int system_id, int component_id)
 		return _component_states_count > 0;
 	}
 
+	// most forwarded messages target a system that was never seen on this link
+	if ((_seen_system_ids[(system_id & 0xFF) / 32] & (1u << (system_id & 31))) == 0) {
+		return false;
+	}
+
+	if (component_id == 0) {
+		return true;
+	}
+
 	for (unsigned i = 0; i < _component_states_count; ++i) {
 		if (_component_states[i].system_id == system_id
-		    && (component_id == 0 || _component_states[i].component_id == component_id)) {
+		    && _component_states[i].component_id == component_id) {
 			return true;
 		}
 	}
@@ -3444,6 +3511,7 @@ void MavlinkReceiver::update_rx_stats(const mavlink_message_t &message)
 				++_component_states[i].received_messages;
 				_component_states[i].last_sequence = message.seq;
 
+				_seen_system_ids[message.sysid / 32] |= 1u << (message.sysid % 32);
 				_component_states_count = i + 1;
 
 				// Also update overall stats
@@ -274,6 +274,7 @@ private:
 	};
 	ComponentState _component_states[MAX_REMOTE_COMPONENTS] {};
 	unsigned _component_states_count{0};
+	uint32_t _seen_system_ids[256 / 32] {};	///< bitmap of the system ids in _component_states, used to filter forwarded messages
 	bool _warned_component_states_full_once{false};
 
 	bool _message_statistics_enabled {false};
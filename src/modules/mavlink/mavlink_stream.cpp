@@ -66,6 +66,7 @@ MavlinkStream::update(const hrt_abstime &t)
 		// on the link scheduling
 		if (send()) {
 			_last_sent = hrt_absolute_time();
+			_sent_count++;
 
 			if (!_first_message_sent) {
 				_first_message_sent = true;
@@ -85,7 +86,7 @@ MavlinkStream::update(const hrt_abstime &t)
 	int interval = _interval;
 
 	if (!const_rate()) {
-		interval /= _mavlink->get_rate_mult();
+		interval /= _mavlink->get_rate_mult(priority());
 	}
 
 	// We don't need to send anything if the inverval is 0. send() will be called manually.
@@ -105,7 +106,7 @@ MavlinkStream::update(const hrt_abstime &t)
 	// This method is not theoretically optimal but a suitable
 	// stopgap as it hits its deadlines well (0.5 Hz, 50 Hz and 250 Hz)
 
-	if (unlimited_rate || (dt > (interval - (_mavlink->get_main_loop_delay() / 10) * 3))) {
+	if (unlimited_rate || (dt > (interval - (int64_t)(_mavlink->get_main_loop_delay() / 10) * 3))) {
 		// interval expired, send message
 
 		// If the interval is non-zero and dt is smaller than 1.5 times the interval
@@ -114,6 +115,7 @@ MavlinkStream::update(const hrt_abstime &t)
 		// long time not sending anything, sending multiple messages in a short time is avoided.
 		if (send()) {
 			_last_sent = ((interval > 0) && ((int64_t)(1.5f * interval) > dt)) ? _last_sent + interval : t;
+			_sent_count++;
 
 			if (!_first_message_sent) {
 				_first_message_sent = true;
@@ -128,3 +130,47 @@ MavlinkStream::update(const hrt_abstime &t)
 
 	return -1;
 }
+
+hrt_abstime
+MavlinkStream::get_next_update()
+{
+	int interval = _interval;
+
+	if (!const_rate()) {
+		interval /= _mavlink->get_rate_mult(priority());
+	}
+
+	if (_last_sent == 0 || interval < 0 || update_data_every_iteration()) {
+		return 0;
+	}
+
+	if (interval == 0) {
+		return UINT64_MAX;
+	}
+
+	// update() sends once dt exceeds the interval minus 30% of the main loop delay
+	const int64_t send_after = interval - (int64_t)(_mavlink->get_main_loop_delay() / 10) * 3;
+
+	if (send_after < 0) {
+		return 0;
+	}
+
+	return _last_sent + send_after + 1;
+}
+
+unsigned
+MavlinkStream::get_poll_interval()
+{
+	int interval = _interval;
+
+	if (!const_rate()) {
+		interval /= _mavlink->get_rate_mult(priority());
+	}
+
+	if (interval <= 0 || update_data_every_iteration()) {
+		return 0;
+	}
+
+	// new data is picked up at the latest one interval later, which does not exceed the configured rate
+	return interval;
+}
@@ -52,6 +52,17 @@ class MavlinkStream : public ListNode<MavlinkStream *>
 
 public:
 
+	/**
+	 * Priority class of a stream, used to decide which streams are slowed down first on a congested link
+	 */
+	enum class Priority : uint8_t {
+		Low = 0,	///< scaled down first, and only sent while the link budget has spare capacity
+		Normal,		///< scaled down once low priority streams are at their minimum rate
+		High,		///< never scaled down or held back by the link budget
+
+		Count
+	};
+
 	MavlinkStream(Mavlink *mavlink);
 	virtual ~MavlinkStream() = default;
 
@@ -79,6 +90,21 @@ public:
 	 * @return 0 if updated / sent, -1 if unchanged
 	 */
 	int update(const hrt_abstime &t);
+
+	/**
+	 * Get the time at which update() will send the next message, using the current rate multiplier
+	 *
+	 * @return 0 if the stream needs to be updated as soon as possible, UINT64_MAX if it is only sent on request
+	 */
+	hrt_abstime get_next_update();
+
+	/**
+	 * Get the time after which a stream that had nothing to send has to be updated again
+	 *
+	 * @return 0 if it needs to be updated in every iteration, otherwise its interval
+	 */
+	unsigned get_poll_interval();
+
 	virtual const char *get_name() const = 0;
 	virtual uint16_t get_id() = 0;
 
@@ -87,6 +113,11 @@ public:
 	 */
 	virtual bool const_rate() { return false; }
 
+	/**
+	 * @return priority class of the stream, high priority streams are treated like const_rate() streams
+	 */
+	virtual Priority priority() const { return Priority::Normal; }
+
 	/**
 	 * Get maximal total messages size on update
 	 */
@@ -122,6 +153,22 @@ public:
 	 */
 	void reset_last_sent() { _last_sent = 0; }
 
+	/**
+	 * @return rate at which update() actually sent messages during the last measurement period [Hz]
+	 */
+	float get_achieved_rate() const { return _achieved_rate; }
+
+	/**
+	 * Compute the achieved rate from the messages sent since the last call
+	 *
+	 * @param dt measurement period [s]
+	 */
+	void update_achieved_rate(float dt)
+	{
+		_achieved_rate = _sent_count / dt;
+		_sent_count = 0;
+	}
+
 protected:
 	Mavlink      *const _mavlink;
 	int _interval{1000000};		///< if set to negative value = unlimited rate
@@ -132,13 +179,23 @@ protected:
 	 * Function to collect/update data for the streams at a high rate independant of
 	 * actual stream rate.
 	 *
-	 * This function is called at every iteration of the mavlink module.
+	 * This function is called on every update(), which happens at every iteration
+	 * of the mavlink module if update_data_every_iteration() returns true, otherwise
+	 * only when the stream is due.
 	 */
 	virtual void update_data() { }
 
+	/**
+	 * @return true if update_data() needs to be called at every iteration of the mavlink module
+	 */
+	virtual bool update_data_every_iteration() const { return false; }
+
 private:
 	hrt_abstime _last_sent{0};
 	bool _first_message_sent{false};
+
+	uint16_t _sent_count{0};
+	float _achieved_rate{0.f};
 };
 
 
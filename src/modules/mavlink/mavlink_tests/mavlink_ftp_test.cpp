@@ -38,6 +38,7 @@
 #include <crc32.h>
 #include <stdio.h>
 #include <fcntl.h>
+#include <mathlib/mathlib.h>
 
 #include "mavlink_ftp_test.h"
 #include "../mavlink_ftp.h"
@@ -54,6 +55,21 @@ static const char *_test_files[] = {
 	PX4_MAVLINK_TEST_DATA_DIR  "/" "test_240.data"
 };
 
+static const char *_throughput_test_file = PX4_MAVLINK_TEST_DATA_DIR "/" "test_throughput.data";
+
+// not a multiple of the packet size or the FTP read-ahead buffer size
+#ifdef __PX4_NUTTX
+static constexpr uint32_t THROUGHPUT_TEST_FILE_SIZE = 256 * 1024 + 17;
+#else
+static constexpr uint32_t THROUGHPUT_TEST_FILE_SIZE = 4 * 1024 * 1024 + 17;
+#endif
+
+/// Content of the throughput test file at the given offset
+static uint8_t throughput_test_byte(uint32_t offset)
+{
+	return (uint8_t)(offset ^ (offset >> 8) ^ (offset >> 16));
+}
+
 constexpr uint32_t MAX_DATA_LEN = MAVLINK_MSG_FILE_TRANSFER_PROTOCOL_FIELD_PAYLOAD_LEN - sizeof(
 		MavlinkFTP::PayloadHeader);
 
@@ -137,6 +153,8 @@ bool MavlinkFtpTest::_remove_test_files()
 		::unlink(_test_files[i]);
 	}
 
+	::unlink(_throughput_test_file);
+
 	::rmdir(PX4_MAVLINK_TEST_DATA_DIR "/empty_dir");
 	::rmdir(PX4_MAVLINK_TEST_DATA_DIR);
 
@@ -644,6 +662,101 @@ bool MavlinkFtpTest::_burst_test()
 	return true;
 }
 
+/// @brief Streams a large file with a single burst and reports the download throughput.
+bool MavlinkFtpTest::_burst_throughput_test()
+{
+	MavlinkFTP::PayloadHeader		payload {};
+	const MavlinkFTP::PayloadHeader		*reply;
+	ThroughputInfo				throughput_info {};
+
+	int fd = ::open(_throughput_test_file, O_CREAT | O_TRUNC | O_WRONLY, S_IRWXU | S_IRWXG | S_IRWXO);
+	ut_assert("open failed", fd != -1);
+
+	uint8_t chunk[512];
+	bool write_failed = false;
+
+	for (uint32_t offset = 0; offset < THROUGHPUT_TEST_FILE_SIZE; offset += sizeof(chunk)) {
+		const uint32_t len = math::min((uint32_t)sizeof(chunk), THROUGHPUT_TEST_FILE_SIZE - offset);
+
+		for (uint32_t i = 0; i < len; i++) {
+			chunk[i] = throughput_test_byte(offset + i);
+		}
+
+		if (::write(fd, chunk, len) != (ssize_t)len) {
+			write_failed = true;
+			break;
+		}
+	}
+
+	::close(fd);
+	ut_assert("Could not write test file", !write_failed);
+
+	payload.opcode = MavlinkFTP::kCmdOpenFileRO;
+	payload.offset = 0;
+	payload.size = strlen(_throughput_test_file) + 1;
+
+	bool success = _send_receive_msg(&payload,			// FTP payload header
+					 (uint8_t *)_throughput_test_file,	// Data to start into FTP message payload
+					 payload.size,			// size in bytes of data
+					 &reply);			// Payload inside FTP message response
+
+	if (!success) {
+		return false;
+	}
+
+	ut_compare("Didn't get Ack back", reply->opcode, MavlinkFTP::kRspAck);
+
+	throughput_info.ftp_test_class = this;
+	throughput_info.file_size = THROUGHPUT_TEST_FILE_SIZE;
+	_ftp_server->set_unittest_worker(MavlinkFtpTest::receive_message_handler_throughput, &throughput_info);
+
+	payload.opcode = MavlinkFTP::kCmdBurstReadFile;
+	payload.session = reply->session;
+	payload.offset = 0;
+	payload.size = MAX_DATA_LEN;
+
+	mavlink_message_t msg;
+	_setup_ftp_msg(&payload, nullptr, 0, &msg);
+
+	const hrt_abstime start = hrt_absolute_time();
+
+	_ftp_server->handle_message(&msg);
+
+	// without a link to throttle it, a single send streams the whole file
+	_ftp_server->send();
+
+	const hrt_abstime elapsed = hrt_elapsed_time(&start);
+
+	_ftp_server->set_unittest_worker(MavlinkFtpTest::receive_message_handler_generic, this);
+
+	ut_assert("Invalid burst packet", !throughput_info.failed);
+	ut_assert("Burst did not end with EOF", throughput_info.eof);
+	ut_compare("Incomplete download", throughput_info.next_offset, THROUGHPUT_TEST_FILE_SIZE);
+
+	PX4_INFO("burst download: %" PRIu32 " bytes in %.1f ms (%.2f MB/s)", THROUGHPUT_TEST_FILE_SIZE,
+		 (double)elapsed * 1e-3, (double)THROUGHPUT_TEST_FILE_SIZE / math::max(elapsed, (hrt_abstime)1));
+
+	// Terminate session
+	payload.opcode = MavlinkFTP::kCmdTerminateSession;
+	payload.session = reply->session;
+	payload.size = 0;
+
+	success = _send_receive_msg(&payload,	// FTP payload header
+				    nullptr,	// Data to start into FTP message payload
+				    0,		// size in bytes of data
+				    &reply);	// Payload inside FTP message response
+
+	::unlink(_throughput_test_file);
+
+	if (!success) {
+		return false;
+	}
+
+	ut_compare("Didn't get Ack back", reply->opcode, MavlinkFTP::kRspAck);
+
+	return true;
+}
+
 /// @brief Tests for correct reponse to a Read command on an invalid session.
 bool MavlinkFtpTest::_read_badsession_test()
 {
@@ -929,6 +1042,47 @@ bool MavlinkFtpTest::_receive_message_handler_burst(const mavlink_file_transfer_
 	return true;
 }
 
+/// Static method used as callback from MavlinkFTP for the burst throughput test.
+void MavlinkFtpTest::receive_message_handler_throughput(const mavlink_file_transfer_protocol_t *ftp_req,
+		void *worker_data)
+{
+	ThroughputInfo *throughput_info = (ThroughputInfo *)worker_data;
+
+	if (!throughput_info->ftp_test_class->_receive_message_handler_throughput(ftp_req, throughput_info)) {
+		throughput_info->failed = true;
+	}
+}
+
+bool MavlinkFtpTest::_receive_message_handler_throughput(const mavlink_file_transfer_protocol_t *ftp_msg,
+		ThroughputInfo *throughput_info)
+{
+	const MavlinkFTP::PayloadHeader *reply{nullptr};
+
+	_decode_message(ftp_msg, &reply);
+
+	ut_assert("Packet after EOF", !throughput_info->eof);
+
+	if (reply->opcode == MavlinkFTP::kRspNak) {
+		ut_compare("Nak is not EOF", reply->data[0], MavlinkFTP::kErrEOF);
+		throughput_info->eof = true;
+		return true;
+	}
+
+	const uint32_t expected_bytes = math::min(MAX_DATA_LEN, throughput_info->file_size - throughput_info->next_offset);
+
+	ut_compare("Didn't get Ack back", reply->opcode, MavlinkFTP::kRspAck);
+	ut_compare("Offset incorrect", reply->offset, throughput_info->next_offset);
+	ut_compare("Payload size incorrect", reply->size, expected_bytes);
+
+	for (uint32_t i = 0; i < expected_bytes; i++) {
+		ut_compare("File contents differ", reply->data[i], throughput_test_byte(reply->offset + i));
+	}
+
+	throughput_info->next_offset += expected_bytes;
+
+	return true;
+}
+
 /// @brief Decode and validate the incoming message
 bool MavlinkFtpTest::_decode_message(const mavlink_file_transfer_protocol_t	*ftp_msg,	///< Incoming FTP message
 				     const MavlinkFTP::PayloadHeader		**payload)	///< Payload inside FTP message response
@@ -1017,6 +1171,7 @@ bool MavlinkFtpTest::run_tests()
 	ut_run_test(_read_test);
 	ut_run_test(_read_badsession_test);
 	ut_run_test(_burst_test);
+	ut_run_test(_burst_throughput_test);
 	ut_run_test(_removedirectory_test);
 	ut_run_test(_createdirectory_test);
 	ut_run_test(_removefile_test);
@@ -65,6 +65,17 @@ public:
 
 	static void receive_message_handler_burst(const mavlink_file_transfer_protocol_t *ftp_req, void *worker_data);
 
+	/// Worker data for throughput handler
+	struct ThroughputInfo {
+		MavlinkFtpTest		*ftp_test_class;
+		uint32_t		file_size;
+		uint32_t		next_offset;
+		bool			eof;
+		bool			failed;
+	};
+
+	static void receive_message_handler_throughput(const mavlink_file_transfer_protocol_t *ftp_req, void *worker_data);
+
 	static const uint8_t serverSystemId = 50;	///< System ID for server
 	static const uint8_t serverComponentId = 1;	///< Component ID for server
 	static const uint8_t serverChannel = 0;		///< Channel to send to
@@ -93,6 +104,7 @@ private:
 	bool _read_test(void);
 	bool _read_badsession_test(void);
 	bool _burst_test(void);
+	bool _burst_throughput_test(void);
 	bool _removedirectory_test(void);
 	bool _createdirectory_test(void);
 	bool _removefile_test(void);
@@ -128,6 +140,8 @@ private:
 	};
 
 	bool _receive_message_handler_burst(const mavlink_file_transfer_protocol_t *ftp_req, BurstInfo *burst_info);
+	bool _receive_message_handler_throughput(const mavlink_file_transfer_protocol_t *ftp_req,
+			ThroughputInfo *throughput_info);
 
 	MavlinkFTP	*_ftp_server;
 	uint16_t	_expected_seq_number;
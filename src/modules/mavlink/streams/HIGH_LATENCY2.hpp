@@ -487,6 +487,8 @@ private:
 		return false;
 	}
 
+	bool update_data_every_iteration() const override { return true; }
+
 	void update_data() override
 	{
 		const hrt_abstime t = hrt_absolute_time();
@@ -51,6 +51,8 @@ MulticopterRateControl::MulticopterRateControl(bool vtol) :
 {
 	_vehicle_status.vehicle_type = vehicle_status_s::VEHICLE_TYPE_ROTARY_WING;
 
+	EnableLatencyHistogramIfConfigured();
+
 	parameters_updated();
 	_controller_status_pub.advertise();
 }
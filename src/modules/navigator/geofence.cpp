@@ -69,6 +69,10 @@ Geofence::~Geofence()
 	if (_polygons) {
 		delete[](_polygons);
 	}
+
+	delete[](_vertices);
+	delete[](_band_offsets);
+	delete[](_band_edges);
 }
 
 void Geofence::updateFence()
@@ -178,6 +182,176 @@ void Geofence::_updateFence()
 
 	}
 
+	_updateVertexCache();
+}
+
+void Geofence::_updateVertexCache()
+{
+	delete[](_vertices);
+	delete[](_band_offsets);
+	delete[](_band_edges);
+	_vertices = nullptr;
+	_band_offsets = nullptr;
+	_band_edges = nullptr;
+	_num_vertices = 0;
+
+	for (int polygon_idx = 0; polygon_idx < _num_polygons; ++polygon_idx) {
+		PolygonInfo &polygon = _polygons[polygon_idx];
+		const bool is_circle = polygon.fence_type == NAV_CMD_FENCE_CIRCLE_INCLUSION
+				       || polygon.fence_type == NAV_CMD_FENCE_CIRCLE_EXCLUSION;
+		polygon.vertex_index = _num_vertices;
+		_num_vertices += is_circle ? 1 : polygon.vertex_count;
+	}
+
+	if (_num_vertices == 0) {
+		return;
+	}
+
+	_vertices = new FenceVertex[_num_vertices];
+
+	if (!_vertices) {
+		PX4_ERR("alloc failed");
+		_num_polygons = 0;
+		return;
+	}
+
+	// read all vertices once and compute the bounding boxes
+	int total_num_bands = 0;
+
+	for (int polygon_idx = 0; polygon_idx < _num_polygons; ++polygon_idx) {
+		PolygonInfo &polygon = _polygons[polygon_idx];
+		const bool is_circle = polygon.fence_type == NAV_CMD_FENCE_CIRCLE_INCLUSION
+				       || polygon.fence_type == NAV_CMD_FENCE_CIRCLE_EXCLUSION;
+		const int vertex_count = is_circle ? 1 : polygon.vertex_count;
+
+		polygon.valid = true;
+		polygon.lat_min = polygon.lon_min = DBL_MAX;
+		polygon.lat_max = polygon.lon_max = -DBL_MAX;
+
+		// read the vertices in chunks, with one dataman request each
+		static constexpr int chunk_length = 8;
+		mission_fence_point_s mission_fence_points[chunk_length];
+
+		for (int i = 0; i < vertex_count; ++i) {
+			const int chunk_index = i % chunk_length;
+
+			if (chunk_index == 0) {
+				const int chunk_size = math::min(vertex_count - i, chunk_length);
+
+				if (dm_read_range(DM_KEY_FENCE_POINTS, polygon.dataman_index + i, mission_fence_points,
+						  sizeof(mission_fence_point_s), chunk_size) != chunk_size) {
+					PX4_ERR("dm_read failed");
+					polygon.valid = false;
+					break;
+				}
+			}
+
+			const mission_fence_point_s &mission_fence_point = mission_fence_points[chunk_index];
+
+			if (mission_fence_point.frame != NAV_FRAME_GLOBAL && mission_fence_point.frame != NAV_FRAME_GLOBAL_INT
+			    && mission_fence_point.frame != NAV_FRAME_GLOBAL_RELATIVE_ALT
+			    && mission_fence_point.frame != NAV_FRAME_GLOBAL_RELATIVE_ALT_INT) {
+				// TODO: handle different frames
+				PX4_ERR("Frame type %i not supported", (int)mission_fence_point.frame);
+				polygon.valid = false;
+				break;
+			}
+
+			FenceVertex &vertex = _vertices[polygon.vertex_index + i];
+			vertex.lat = mission_fence_point.lat;
+			vertex.lon = mission_fence_point.lon;
+
+			polygon.lat_min = math::min(polygon.lat_min, vertex.lat);
+			polygon.lat_max = math::max(polygon.lat_max, vertex.lat);
+			polygon.lon_min = math::min(polygon.lon_min, vertex.lon);
+			polygon.lon_max = math::max(polygon.lon_max, vertex.lon);
+		}
+
+		polygon.band_index = total_num_bands;
+		polygon.band_count = 0;
+
+		if (polygon.valid && !is_circle) {
+			if (polygon.lon_max > polygon.lon_min) {
+				polygon.band_count = math::constrain(vertex_count / VERTICES_PER_BAND, 1, MAX_BANDS_PER_POLYGON);
+
+			} else {
+				polygon.band_count = 1; // degenerate polygon
+			}
+
+			total_num_bands += polygon.band_count;
+		}
+	}
+
+	if (total_num_bands == 0) {
+		return;
+	}
+
+	// sort the polygon edges into the longitude bands they cross (counting sort, edge i connects vertex i-1 and i)
+	_band_offsets = new uint16_t[total_num_bands + 1] {};
+
+	if (!_band_offsets) {
+		PX4_ERR("alloc failed");
+		_num_polygons = 0;
+		return;
+	}
+
+	for (int pass = 0; pass < 2; ++pass) {
+		for (int polygon_idx = 0; polygon_idx < _num_polygons; ++polygon_idx) {
+			const PolygonInfo &polygon = _polygons[polygon_idx];
+
+			if (polygon.band_count == 0) {
+				continue;
+			}
+
+			const FenceVertex *vertices = &_vertices[polygon.vertex_index];
+
+			for (int i = 0, j = polygon.vertex_count - 1; i < polygon.vertex_count; j = i++) {
+				const int band_first = bandIndex(polygon, math::min(vertices[i].lon, vertices[j].lon));
+				const int band_last = bandIndex(polygon, math::max(vertices[i].lon, vertices[j].lon));
+
+				for (int band = polygon.band_index + band_first; band <= polygon.band_index + band_last; ++band) {
+					if (pass == 0) {
+						++_band_offsets[band + 1];
+
+					} else {
+						_band_edges[_band_offsets[band]++] = i;
+					}
+				}
+			}
+		}
+
+		if (pass == 0) {
+			for (int band = 0; band < total_num_bands; ++band) {
+				_band_offsets[band + 1] += _band_offsets[band];
+			}
+
+			_band_edges = new uint16_t[_band_offsets[total_num_bands]];
+
+			if (!_band_edges) {
+				PX4_ERR("alloc failed");
+				_num_polygons = 0;
+				return;
+			}
+
+		} else {
+			// filling advanced every offset to the start of the next band, shift them back
+			for (int band = total_num_bands; band > 0; --band) {
+				_band_offsets[band] = _band_offsets[band - 1];
+			}
+
+			_band_offsets[0] = 0;
+		}
+	}
+}
+
+int Geofence::bandIndex(const PolygonInfo &polygon, double lon)
+{
+	if (polygon.band_count <= 1) {
+		return 0;
+	}
+
+	const int band = (int)((lon - polygon.lon_min) / (polygon.lon_max - polygon.lon_min) * polygon.band_count);
+	return math::constrain(band, 0, polygon.band_count - 1);
 }
 
 bool Geofence::checkAll(const struct vehicle_global_position_s &global_position)
@@ -312,8 +486,9 @@ bool Geofence::checkAll(double lat, double lon, float altitude)
 
 bool Geofence::isInsidePolygonOrCircle(double lat, double lon, float altitude)
 {
-	// the following uses dm_read, so first we try to lock all items. If that fails, it (most likely) means
-	// the data is currently being updated (via a mavlink geofence transfer), and we do not check for a violation now
+	// the fence is checked against the in-memory copy, dataman is only read to detect updates. First we try to lock
+	// all items. If that fails, it (most likely) means the data is currently being updated (via a mavlink geofence
+	// transfer), and we do not check for a violation now
 	if (dm_trylock(DM_KEY_FENCE_POINTS) != 0) {
 		return true;
 	}
@@ -388,39 +563,35 @@ bool Geofence::isInsidePolygonOrCircle(double lat, double lon, float altitude)
 
 bool Geofence::insidePolygon(const PolygonInfo &polygon, double lat, double lon, float altitude)
 {
+	if (!polygon.valid) {
+		return false;
+	}
+
+	// points outside of the bounding box can never be inside
+	if (lat < polygon.lat_min || lat > polygon.lat_max || lon < polygon.lon_min || lon > polygon.lon_max) {
+		return false;
+	}
 
 	/* Adaptation of algorithm originally presented as
 	 * PNPOLY - Point Inclusion in Polygon Test
 	 * W. Randolph Franklin (WRF)
 	 * Only supports non-complex polygons (not self intersecting)
+	 *
+	 * Only the edges crossing the longitude band of the point can toggle the result, so only those are tested.
 	 */
 
-	mission_fence_point_s temp_vertex_i;
-	mission_fence_point_s temp_vertex_j;
+	const FenceVertex *vertices = &_vertices[polygon.vertex_index];
+	const int band = polygon.band_index + bandIndex(polygon, lon);
 	bool c = false;
 
-	for (unsigned i = 0, j = polygon.vertex_count - 1; i < polygon.vertex_count; j = i++) {
-		if (dm_read(DM_KEY_FENCE_POINTS, polygon.dataman_index + i, &temp_vertex_i,
-			    sizeof(mission_fence_point_s)) != sizeof(mission_fence_point_s)) {
-			break;
-		}
+	for (unsigned k = _band_offsets[band]; k < _band_offsets[band + 1]; ++k) {
+		const unsigned i = _band_edges[k];
+		const unsigned j = (i == 0) ? polygon.vertex_count - 1 : i - 1;
+		const FenceVertex &vertex_i = vertices[i];
+		const FenceVertex &vertex_j = vertices[j];
 
-		if (dm_read(DM_KEY_FENCE_POINTS, polygon.dataman_index + j, &temp_vertex_j,
-			    sizeof(mission_fence_point_s)) != sizeof(mission_fence_point_s)) {
-			break;
-		}
-
-		if (temp_vertex_i.frame != NAV_FRAME_GLOBAL && temp_vertex_i.frame != NAV_FRAME_GLOBAL_INT
-		    && temp_vertex_i.frame != NAV_FRAME_GLOBAL_RELATIVE_ALT
-		    && temp_vertex_i.frame != NAV_FRAME_GLOBAL_RELATIVE_ALT_INT) {
-			// TODO: handle different frames
-			PX4_ERR("Frame type %i not supported", (int)temp_vertex_i.frame);
-			break;
-		}
-
-		if (((double)temp_vertex_i.lon >= lon) != ((double)temp_vertex_j.lon >= lon) &&
-		    (lat <= (double)(temp_vertex_j.lat - temp_vertex_i.lat) * (lon - (double)temp_vertex_i.lon) /
-		     (double)(temp_vertex_j.lon - temp_vertex_i.lon) + (double)temp_vertex_i.lat)) {
+		if ((vertex_i.lon >= lon) != (vertex_j.lon >= lon) &&
+		    (lat <= (vertex_j.lat - vertex_i.lat) * (lon - vertex_i.lon) / (vertex_j.lon - vertex_i.lon) + vertex_i.lat)) {
 			c = !c;
 		}
 	}
@@ -430,22 +601,11 @@ bool Geofence::insidePolygon(const PolygonInfo &polygon, double lat, double lon,
 
 bool Geofence::insideCircle(const PolygonInfo &polygon, double lat, double lon, float altitude)
 {
-
-	mission_fence_point_s circle_point;
-
-	if (dm_read(DM_KEY_FENCE_POINTS, polygon.dataman_index, &circle_point,
-		    sizeof(mission_fence_point_s)) != sizeof(mission_fence_point_s)) {
-		PX4_ERR("dm_read failed");
+	if (!polygon.valid) {
 		return false;
 	}
 
-	if (circle_point.frame != NAV_FRAME_GLOBAL && circle_point.frame != NAV_FRAME_GLOBAL_INT
-	    && circle_point.frame != NAV_FRAME_GLOBAL_RELATIVE_ALT
-	    && circle_point.frame != NAV_FRAME_GLOBAL_RELATIVE_ALT_INT) {
-		// TODO: handle different frames
-		PX4_ERR("Frame type %i not supported", (int)circle_point.frame);
-		return false;
-	}
+	const FenceVertex &center = _vertices[polygon.vertex_index];
 
 	if (!_projection_reference.isInitialized()) {
 		_projection_reference.initReference(lat, lon);
@@ -453,9 +613,9 @@ bool Geofence::insideCircle(const PolygonInfo &polygon, double lat, double lon,
 
 	float x1, y1, x2, y2;
 	_projection_reference.project(lat, lon, x1, y1);
-	_projection_reference.project(circle_point.lat, circle_point.lon, x2, y2);
+	_projection_reference.project(center.lat, center.lon, x2, y2);
 	float dx = x1 - x2, dy = y1 - y2;
-	return dx * dx + dy * dy < circle_point.circle_radius * circle_point.circle_radius;
+	return dx * dx + dy * dy < polygon.circle_radius * polygon.circle_radius;
 }
 
 bool
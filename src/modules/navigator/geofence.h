@@ -169,10 +169,33 @@ private:
 			uint16_t vertex_count;
 			float circle_radius;
 		};
+		uint16_t vertex_index; ///< index of the first vertex (or the circle center) in _vertices
+		uint16_t band_index; ///< index of the first longitude band in _band_offsets
+		uint16_t band_count; ///< number of longitude bands the bounding box is split into
+		bool valid; ///< false if the vertices could not be read or use an unsupported frame
+		double lat_min, lat_max, lon_min, lon_max; ///< bounding box
 	};
 	PolygonInfo *_polygons{nullptr};
 	int _num_polygons{0};
 
+	struct FenceVertex {
+		double lat;
+		double lon;
+	};
+
+	/*
+	 * In-memory copy of the fence vertices, so that a check does not need to access dataman.
+	 * The bounding box of each polygon is split into longitude bands, and for each band the edges crossing it
+	 * are listed in _band_edges[_band_offsets[band] .. _band_offsets[band + 1]), which limits the point in polygon
+	 * test to the few edges that can actually be crossed.
+	 */
+	static constexpr int VERTICES_PER_BAND = 4;
+	static constexpr int MAX_BANDS_PER_POLYGON = 16;
+	FenceVertex *_vertices{nullptr};
+	int _num_vertices{0};
+	uint16_t *_band_offsets{nullptr};
+	uint16_t *_band_edges{nullptr};
+
 	MapProjection _projection_reference{}; ///< class to convert (lon, lat) to local [m]
 
 	DEFINE_PARAMETERS(
@@ -194,6 +217,16 @@ private:
 	 */
 	void _updateFence();
 
+	/**
+	 * read the vertices of all polygons & circles from dataman and build the bounding boxes and edge bands
+	 */
+	void _updateVertexCache();
+
+	/**
+	 * @return longitude band of a polygon containing lon (clamped to the bounding box)
+	 */
+	static int bandIndex(const PolygonInfo &polygon, double lon);
+
 	/**
 	 * Check if a point passes the Geofence test.
 	 * This takes all polygons and minimum & maximum altitude into account
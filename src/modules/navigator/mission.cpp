@@ -46,6 +46,7 @@
  */
 
 #include "mission.h"
+#include "mission_item_reader.h"
 #include "navigator.h"
 
 #include <string.h>
@@ -423,11 +424,12 @@ Mission::find_mission_land_start()
 
 	bool found_land_start_marker = false;
 
+	MissionItemReader reader(dm_current, _mission.count);
+
 	for (size_t i = 1; i < _mission.count; i++) {
-		const ssize_t len = sizeof(missionitem);
 		missionitem_prev = missionitem; // store the last mission item before reading a new one
 
-		if (dm_read(dm_current, i, &missionitem, len) != len) {
+		if (!reader.read(i, missionitem)) {
 			/* not supposed to happen unless the datamanager can't access the SD card, etc. */
 			PX4_ERR("dataman read failure");
 			break;
@@ -601,13 +603,12 @@ Mission::advance_mission()
 
 		case mission_result_s::MISSION_EXECUTION_MODE_REVERSE: {
 				// find next position item in reverse order
-				dm_item_t dm_current = (dm_item_t)(_mission.dataman_id);
+				MissionItemReader reader((dm_item_t)_mission.dataman_id, _mission.count);
 
 				for (int32_t i = _current_mission_index - 1; i >= 0; i--) {
 					struct mission_item_s missionitem = {};
-					const ssize_t len = sizeof(missionitem);
 
-					if (dm_read(dm_current, i, &missionitem, len) != len) {
+					if (!reader.read(i, missionitem)) {
 						/* not supposed to happen unless the datamanager can't access the SD card, etc. */
 						PX4_ERR("dataman read failure");
 						break;
@@ -1774,12 +1775,13 @@ Mission::reset_mission(struct mission_s &mission)
 			/* reset jump counters */
 			if (mission.count > 0) {
 				const dm_item_t dm_current = (dm_item_t)mission.dataman_id;
+				MissionItemReader reader(dm_current, mission.count);
 
 				for (unsigned index = 0; index < mission.count; index++) {
 					struct mission_item_s item;
 					const ssize_t len = sizeof(struct mission_item_s);
 
-					if (dm_read(dm_current, index, &item, len) != len) {
+					if (!reader.read(index, item)) {
 						PX4_WARN("could not read mission item during reset");
 						break;
 					}
@@ -1830,13 +1832,12 @@ Mission::index_closest_mission_item() const
 	int32_t min_dist_index(0);
 	float min_dist(FLT_MAX), dist_xy(FLT_MAX), dist_z(FLT_MAX);
 
-	dm_item_t dm_current = (dm_item_t)(_mission.dataman_id);
+	MissionItemReader reader((dm_item_t)_mission.dataman_id, _mission.count);
 
 	for (size_t i = 0; i < _mission.count; i++) {
 		struct mission_item_s missionitem = {};
-		const ssize_t len = sizeof(missionitem);
 
-		if (dm_read(dm_current, i, &missionitem, len) != len) {
+		if (!reader.read(i, missionitem)) {
 			/* not supposed to happen unless the datamanager can't access the SD card, etc. */
 			PX4_ERR("dataman read failure");
 			break;
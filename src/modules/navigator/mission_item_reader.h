@@ -0,0 +1,100 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2021 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+/**
+ * @file mission_item_reader.h
+ * Buffered access to the mission items stored in dataman, for loops over a whole mission
+ */
+
+#pragma once
+
+#include <dataman/dataman.h>
+#include <lib/mathlib/mathlib.h>
+
+#include "navigation.h"
+
+/**
+ * Reads the mission items in chunks with dm_read_range(), so iterating over a mission (in either direction)
+ * needs a single dataman request per CHUNK_LENGTH items instead of one per item.
+ * Items written while iterating are not updated in the buffer.
+ */
+class MissionItemReader
+{
+public:
+	MissionItemReader(dm_item_t dm_item, size_t count) : _dm_item(dm_item), _count(count) {}
+
+	/**
+	 * Get a mission item, reading the chunk containing it from dataman if it is not buffered.
+	 * @return true on success, false if the index is out of range or the item can't be read
+	 */
+	bool read(size_t index, mission_item_s &item)
+	{
+		if (index >= _count) {
+			return false;
+		}
+
+		if (index < _first || index >= _first + _length) {
+			// read ahead in the direction of iteration
+			const bool reverse = (_length > 0) && (index < _first);
+			const size_t first = reverse ? index - math::min(index, CHUNK_LENGTH - 1) : index;
+			const size_t length = math::min(_count - first, CHUNK_LENGTH);
+
+			ssize_t ret = dm_read_range(_dm_item, first, _items, sizeof(mission_item_s), length);
+			_first = first;
+
+			// reading stops at the first item that fails, retry from the requested one
+			if (ret <= (ssize_t)(index - first)) {
+				ret = dm_read_range(_dm_item, index, _items, sizeof(mission_item_s), 1);
+				_first = index;
+			}
+
+			_length = (ret > 0) ? ret : 0;
+
+			if (_length == 0) {
+				return false;
+			}
+		}
+
+		item = _items[index - _first];
+		return true;
+	}
+
+private:
+	static constexpr size_t CHUNK_LENGTH = 4;
+
+	const dm_item_t _dm_item;
+	const size_t _count;
+
+	mission_item_s _items[CHUNK_LENGTH];
+	size_t _first{0};
+	size_t _length{0};
+};
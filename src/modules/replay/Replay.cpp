@@ -48,18 +48,28 @@
 #include <px4_platform_common/shutdown.h>
 #include <lib/parameters/param.h>
 
+#include <algorithm>
 #include <cstring>
+#include <fcntl.h>
 #include <float.h>
 #include <fstream>
+#include <functional>
+#include <inttypes.h>
 #include <iostream>
 #include <math.h>
+#include <queue>
 #include <time.h>
+#include <tuple>
 #include <sstream>
 #include <stdio.h>
 #include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <string>
+#include <unistd.h>
 
 #include <logger/messages.h>
+#include <lib/ulog_compression/ulog_compression.h>
 
 #include "Replay.hpp"
 #include "ReplayEkf2.hpp"
@@ -119,6 +129,42 @@ Replay::setupReplayFile(const char *file_name)
 {
 	if (_replay_file) {
 		free(_replay_file);
+		_replay_file = nullptr;
+	}
+
+	if (ulog_compression::is_compressed_file(file_name)) {
+		// decompress once into a regular ULog file next to the original (.ulgz -> .ulg)
+		string decompressed_file(file_name);
+
+		if (decompressed_file.size() > 1 && decompressed_file.back() == 'z') {
+			decompressed_file.pop_back();
+
+		} else {
+			decompressed_file += ".ulg";
+		}
+
+		struct stat st;
+
+		if (stat(decompressed_file.c_str(), &st) != 0) {
+			PX4_INFO("Decompressing %s to %s", file_name, decompressed_file.c_str());
+
+			// decompress into a temporary file, so that an interrupted run does not leave a partial file to be reused
+			const string temp_file = decompressed_file + ".tmp";
+			const int skipped_frames = ulog_compression::decompress_file(file_name, temp_file.c_str());
+
+			if (skipped_frames < 0 || rename(temp_file.c_str(), decompressed_file.c_str()) != 0) {
+				PX4_ERR("Failed to decompress %s", file_name);
+				unlink(temp_file.c_str());
+				return;
+			}
+
+			if (skipped_frames > 0) {
+				PX4_WARN("Skipped %i corrupted or incomplete frames", skipped_frames);
+			}
+		}
+
+		_replay_file = strdup(decompressed_file.c_str());
+		return;
 	}
 
 	_replay_file = strdup(file_name);
@@ -193,6 +239,11 @@ Replay::readFileHeader(std::ifstream &file)
 		return false;
 	}
 
+	if (memcmp(msg_header.magic, ulog_compression::FILE_MAGIC, sizeof(ulog_compression::FILE_MAGIC)) == 0) {
+		PX4_ERR("Compressed ULog file, decompress it first (Tools/decompress_ulog.py)");
+		return false;
+	}
+
 	_file_start_time = msg_header.timestamp;
 	//verify it's an ULog file
 	char magic[8];
@@ -237,7 +288,10 @@ Replay::readFileDefinitions(std::ifstream &file)
 			break;
 
 		case (int)ULogMessageType::PARAMETER:
-			if (!readAndApplyParameter(file, message_header.msg_size)) {
+			_read_buffer.reserve(message_header.msg_size);
+			file.read((char *)_read_buffer.data(), message_header.msg_size);
+
+			if (!file || !readAndApplyParameter(_read_buffer.data(), message_header.msg_size)) {
 				return false;
 			}
 
@@ -367,33 +421,21 @@ string Replay::parseOrbFields(const string &fields)
 	return ret;
 }
 
-bool
-Replay::readAndAddSubscription(std::ifstream &file, uint16_t msg_size)
+void
+Replay::addSubscription(const uint8_t *message, uint16_t msg_size)
 {
-	_read_buffer.reserve(msg_size + 1);
-	char *message = (char *)_read_buffer.data();
-	streampos this_message_pos = file.tellg() - (streamoff)ULOG_MSG_HEADER_LEN;
-	file.read(message, msg_size);
-	message[msg_size] = 0;
-
-	if (!file) {
-		return false;
-	}
-
-	if (file.tellg() <= _subscription_file_pos) { //already read this subscription
-		return true;
+	if (msg_size < 4) {
+		return;
 	}
 
-	_subscription_file_pos = file.tellg();
-
-	uint8_t multi_id = *(uint8_t *)message;
+	uint8_t multi_id = message[0];
 	uint16_t msg_id = ((uint16_t) message[1]) | (((uint16_t) message[2]) << 8);
-	string topic_name(message + 3);
+	string topic_name((const char *)message + 3, strnlen((const char *)message + 3, msg_size - 3));
 	const orb_metadata *orb_meta = findTopic(topic_name);
 
 	if (!orb_meta) {
 		PX4_WARN("Topic %s not found internally. Will ignore it", topic_name.c_str());
-		return true;
+		return;
 	}
 
 	CompatBase *compat = nullptr;
@@ -469,7 +511,7 @@ Replay::readAndAddSubscription(std::ifstream &file, uint16_t msg_size)
 				}
 			}
 
-			return true; // not a fatal error
+			return; // not a fatal error
 		}
 	}
 
@@ -484,30 +526,13 @@ Replay::readAndAddSubscription(std::ifstream &file, uint16_t msg_size)
 
 	if (!timestamp_found) {
 		delete subscription;
-		return true;
+		return;
 	}
 
 	if (field_size != 8) {
 		PX4_ERR("Unsupported timestamp with size %i, ignoring the topic %s", field_size, orb_meta->o_name);
 		delete subscription;
-		return true;
-	}
-
-	//find first data message (and the timestamp)
-	streampos cur_pos = file.tellg();
-	subscription->next_read_pos = this_message_pos; //this will be skipped
-
-	if (!nextDataMessage(file, *subscription, msg_id)) {
-		delete subscription;
-		return false;
-	}
-
-	file.seekg(cur_pos);
-
-	if (!subscription->orb_meta) {
-		//no message found. This is not a fatal error
-		delete subscription;
-		return true;
+		return;
 	}
 
 	PX4_DEBUG("adding subscription for %s (msg_id %i)", subscription->orb_meta->o_name, msg_id);
@@ -517,11 +542,8 @@ Replay::readAndAddSubscription(std::ifstream &file, uint16_t msg_size)
 		_subscriptions.resize(msg_id + 1);
 	}
 
+	delete _subscriptions[msg_id];
 	_subscriptions[msg_id] = subscription;
-
-	onSubscriptionAdded(*_subscriptions[msg_id], msg_id);
-
-	return true;
 }
 
 bool
@@ -555,52 +577,43 @@ Replay::findFieldOffset(const string &format, const string &field_name, int &off
 	return false;
 }
 
-bool
-Replay::readAndHandleAdditionalMessages(std::ifstream &file, std::streampos end_position)
+void
+Replay::handleAdditionalMessages(uint64_t end_position)
 {
-	ulog_message_header_s message_header;
-
-	while (file.tellg() < end_position) {
-		file.read((char *)&message_header, ULOG_MSG_HEADER_LEN);
+	while (_next_additional_message < _additional_messages.size()
+	       && _additional_messages[_next_additional_message] < end_position) {
 
-		if (!file) {
-			return false;
-		}
+		const uint8_t *message = _file_data + _additional_messages[_next_additional_message++];
+		ulog_message_header_s message_header;
+		memcpy(&message_header, message, ULOG_MSG_HEADER_LEN);
+		message += ULOG_MSG_HEADER_LEN;
 
 		switch (message_header.msg_type) {
 		case (int)ULogMessageType::PARAMETER:
-			if (!readAndApplyParameter(file, message_header.msg_size)) {
-				return false;
-			}
-
+			readAndApplyParameter(message, message_header.msg_size);
 			break;
 
 		case (int)ULogMessageType::DROPOUT:
-			readDropout(file, message_header.msg_size);
-			break;
-
-		default: //skip all others
-			file.seekg(message_header.msg_size, ios::cur);
+			readDropout(message, message_header.msg_size);
 			break;
 		}
 	}
-
-	return true;
 }
 
 bool
-Replay::readAndApplyParameter(std::ifstream &file, uint16_t msg_size)
+Replay::readAndApplyParameter(const uint8_t *message, uint16_t msg_size)
 {
-	_read_buffer.reserve(msg_size);
-	uint8_t *message = (uint8_t *)_read_buffer.data();
-	file.read((char *)message, msg_size);
-
-	if (!file) {
+	if (msg_size < 1) {
 		return false;
 	}
 
 	uint8_t key_len = message[0];
-	string key((char *)message + 1, key_len);
+
+	if (key_len + 1 > msg_size) {
+		return false;
+	}
+
+	string key((const char *)message + 1, key_len);
 
 	size_t pos = key.find(' ');
 
@@ -621,6 +634,10 @@ Replay::readAndApplyParameter(std::ifstream &file, uint16_t msg_size)
 		return true;
 	}
 
+	if (msg_size < 1 + key_len + 4) {
+		return false;
+	}
+
 	param_t handle = param_find(param_name.c_str());
 
 	if (handle != PARAM_INVALID) {
@@ -630,100 +647,170 @@ Replay::readAndApplyParameter(std::ifstream &file, uint16_t msg_size)
 	return true;
 }
 
-bool
-Replay::readDropout(std::ifstream &file, uint16_t msg_size)
+void
+Replay::readDropout(const uint8_t *message, uint16_t msg_size)
 {
-	uint16_t duration;
-	file.read((char *)&duration, sizeof(duration));
+	uint16_t duration = 0;
+
+	if (msg_size >= sizeof(duration)) {
+		memcpy(&duration, message, sizeof(duration));
+	}
 
 	PX4_ERR("Dropout in replayed log, %i ms", (int)duration);
-	return file.good();
 }
 
 bool
-Replay::nextDataMessage(std::ifstream &file, Subscription &subscription, int msg_id)
+Replay::mapFile()
 {
-	ulog_message_header_s message_header;
-	file.seekg(subscription.next_read_pos);
-	//ignore the first message (it's data we already read)
-	file.read((char *)&message_header, ULOG_MSG_HEADER_LEN);
+	int fd = ::open(_replay_file, O_RDONLY);
 
-	if (file) {
-		file.seekg(message_header.msg_size, ios::cur);
+	if (fd < 0) {
+		PX4_ERR("Failed to open replay file (%i)", errno);
+		return false;
 	}
 
-	uint16_t file_msg_id;
-	bool done = false;
+	struct stat st;
 
-	while (file && !done) {
-		streampos cur_pos = file.tellg();
-		file.read((char *)&message_header, ULOG_MSG_HEADER_LEN);
+	if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+		::close(fd);
+		return false;
+	}
 
-		if (!file) {
-			break;
-		}
+	void *data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);
 
-		if (((streamoff)cur_pos) + ULOG_MSG_HEADER_LEN + message_header.msg_size > _read_until_file_position) {
-			file.setstate(std::ios::eofbit);
-			break;
+	if (data == MAP_FAILED) {
+		PX4_ERR("Failed to map replay file (%i)", errno);
+		return false;
+	}
+
+	// messages are mostly consumed in file order
+	madvise(data, st.st_size, MADV_SEQUENTIAL);
+
+	_file_data = (const uint8_t *)data;
+	_file_size = st.st_size;
+	return true;
+}
+
+void
+Replay::unmapFile()
+{
+	if (_file_data) {
+		munmap((void *)_file_data, _file_size);
+		_file_data = nullptr;
+		_file_size = 0;
+	}
+}
+
+void
+Replay::buildIndex()
+{
+	const uint64_t end_position = std::min<uint64_t>(_file_size, _read_until_file_position);
+	uint64_t position = _data_section_start;
+
+	while (position + ULOG_MSG_HEADER_LEN <= end_position) {
+		ulog_message_header_s message_header;
+		memcpy(&message_header, _file_data + position, ULOG_MSG_HEADER_LEN);
+		const uint8_t *message = _file_data + position + ULOG_MSG_HEADER_LEN;
+
+		if (position + ULOG_MSG_HEADER_LEN + message_header.msg_size > end_position) {
+			break; // truncated message at the end
 		}
 
 		switch (message_header.msg_type) {
 		case (int)ULogMessageType::ADD_LOGGED_MSG:
-			readAndAddSubscription(file, message_header.msg_size);
+			addSubscription(message, message_header.msg_size);
 			break;
 
 		case (int)ULogMessageType::DATA:
-			file.read((char *)&file_msg_id, sizeof(file_msg_id));
+			if (message_header.msg_size >= sizeof(uint16_t)) {
+				uint16_t file_msg_id;
+				memcpy(&file_msg_id, message, sizeof(file_msg_id));
+
+				if (file_msg_id < _subscriptions.size() && _subscriptions[file_msg_id]) {
+					Subscription &subscription = *_subscriptions[file_msg_id];
 
-			if (file) {
-				if (msg_id == file_msg_id) {
 					if (message_header.msg_size == subscription.orb_meta->o_size_no_padding + 2) {
-						subscription.next_read_pos = cur_pos;
-						file.seekg(subscription.timestamp_offset, ios::cur);
-						file.read((char *)&subscription.next_timestamp, sizeof(subscription.next_timestamp));
-						done = true;
+						subscription.message_offsets.push_back(position);
 
 					} else { //sanity check failed!
 						PX4_ERR("data message %s has wrong size %i (expected %i). Skipping",
 							subscription.orb_meta->o_name, message_header.msg_size,
 							subscription.orb_meta->o_size_no_padding + 2);
-						file.seekg(message_header.msg_size - sizeof(file_msg_id), ios::cur);
 					}
-
-				} else { //not the one we are looking for
-					file.seekg(message_header.msg_size - sizeof(file_msg_id), ios::cur);
 				}
 			}
 
 			break;
 
-		case (int)ULogMessageType::REMOVE_LOGGED_MSG: //skip these
 		case (int)ULogMessageType::PARAMETER:
 		case (int)ULogMessageType::DROPOUT:
+			_additional_messages.push_back(position);
+			break;
+
+		case (int)ULogMessageType::REMOVE_LOGGED_MSG: //skip these
 		case (int)ULogMessageType::INFO:
 		case (int)ULogMessageType::INFO_MULTIPLE:
 		case (int)ULogMessageType::SYNC:
 		case (int)ULogMessageType::LOGGING:
+		case (int)ULogMessageType::LOGGING_TAGGED:
 		case (int)ULogMessageType::PARAMETER_DEFAULT:
-			file.seekg(message_header.msg_size, ios::cur);
 			break;
 
 		default:
 			//this really should not happen
-			PX4_ERR("unknown log message type %i, size %i (offset %i)",
-				(int)message_header.msg_type, (int)message_header.msg_size, (int)file.tellg());
-			file.seekg(message_header.msg_size, ios::cur);
+			PX4_ERR("unknown log message type %i, size %i (offset %" PRIu64 ")",
+				(int)message_header.msg_type, (int)message_header.msg_size, position);
 			break;
 		}
+
+		position += ULOG_MSG_HEADER_LEN + message_header.msg_size;
+	}
+
+	for (size_t msg_id = 0; msg_id < _subscriptions.size(); ++msg_id) {
+		Subscription *subscription = _subscriptions[msg_id];
+
+		if (!subscription) {
+			continue;
+		}
+
+		if (subscription->message_offsets.empty()) {
+			//no message found. This is not a fatal error
+			delete subscription->compat;
+			delete subscription;
+			_subscriptions[msg_id] = nullptr;
+			continue;
+		}
+
+		subscription->next_message_index = 0;
+		loadDataMessage(*subscription);
+		onSubscriptionAdded(*subscription, msg_id);
 	}
+}
 
-	if (file.eof()) { //no more data messages for this subscription
+void
+Replay::loadDataMessage(Subscription &subscription)
+{
+	subscription.next_read_pos = subscription.message_offsets[subscription.next_message_index];
+	memcpy(&subscription.next_timestamp, _file_data + subscription.next_read_pos + ULOG_MSG_HEADER_LEN + 2 +
+	       subscription.timestamp_offset, sizeof(subscription.next_timestamp));
+}
+
+bool
+Replay::nextDataMessage(Subscription &subscription)
+{
+	if (!subscription.orb_meta) {
+		return false;
+	}
+
+	if (++subscription.next_message_index >= subscription.message_offsets.size()) {
+		//no more data messages for this subscription
 		subscription.orb_meta = nullptr;
-		file.clear();
+		return false;
 	}
 
-	return file.good();
+	loadDataMessage(subscription);
+	return true;
 }
 
 const orb_metadata *
@@ -845,80 +932,78 @@ Replay::run()
 		_speed_factor = atof(speedup);
 	}
 
-	onEnterMainLoop();
+	replay_file.close();
 
-	_replay_start_time = hrt_absolute_time();
+	if (!mapFile()) {
+		return;
+	}
 
-	PX4_INFO("Replay in progress...");
+	buildIndex();
 
-	ulog_message_header_s message_header;
-	replay_file.seekg(_data_section_start);
+	onEnterMainLoop();
 
-	//we know the next message must be an ADD_LOGGED_MSG
-	replay_file.read((char *)&message_header, ULOG_MSG_HEADER_LEN);
+	_replay_start_time = hrt_absolute_time();
 
-	if (!readAndAddSubscription(replay_file, message_header.msg_size)) {
-		PX4_ERR("Failed to read subscription");
-		return;
-	}
+	PX4_INFO("Replay in progress...");
 
 	const uint64_t timestamp_offset = getTimestampOffset();
 	uint32_t nr_published_messages = 0;
-	streampos last_additional_message_pos = _data_section_start;
 
-	while (!should_exit() && replay_file) {
+	//Messages from different subscriptions don't need to be in chronological order, so we merge
+	//the subscriptions by their next timestamp. Entries are (timestamp, msg_id, message index), ties
+	//are published in msg_id order. Entries become stale if a subscription is advanced elsewhere.
+	using MergeEntry = std::tuple<uint64_t, size_t, size_t>;
+	std::priority_queue<MergeEntry, std::vector<MergeEntry>, std::greater<MergeEntry>> merge_queue;
 
-		//Find the next message to publish. Messages from different subscriptions don't need
-		//to be in chronological order, so we need to check all subscriptions
-		uint64_t next_file_time = 0;
-		int next_msg_id = -1;
-		bool first_time = true;
+	auto push_subscription = [&merge_queue](const Subscription & sub, size_t msg_id) {
+		if (sub.orb_meta && !sub.ignored) {
+			merge_queue.emplace(sub.next_timestamp, msg_id, sub.next_message_index);
+		}
+	};
+
+	for (size_t i = 0; i < _subscriptions.size(); ++i) {
+		if (_subscriptions[i]) {
+			push_subscription(*_subscriptions[i], i);
+		}
+	}
 
-		for (size_t i = 0; i < _subscriptions.size(); ++i) {
-			const Subscription *subscription = _subscriptions[i];
+	while (!should_exit() && !merge_queue.empty()) {
 
-			if (!subscription) {
-				continue;
-			}
+		const size_t next_msg_id = std::get<1>(merge_queue.top());
+		const size_t message_index = std::get<2>(merge_queue.top());
+		merge_queue.pop();
 
-			if (subscription->orb_meta && !subscription->ignored) {
-				if (first_time || subscription->next_timestamp < next_file_time) {
-					first_time = false;
-					next_msg_id = (int)i;
-					next_file_time = subscription->next_timestamp;
-				}
-			}
-		}
+		Subscription &sub = *_subscriptions[next_msg_id];
 
-		if (next_msg_id == -1) {
-			break; //no active subscription anymore. We're done.
+		if (!sub.orb_meta || sub.next_message_index != message_index) {
+			push_subscription(sub, next_msg_id);
+			continue;
 		}
 
-		Subscription &sub = *_subscriptions[next_msg_id];
+		const uint64_t next_file_time = sub.next_timestamp;
 
 		if (next_file_time == 0) {
 			//someone didn't set the timestamp properly. Consider the message invalid
-			nextDataMessage(replay_file, sub, next_msg_id);
+			nextDataMessage(sub);
+			push_subscription(sub, next_msg_id);
 			continue;
 		}
 
 		//handle additional messages between last and next published data
-		replay_file.seekg(last_additional_message_pos);
-		streampos next_additional_message_pos = sub.next_read_pos;
-		readAndHandleAdditionalMessages(replay_file, next_additional_message_pos);
-		last_additional_message_pos = next_additional_message_pos;
+		handleAdditionalMessages(sub.next_read_pos);
 
 		const uint64_t publish_timestamp = handleTopicDelay(next_file_time, timestamp_offset);
 
 		// It's time to publish
-		readTopicDataToBuffer(sub, replay_file);
+		readTopicDataToBuffer(sub);
 		memcpy(_read_buffer.data() + sub.timestamp_offset, &publish_timestamp, sizeof(uint64_t)); //adjust the timestamp
 
-		if (handleTopicUpdate(sub, _read_buffer.data(), replay_file)) {
+		if (handleTopicUpdate(sub, _read_buffer.data())) {
 			++nr_published_messages;
 		}
 
-		nextDataMessage(replay_file, sub, next_msg_id);
+		nextDataMessage(sub);
+		push_subscription(sub, next_msg_id);
 
 		// TODO: output status (eg. every sec), including total duration...
 	}
@@ -946,8 +1031,9 @@ Replay::run()
 
 	onExitMainLoop();
 
+	unmapFile();
+
 	if (!should_exit()) {
-		replay_file.close();
 		px4_shutdown_request();
 		// we need to ensure the shutdown logic gets updated and eventually triggers shutdown
 		hrt_abstime t = hrt_absolute_time();
@@ -962,17 +1048,17 @@ Replay::run()
 }
 
 void
-Replay::readTopicDataToBuffer(const Subscription &sub, std::ifstream &replay_file)
+Replay::readTopicDataToBuffer(const Subscription &sub)
 {
 	const size_t msg_read_size = sub.orb_meta->o_size_no_padding;
 	const size_t msg_write_size = sub.orb_meta->o_size;
 	_read_buffer.reserve(msg_write_size);
-	replay_file.seekg(sub.next_read_pos + (streamoff)(ULOG_MSG_HEADER_LEN + 2)); //skip header & msg id
-	replay_file.read((char *)_read_buffer.data(), msg_read_size);
+	memcpy(_read_buffer.data(), _file_data + sub.next_read_pos + ULOG_MSG_HEADER_LEN + 2, //skip header & msg id
+	       msg_read_size);
 }
 
 bool
-Replay::handleTopicUpdate(Subscription &sub, void *data, std::ifstream &replay_file)
+Replay::handleTopicUpdate(Subscription &sub, void *data)
 {
 	return publishTopic(sub, data);
 }
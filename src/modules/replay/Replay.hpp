@@ -51,9 +51,10 @@ namespace px4
 /**
  * @class Replay
  * Parses an ULog file and replays it in 'real-time'. The timestamp of each replayed message is offset
- * to match the starting time of replay. It keeps a stream for each subscription to find the next message
- * to replay. This is necessary because data messages from different subscriptions don't need to be in
- * monotonic increasing order.
+ * to match the starting time of replay.
+ * The file is memory-mapped and indexed once at startup (file offsets of all data messages per subscription).
+ * Replay then does a timestamp merge over the subscriptions. This is necessary because data messages from
+ * different subscriptions don't need to be in monotonic increasing order.
  */
 class Replay : public ModuleBase<Replay>
 {
@@ -134,9 +135,12 @@ protected:
 
 		bool ignored = false; ///< if true, it will not be considered for publication in the main loop
 
-		std::streampos next_read_pos;
+		uint64_t next_read_pos; ///< file offset of the next data message
 		uint64_t next_timestamp; ///< timestamp of the file
 
+		std::vector<uint64_t> message_offsets; ///< file offsets of all data messages of this subscription
+		size_t next_message_index = 0; ///< index into message_offsets of next_read_pos
+
 		CompatBase *compat = nullptr;
 
 		// statistics
@@ -189,22 +193,19 @@ protected:
 	 * handle the publication of a topic update
 	 * @return true if published, false otherwise
 	 */
-	virtual bool handleTopicUpdate(Subscription &sub, void *data, std::ifstream &replay_file);
+	virtual bool handleTopicUpdate(Subscription &sub, void *data);
 
 	/**
 	 * read a topic from the file (offset given by the subscription) into _read_buffer
 	 */
-	void readTopicDataToBuffer(const Subscription &sub, std::ifstream &replay_file);
+	void readTopicDataToBuffer(const Subscription &sub);
 
 	/**
-	 * Find next data message for this subscription, starting with the stored file offset.
-	 * Skip the first message, and if found, read the timestamp and store the new file offset.
-	 * This also takes care of new subscriptions and parameter updates. When reaching EOF,
-	 * the subscription is set to invalid.
-	 * File seek position is arbitrary after this call.
-	 * @return false on file error
+	 * Advance to the next data message of this subscription and read its timestamp.
+	 * When reaching the end, the subscription is set to invalid.
+	 * @return false if there are no more messages
 	 */
-	bool nextDataMessage(std::ifstream &file, Subscription &subscription, int msg_id);
+	bool nextDataMessage(Subscription &subscription);
 
 	virtual uint64_t getTimestampOffset()
 	{
@@ -226,11 +227,14 @@ private:
 	uint64_t _replay_start_time;
 	std::streampos _data_section_start; ///< first ADD_LOGGED_MSG message
 
-	/** keep track of file position to avoid adding a subscription multiple times. */
-	std::streampos _subscription_file_pos = 0;
-
 	int64_t _read_until_file_position = 1ULL << 60; ///< read limit if log contains appended data
 
+	const uint8_t *_file_data{nullptr}; ///< memory-mapped log file
+	size_t _file_size{0};
+
+	std::vector<uint64_t> _additional_messages; ///< file offsets of parameter and dropout messages in the data section
+	size_t _next_additional_message{0};
+
 	float _accumulated_delay{0.f};
 
 	bool readFileHeader(std::ifstream &file);
@@ -244,9 +248,26 @@ private:
 
 	///file parsing methods. They return false, when further parsing should be aborted.
 	bool readFormat(std::ifstream &file, uint16_t msg_size);
-	bool readAndAddSubscription(std::ifstream &file, uint16_t msg_size);
 	bool readFlagBits(std::ifstream &file, uint16_t msg_size);
 
+	/**
+	 * Create a subscription from an ADD_LOGGED_MSG message (without the message header).
+	 * Topics that are unknown or have a mismatching format are ignored.
+	 */
+	void addSubscription(const uint8_t *message, uint16_t msg_size);
+
+	bool mapFile();
+	void unmapFile();
+
+	/**
+	 * Single pass over the data section: create the subscriptions and store the file offsets of
+	 * all data, parameter and dropout messages. Subscriptions without data are removed.
+	 */
+	void buildIndex();
+
+	/** read the file offset and timestamp of the current message of a subscription */
+	void loadDataMessage(Subscription &subscription);
+
 	/**
 	 * Read the file header and definitions sections. Apply the parameters from this section
 	 * and apply user-defined overridden parameters.
@@ -255,14 +276,13 @@ private:
 	bool readDefinitionsAndApplyParams(std::ifstream &file);
 
 	/**
-	 * Read and handle additional messages starting at current file position, while position < end_position.
+	 * Handle the indexed additional messages with file offset < end_position.
 	 * This handles dropout and parameter update messages.
 	 * We need to handle these separately, because they have no timestamp. We look at the file position instead.
-	 * @return false on file error
 	 */
-	bool readAndHandleAdditionalMessages(std::ifstream &file, std::streampos end_position);
-	bool readDropout(std::ifstream &file, uint16_t msg_size);
-	bool readAndApplyParameter(std::ifstream &file, uint16_t msg_size);
+	void handleAdditionalMessages(uint64_t end_position);
+	void readDropout(const uint8_t *message, uint16_t msg_size);
+	bool readAndApplyParameter(const uint8_t *message, uint16_t msg_size);
 
 	static const orb_metadata *findTopic(const std::string &name);
 
@@ -46,6 +46,7 @@ VehicleAngularVelocity::VehicleAngularVelocity() :
 	ModuleParams(nullptr),
 	ScheduledWorkItem(MODULE_NAME, px4::wq_configurations::rate_ctrl)
 {
+	EnableLatencyHistogramIfConfigured();
 }
 
 VehicleAngularVelocity::~VehicleAngularVelocity()
@@ -747,6 +748,15 @@ void VehicleAngularVelocity::Run()
 	UpdateDynamicNotchFFT();
 
 	if (_fifo_available) {
+#if defined(UORB_PUBLICATION_LOAN)
+
+		if (UpdateSensorFifoInPlace()) {
+			perf_end(_cycle_perf);
+			return;
+		}
+
+#endif // UORB_PUBLICATION_LOAN
+
 		// process all outstanding fifo messages
 		sensor_gyro_fifo_s sensor_fifo_data;
 
@@ -836,6 +846,59 @@ void VehicleAngularVelocity::Run()
 	perf_end(_cycle_perf);
 }
 
+#if defined(UORB_PUBLICATION_LOAN)
+bool VehicleAngularVelocity::UpdateSensorFifoInPlace()
+{
+	// process outstanding fifo messages reading them in place, the remaining ones are copied by the caller
+	uORB::SubscriptionView<sensor_gyro_fifo_s> sensor_fifo_view{_sensor_fifo_sub};
+	static constexpr int FIFO_SIZE_MAX = sizeof(sensor_gyro_fifo_s::x) / sizeof(sensor_gyro_fifo_s::x[0]);
+
+	while (const sensor_gyro_fifo_s *sensor_fifo_data = sensor_fifo_view.begin()) {
+		const hrt_abstime timestamp_sample = sensor_fifo_data->timestamp_sample;
+		const float dt = sensor_fifo_data->dt;
+		const int N = sensor_fifo_data->samples;
+		const bool fifo_valid = (dt > 0) && (N > 0) && (N <= FIFO_SIZE_MAX);
+
+		// convert all axes before filtering, the message is only consumed once it is known to be intact
+		float data[3][FIFO_SIZE_MAX];
+
+		if (fifo_valid) {
+			const int16_t *raw_data_array[] {sensor_fifo_data->x, sensor_fifo_data->y, sensor_fifo_data->z};
+			const float scale = sensor_fifo_data->scale;
+
+			for (int axis = 0; axis < 3; axis++) {
+				for (int n = 0; n < N; n++) {
+					data[axis][n] = scale * raw_data_array[axis][n];
+				}
+			}
+		}
+
+		// discard the message if it was overwritten while being read
+		if (sensor_fifo_view.end() && fifo_valid) {
+			const float inverse_dt_s = 1e6f / dt;
+
+			Vector3f angular_velocity_uncalibrated;
+			Vector3f angular_acceleration_uncalibrated;
+
+			for (int axis = 0; axis < 3; axis++) {
+				// save last filtered sample
+				angular_velocity_uncalibrated(axis) = FilterAngularVelocity(axis, data[axis], N);
+				angular_acceleration_uncalibrated(axis) = FilterAngularAcceleration(axis, inverse_dt_s, data[axis], N);
+			}
+
+			// Publish
+			if (!_sensor_fifo_sub.updated()) {
+				if (CalibrateAndPublish(timestamp_sample, angular_velocity_uncalibrated, angular_acceleration_uncalibrated)) {
+					return true;
+				}
+			}
+		}
+	}
+
+	return false;
+}
+#endif // UORB_PUBLICATION_LOAN
+
 bool VehicleAngularVelocity::CalibrateAndPublish(const hrt_abstime &timestamp_sample,
 		const Vector3f &angular_velocity_uncalibrated, const Vector3f &angular_acceleration_uncalibrated)
 {
@@ -47,6 +47,7 @@
 #include <uORB/Publication.hpp>
 #include <uORB/Subscription.hpp>
 #include <uORB/SubscriptionCallback.hpp>
+#include <uORB/SubscriptionView.hpp>
 #include <uORB/topics/esc_status.h>
 #include <uORB/topics/estimator_selector_status.h>
 #include <uORB/topics/estimator_sensor_bias.h>
@@ -93,6 +94,14 @@ private:
 	void UpdateDynamicNotchFFT(bool force = false);
 	bool UpdateSampleRate();
 
+#if defined(UORB_PUBLICATION_LOAN)
+	/**
+	 * Process the outstanding fifo messages in place.
+	 * @return true if published
+	 */
+	bool UpdateSensorFifoInPlace();
+#endif // UORB_PUBLICATION_LOAN
+
 	// scaled appropriately for current sensor
 	matrix::Vector3f GetResetAngularVelocity() const;
 	matrix::Vector3f GetResetAngularAcceleration() const;
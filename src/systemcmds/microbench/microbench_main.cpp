@@ -45,6 +45,7 @@ extern int test_microbench_atomic(int argc, char *argv[]);
 extern int test_microbench_hrt(int argc, char *argv[]);
 extern int test_microbench_math(int argc, char *argv[]);
 extern int test_microbench_matrix(int argc, char *argv[]);
+extern int test_microbench_ringbuffer(int argc, char *argv[]);
 extern int test_microbench_uorb(int argc, char *argv[]);
 
 __END_DECLS
@@ -67,6 +68,7 @@ const struct {
 	{"microbench_hrt",	test_microbench_hrt,	0},
 	{"microbench_math",	test_microbench_math,	0},
 	{"microbench_matrix",	test_microbench_matrix,	0},
+	{"microbench_ringbuffer",	test_microbench_ringbuffer,	0},
 	{"microbench_uorb",	test_microbench_uorb,	0},
 
 	{nullptr,			nullptr, 		0}
@@ -44,6 +44,7 @@
 
 #include <drivers/drv_hrt.h>
 #include <perf/perf_counter.h>
+#include <px4_platform_common/atomic.h>
 #include <px4_platform_common/px4_config.h>
 #include <px4_platform_common/micro_hal.h>
 
@@ -94,9 +95,12 @@ public:
 private:
 
 	bool time_px4_hrt();
+	bool time_px4_hrt_callout();
 
 	void reset();
 
+	static void callout(void *arg) { static_cast<MicroBenchHRT *>(arg)->_callout_count.fetch_add(1); }
+
 	void lock()
 	{
 #ifdef __PX4_NUTTX
@@ -113,11 +117,14 @@ private:
 
 	uint64_t u_64;
 	uint64_t u_64_out;
+
+	px4::atomic<unsigned> _callout_count{0};
 };
 
 bool MicroBenchHRT::run_tests()
 {
 	ut_run_test(time_px4_hrt);
+	ut_run_test(time_px4_hrt_callout);
 
 	return (_tests_failed == 0);
 }
@@ -148,4 +155,44 @@ bool MicroBenchHRT::time_px4_hrt()
 	return true;
 }
 
+bool MicroBenchHRT::time_px4_hrt_callout()
+{
+	static constexpr int NUM_TIMERS = 1000;
+
+	hrt_call *calls = new hrt_call[NUM_TIMERS];
+	ut_assert_true(calls != nullptr);
+
+	for (int i = 0; i < NUM_TIMERS; i++) {
+		hrt_call_init(&calls[i]);
+	}
+
+	_callout_count.store(0);
+
+	// periodic timers with intervals between 1 ms and 100 ms
+#define TIMER_INTERVAL(i) (1000 + ((i) % 100) * 1000)
+
+	PERF("hrt_call_every() enter (1000 timers)",
+	     hrt_call_every(&calls[i], TIMER_INTERVAL(i), TIMER_INTERVAL(i), &MicroBenchHRT::callout, this), NUM_TIMERS);
+
+	PERF("hrt_call_every() reschedule (1000 timers)",
+	     hrt_call_every(&calls[i], TIMER_INTERVAL(i), TIMER_INTERVAL(i), &MicroBenchHRT::callout, this), NUM_TIMERS);
+
+	PERF("hrt_call_after() reschedule (1000 timers)",
+	     hrt_call_after(&calls[i], TIMER_INTERVAL(i), &MicroBenchHRT::callout, this), NUM_TIMERS);
+
+	PERF("hrt_cancel() (1000 timers)", hrt_cancel(&calls[i]), NUM_TIMERS);
+
+#undef TIMER_INTERVAL
+
+	const unsigned callout_count = _callout_count.load();
+
+	// let a callout that might still be running finish before freeing the entries
+	px4_usleep(10000);
+	delete[] calls;
+
+	ut_assert_true(callout_count > 0);
+
+	return true;
+}
+
 } // namespace MicroBenchHRT
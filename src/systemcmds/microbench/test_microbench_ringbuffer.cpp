@@ -0,0 +1,156 @@
+/****************************************************************************
+ *
+ *  Copyright (C) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file test_microbench_ringbuffer.cpp
+ * Microbenchmark the EKF ring buffer.
+ */
+
+#include <unit_test.h>
+
+#include <unistd.h>
+
+#include <drivers/drv_hrt.h>
+#include <perf/perf_counter.h>
+#include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/micro_hal.h>
+
+#include <modules/ekf2/EKF/RingBuffer.h>
+
+namespace MicroBenchRingBuffer
+{
+
+#ifdef __PX4_NUTTX
+#include <nuttx/irq.h>
+static irqstate_t flags;
+#endif
+
+void lock()
+{
+#ifdef __PX4_NUTTX
+	flags = px4_enter_critical_section();
+#endif
+}
+
+void unlock()
+{
+#ifdef __PX4_NUTTX
+	px4_leave_critical_section(flags);
+#endif
+}
+
+#define PERF(name, op, count) do { \
+		px4_usleep(1000); \
+		reset(); \
+		perf_counter_t p = perf_alloc(PC_ELAPSED, name); \
+		for (int i = 0; i < count; i++) { \
+			px4_usleep(1); \
+			lock(); \
+			perf_begin(p); \
+			op; \
+			perf_end(p); \
+			unlock(); \
+			reset(); \
+		} \
+		perf_print_counter(p); \
+		perf_free(p); \
+	} while (0)
+
+struct sample {
+	uint64_t time_us;
+	float data[3];
+};
+
+class MicroBenchRingBuffer : public UnitTest
+{
+public:
+	virtual bool run_tests();
+
+private:
+
+	bool time_pop_first_older_than();
+
+	void reset();
+
+	static constexpr uint16_t BUFFER_LENGTH = 100;
+	static constexpr uint64_t SAMPLE_INTERVAL_US = 1000;
+
+	RingBuffer<sample> _ordered{BUFFER_LENGTH};
+	RingBuffer<sample> _unordered{BUFFER_LENGTH};
+
+	sample _sample{};
+	bool _found{false};
+};
+
+bool MicroBenchRingBuffer::run_tests()
+{
+	ut_run_test(time_pop_first_older_than);
+
+	return (_tests_failed == 0);
+}
+
+void MicroBenchRingBuffer::reset()
+{
+	for (uint16_t i = 0; i < BUFFER_LENGTH; i++) {
+		sample s{};
+		s.time_us = (i + 1) * SAMPLE_INTERVAL_US;
+		_ordered.push(s);
+
+		// the same samples with the newest two swapped, which forces the linear search
+		if (i >= BUFFER_LENGTH - 2) {
+			s.time_us = (2 * BUFFER_LENGTH - 1 - i) * SAMPLE_INTERVAL_US;
+		}
+
+		_unordered.push(s);
+	}
+}
+
+ut_declare_test_c(test_microbench_ringbuffer, MicroBenchRingBuffer)
+
+bool MicroBenchRingBuffer::time_pop_first_older_than()
+{
+	// query the middle of the buffered time range, as the delayed fusion time horizon does
+	const uint64_t query = (BUFFER_LENGTH / 2) * SAMPLE_INTERVAL_US + SAMPLE_INTERVAL_US / 2;
+
+	PERF("RingBuffer::pop_first_older_than() (100 samples, ordered)",
+	     _found = _ordered.pop_first_older_than(query, &_sample), 1000);
+	ut_assert_true(_found);
+
+	PERF("RingBuffer::pop_first_older_than() (100 samples, out of order)",
+	     _found = _unordered.pop_first_older_than(query, &_sample), 1000);
+	ut_assert_true(_found);
+
+	return true;
+}
+
+} // namespace MicroBenchRingBuffer
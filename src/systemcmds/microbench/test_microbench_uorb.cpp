@@ -44,10 +44,14 @@
 
 #include <drivers/drv_hrt.h>
 #include <perf/perf_counter.h>
+#include <px4_platform_common/atomic.h>
 #include <px4_platform_common/px4_config.h>
 #include <px4_platform_common/micro_hal.h>
+#include <px4_platform_common/posix.h>
 
+#include <uORB/Publication.hpp>
 #include <uORB/Subscription.hpp>
+#include <uORB/topics/orb_test_medium.h>
 #include <uORB/topics/sensor_accel.h>
 #include <uORB/topics/sensor_gyro.h>
 #include <uORB/topics/sensor_gyro_fifo.h>
@@ -102,6 +106,9 @@ private:
 
 	bool time_px4_uorb();
 	bool time_px4_uorb_direct();
+#if defined(__PX4_POSIX)
+	bool time_px4_uorb_contention();
+#endif // __PX4_POSIX
 
 	void reset();
 
@@ -115,6 +122,9 @@ bool MicroBenchORB::run_tests()
 {
 	ut_run_test(time_px4_uorb);
 	ut_run_test(time_px4_uorb_direct);
+#if defined(__PX4_POSIX)
+	ut_run_test(time_px4_uorb_contention);
+#endif // __PX4_POSIX
 
 	return (_tests_failed == 0);
 }
@@ -246,4 +256,107 @@ bool MicroBenchORB::time_px4_uorb_direct()
 	return true;
 }
 
+#if defined(__PX4_POSIX)
+
+static constexpr int CONTENTION_ITERATIONS = 10000;
+static constexpr int CONTENTION_MAX_THREADS = 8;
+
+struct ContentionThread {
+	pthread_t thread;
+	perf_counter_t perf;
+	px4::atomic<bool> *should_exit;
+	bool publisher;
+	char name[48];
+};
+
+static void *contention_thread_main(void *arg)
+{
+	ContentionThread *ctx = static_cast<ContentionThread *>(arg);
+
+	if (ctx->publisher) {
+		uORB::Publication<orb_test_medium_s> pub{ORB_ID(orb_test_medium_queue)};
+		orb_test_medium_s data{};
+
+		for (int i = 0; i < CONTENTION_ITERATIONS && !ctx->should_exit->load(); i++) {
+			data.timestamp = hrt_absolute_time();
+			data.val = i;
+
+			perf_begin(ctx->perf);
+			pub.publish(data);
+			perf_end(ctx->perf);
+		}
+
+	} else {
+		uORB::Subscription sub{ORB_ID(orb_test_medium_queue)};
+		orb_test_medium_s data{};
+
+		for (int i = 0; i < CONTENTION_ITERATIONS && !ctx->should_exit->load(); i++) {
+			perf_begin(ctx->perf);
+			sub.copy(&data);
+			perf_end(ctx->perf);
+		}
+	}
+
+	return nullptr;
+}
+
+bool MicroBenchORB::time_px4_uorb_contention()
+{
+	// make sure the topic exists before the subscribers start
+	uORB::Publication<orb_test_medium_s> pub{ORB_ID(orb_test_medium_queue)};
+	orb_test_medium_s data{};
+	pub.publish(data);
+
+	for (int num_threads = 1; num_threads <= CONTENTION_MAX_THREADS; num_threads *= 2) {
+		px4::atomic<bool> should_exit{false};
+		ContentionThread threads[CONTENTION_MAX_THREADS + 1] {};
+
+		// one publisher thread, num_threads subscriber threads
+		for (int i = 0; i <= num_threads; i++) {
+			ContentionThread &t = threads[i];
+			t.publisher = (i == 0);
+			t.should_exit = &should_exit;
+
+			if (t.publisher) {
+				snprintf(t.name, sizeof(t.name), "publish orb_test_medium_queue (%d readers)", num_threads);
+
+			} else {
+				snprintf(t.name, sizeof(t.name), "copy orb_test_medium_queue %d/%d", i, num_threads);
+			}
+
+			t.perf = perf_alloc(PC_ELAPSED, t.name);
+		}
+
+		int started = 0;
+
+		for (int i = 0; i <= num_threads; i++) {
+			if (pthread_create(&threads[i].thread, nullptr, contention_thread_main, &threads[i]) != 0) {
+				PX4_ERR("pthread_create failed");
+				should_exit.store(true);
+				break;
+			}
+
+			started++;
+		}
+
+		for (int i = 0; i < started; i++) {
+			pthread_join(threads[i].thread, nullptr);
+		}
+
+		for (int i = 0; i <= num_threads; i++) {
+			if (i < started) {
+				perf_print_counter(threads[i].perf);
+			}
+
+			perf_free(threads[i].perf);
+		}
+
+		printf("\n");
+	}
+
+	return true;
+}
+
+#endif // __PX4_POSIX
+
 } // namespace MicroBenchORB
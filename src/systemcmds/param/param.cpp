@@ -115,6 +115,10 @@ Parameters are automatically saved when changed, eg. with `param set`. They are
 or to the SD card. `param select` can be used to change the storage location for subsequent saves (this will
 need to be (re-)configured on every boot).
 
+With `param select-journal` subsequent saves only append the changed parameters to a journal file, and
+the default and backup files are rewritten once the journal gets too large. It has to be selected after the
+parameters were loaded from the default (or backup) file, which applies the journal.
+
 If the FLASH-based backend is enabled (which is done at compile time, e.g. for the Intel Aero or Omnibus),
 `param select` has no effect and the default is always the FLASH backend. However `param save/load <file>`
 can still be used to write to/read from files.
@@ -145,6 +149,9 @@ $ reboot
 	PRINT_MODULE_USAGE_COMMAND_DESCR("select-backup", "Select default file");
 	PRINT_MODULE_USAGE_ARG("<file>", "File name", true);
 
+	PRINT_MODULE_USAGE_COMMAND_DESCR("select-journal", "Select journal file and apply its changes");
+	PRINT_MODULE_USAGE_ARG("<file>", "File name (disables the journal if not given)", true);
+
 	PRINT_MODULE_USAGE_COMMAND_DESCR("show", "Show parameter values");
 	PRINT_MODULE_USAGE_PARAM_FLAG('a', "Show all parameters (not just used)", true);
 	PRINT_MODULE_USAGE_PARAM_FLAG('c', "Show only changed params (unused too)", true);
@@ -273,6 +280,24 @@ param_main(int argc, char *argv[])
 			return 0;
 		}
 
+		if (!strcmp(argv[1], "select-journal")) {
+			if (argc >= 3) {
+				param_set_journal_file(argv[2]);
+
+			} else {
+				param_set_journal_file(nullptr);
+			}
+
+			const char *journal_file = param_get_journal_file();
+
+			if (journal_file) {
+				PX4_INFO("selected parameter journal file %s", journal_file);
+				return param_load_journal() == 0 ? 0 : 1;
+			}
+
+			return 0;
+		}
+
 		if (!strcmp(argv[1], "show")) {
 			if (argc >= 3) {
 				// optional argument -c to show only non-default params
@@ -46,6 +46,7 @@
 #include <unistd.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <string.h>
 
 #include <drivers/drv_board_led.h>
 #include <drivers/drv_hrt.h>
@@ -63,6 +64,15 @@ int test_dataman(int argc, char *argv[]);
 
 #define DM_MAX_DATA_SIZE sizeof(struct mission_s)
 
+#define RANGE_TEST_ITEMS 8
+#define RANGE_TEST_LENGTH 16
+
+#ifdef __PX4_NUTTX
+#define _px4_system(command) system(command)
+#else
+#define _px4_system(command) system("px4-"command)
+#endif
+
 static int
 task_main(int argc, char *argv[])
 {
@@ -155,6 +165,144 @@ fail:
 	return -1;
 }
 
+static int
+write_range(unsigned index, unsigned count)
+{
+	uint8_t buffer[RANGE_TEST_LENGTH];
+
+	for (unsigned i = 0; i < count; i++) {
+		memset(buffer, index + i, sizeof(buffer));
+
+		if (dm_write(DM_KEY_WAYPOINTS_OFFBOARD_1, index + i, buffer, sizeof(buffer)) != sizeof(buffer)) {
+			PX4_ERR("range: write of index %u failed", index + i);
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+static int
+check_range(unsigned index, unsigned count, ssize_t expected)
+{
+	uint8_t buffer[RANGE_TEST_ITEMS][RANGE_TEST_LENGTH];
+	memset(buffer, 0xff, sizeof(buffer));
+
+	ssize_t ret = dm_read_range(DM_KEY_WAYPOINTS_OFFBOARD_1, index, buffer, RANGE_TEST_LENGTH, count);
+
+	if (ret != expected) {
+		PX4_ERR("range: read of %u items from index %u returned %zd, expected %zd", count, index, ret, expected);
+		return -1;
+	}
+
+	for (ssize_t i = 0; i < ret; i++) {
+		for (unsigned k = 0; k < RANGE_TEST_LENGTH; k++) {
+			if (buffer[i][k] != (uint8_t)(index + i)) {
+				PX4_ERR("range: data verification failed, index %zd, wanted %02x, got %02x", (ssize_t)(index + i),
+					(uint8_t)(index + i), buffer[i][k]);
+				return -1;
+			}
+		}
+	}
+
+	return 0;
+}
+
+/* test dm_read_range() with the running backend */
+static int
+test_read_range(void)
+{
+	const unsigned first = 10;
+	const unsigned last = DM_KEY_WAYPOINTS_OFFBOARD_1_MAX - 3;
+
+	if (write_range(first, RANGE_TEST_ITEMS) || write_range(last, 3)) {
+		return -1;
+	}
+
+	/* a full range */
+	if (check_range(first, RANGE_TEST_ITEMS, RANGE_TEST_ITEMS)) {
+		return -1;
+	}
+
+	/* a range crossing the end of the item table stops at the last item */
+	if (check_range(last, RANGE_TEST_ITEMS, 3)) {
+		return -1;
+	}
+
+	/* a range starting after the end of the item table fails */
+	if (check_range(DM_KEY_WAYPOINTS_OFFBOARD_1_MAX, RANGE_TEST_ITEMS, -1)) {
+		return -1;
+	}
+
+	/* a range stops at the first item with a different length */
+	uint8_t buffer[RANGE_TEST_LENGTH / 2];
+	memset(buffer, first + 3, sizeof(buffer));
+
+	if (dm_write(DM_KEY_WAYPOINTS_OFFBOARD_1, first + 3, buffer, sizeof(buffer)) != sizeof(buffer)) {
+		return -1;
+	}
+
+	if (check_range(first, RANGE_TEST_ITEMS, 3)) {
+		return -1;
+	}
+
+	PX4_INFO("range read pass");
+	return 0;
+}
+
+#if defined(__PX4_LINUX)
+/* restart dataman with other options, stopping is asynchronous so retry the start for a while */
+static int
+restart_dataman(const char *start_command)
+{
+	if (_px4_system("dataman stop")) {
+		return -1;
+	}
+
+	for (int i = 0; i < 50; i++) {
+		px4_usleep(100000);
+
+		if (system(start_command) == 0) {
+			return 0;
+		}
+	}
+
+	PX4_ERR("%s failed", start_command);
+	return -1;
+}
+
+/* test dm_read_range() with the RAM and memory-mapped backends, which are read without the worker thread */
+static int
+test_read_range_memory_backends(void)
+{
+	const char *mmap_file = PX4_STORAGEDIR "/dataman_range_test";
+	char mmap_start[128];
+	snprintf(mmap_start, sizeof(mmap_start), "px4-dataman start -m %s", mmap_file);
+
+	int ret = restart_dataman("px4-dataman start -r");
+
+	if (ret == 0) {
+		ret = test_read_range();
+	}
+
+	if (ret == 0) {
+		ret = restart_dataman(mmap_start);
+	}
+
+	if (ret == 0) {
+		ret = test_read_range();
+	}
+
+	/* back to the default file backend */
+	if (restart_dataman("px4-dataman start")) {
+		ret = -1;
+	}
+
+	unlink(mmap_file);
+	return ret;
+}
+#endif /* __PX4_LINUX */
+
 int test_dataman(int argc, char *argv[])
 {
 	int i = 0;
@@ -215,5 +363,17 @@ int test_dataman(int argc, char *argv[])
 		}
 	}
 
+	if (test_read_range()) {
+		return -1;
+	}
+
+#if defined(__PX4_LINUX)
+
+	if (test_read_range_memory_backends()) {
+		return -1;
+	}
+
+#endif
+
 	return 0;
 }
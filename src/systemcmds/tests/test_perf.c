@@ -65,6 +65,22 @@ test_perf(int argc, char *argv[])
 	printf("perf: expect count of 1\n");
 	perf_print_counter(ec);
 
+	if (perf_event_count(cc) != 4 || perf_event_count(ec) != 1) {
+		printf("perf: unexpected event count\n");
+		return 1;
+	}
+
+	/* lookup by name */
+	if (perf_alloc_once(PC_COUNT, "test_count") != cc) {
+		printf("perf: perf_alloc_once did not find existing counter\n");
+		return 1;
+	}
+
+	if (perf_alloc_once(PC_ELAPSED, "test_count") != NULL) {
+		printf("perf: perf_alloc_once returned counter of different type\n");
+		return 1;
+	}
+
 	perf_free(cc);
 	perf_free(ec);
 
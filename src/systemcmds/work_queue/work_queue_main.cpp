@@ -36,15 +36,80 @@
 #include <px4_platform_common/getopt.h>
 #include <px4_platform_common/px4_work_queue/WorkQueueManager.hpp>
 
+#include <stdlib.h>
+#include <string.h>
+
 static void	usage();
 
 extern "C" {
 	__EXPORT int work_queue_main(int argc, char *argv[]);
 }
 
+// parse a CPU list (eg "1" or "0,2-3") into a bitmask
+static bool
+parse_cpu_list(const char *list, uint32_t &cpu_affinity)
+{
+	cpu_affinity = 0;
+
+	if (strcmp(list, "all") == 0) {
+		return true;
+	}
+
+	const char *p = list;
+
+	while (*p != '\0') {
+		char *end = nullptr;
+		const long first = strtol(p, &end, 10);
+		long last = first;
+
+		if (end == p) {
+			return false;
+		}
+
+		if (*end == '-') {
+			p = end + 1;
+			last = strtol(p, &end, 10);
+
+			if (end == p) {
+				return false;
+			}
+		}
+
+		if ((first < 0) || (last > 31) || (first > last)) {
+			return false;
+		}
+
+		for (long cpu = first; cpu <= last; cpu++) {
+			cpu_affinity |= (1u << cpu);
+		}
+
+		if (*end == ',') {
+			end++;
+
+		} else if (*end != '\0') {
+			return false;
+		}
+
+		p = end;
+	}
+
+	return cpu_affinity != 0;
+}
+
 int
 work_queue_main(int argc, char *argv[])
 {
+	if ((argc == 4) && !strcmp(argv[1], "affinity")) {
+		uint32_t cpu_affinity = 0;
+
+		if (!parse_cpu_list(argv[3], cpu_affinity)) {
+			PX4_ERR("invalid CPU list: %s", argv[3]);
+			return 1;
+		}
+
+		return (px4::WorkQueueSetCpuAffinity(argv[2], cpu_affinity) == PX4_OK) ? 0 : 1;
+	}
+
 	if (argc != 2) {
 		usage();
 		return 1;
@@ -78,9 +143,19 @@ usage()
 
 Command-line tool to show work queue status.
 
+On Linux the work queue threads can be restricted to a set of CPU cores, e.g. to isolate the rate controller:
+$ work_queue affinity wq:rate_ctrl 3
+$ work_queue affinity wq:INS0 2
+
+The setting is applied immediately if the work queue is running, and otherwise when it is created.
+The status shows the core each work queue last ran on and its number of migrations.
+
 )DESCR_STR");
 
 	PRINT_MODULE_USAGE_NAME("work_queue", "system");
 	PRINT_MODULE_USAGE_COMMAND("start");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("affinity", "Set the CPU affinity of a work queue (Linux only)");
+	PRINT_MODULE_USAGE_ARG("<name>", "Work queue name (eg wq:rate_ctrl)", false);
+	PRINT_MODULE_USAGE_ARG("<cpus>", "CPU list (eg 1 or 0,2-3) or 'all'", false);
 	PRINT_MODULE_USAGE_DEFAULT_COMMANDS();
 }